@@ -364,7 +364,7 @@ void Analyze::get_clause(const std::vector<std::shared_ptr<ast::BinaryExpr>> &sv
                     assert(query->cols.size() == 1);
                     auto tab_col = query->cols[0];
                     auto col_meta = sm_manager_->db_.get_table(tab_col.tab_name).get_col(tab_col.col_name);
-                    if(col_meta->type != l_col_meta.type){
+                    if(!coltype_compatible(col_meta->type, l_col_meta.type)){
                         throw IncompatibleTypeError(std::to_string(l_col_meta.type),std::to_string(col_meta->type));
                     }
                 }
@@ -473,7 +473,7 @@ void Analyze::get_clause(const std::vector<std::shared_ptr<ast::BinaryExpr>> &sv
                     assert(query->cols.size() == 1);
                     auto tab_col = query->cols[0];
                     auto col_meta = sm_manager_->db_.get_table(tab_col.tab_name).get_col(tab_col.col_name);
-                    if(col_meta->type != l_col_meta.type){
+                    if(!coltype_compatible(col_meta->type, l_col_meta.type)){
                         throw IncompatibleTypeError(std::to_string(l_col_meta.type),std::to_string(col_meta->type));
                     }
                 }
@@ -602,7 +602,7 @@ void Analyze::check_clause(const std::vector<std::string> &tab_names, std::vecto
                 auto rhs_col = rhs_tab.get_col(cond.rhs_col.col_name);
                 rhs_type = rhs_col->type;
             }
-            if (lhs_type != rhs_type) {
+            if (!coltype_compatible(lhs_type, rhs_type)) {
             
                 throw IncompatibleTypeError(coltype2str(lhs_type), coltype2str(rhs_type));
             }
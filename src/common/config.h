@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <string>
 
 #define BUFFER_LENGTH 8192
 
@@ -34,7 +35,16 @@ static constexpr int HEADER_PAGE_ID = 0;                                      //
 static constexpr int PAGE_SIZE = 4096;                                        // size of a data page in byte  4KB
 static constexpr int BUFFER_POOL_SIZE = 65536;                                // size of buffer pool 256MB
 // static constexpr int BUFFER_POOL_SIZE = 262144;                                // size of buffer pool 1GB
+static constexpr size_t BUFFER_POOL_PARTITIONS = 16;                         // buffer pool分区个数，按PageId哈希到分区
+static constexpr size_t BUFFER_POOL_PARTITION_MIN_FRAMES = 4096;              // 每个分区至少包含的帧数，缓冲池较小时减少分区个数
+static constexpr bool BUFFER_POOL_HUGE_PAGES = true;                          // 帧内存优先使用MAP_HUGETLB，失败时使用普通mmap并madvise透明大页
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;                     // 大页大小 2MB
+static constexpr size_t BUFFER_ACCESS_RING_SIZE = 64;                        // 顺序扫描私有环的帧数 256KB
+static constexpr size_t PREFETCH_THREAD_NUM = 4;                             // 缓冲池预读线程个数，为0时关闭预读
+static constexpr size_t PREFETCH_QUEUE_SIZE = 256;                            // 预读队列长度，队列满时丢弃新的预读请求
+static constexpr int RM_SCAN_PREFETCH_PAGES = 8;                              // RmScan预读的页面个数
 static constexpr int LOG_BUFFER_SIZE = (1024 * PAGE_SIZE);                    // size of a log buffer in byte
+static constexpr int LOG_BUFFER_NUM = 2;                                       // number of log buffers, appenders fill one while another is flushed
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
 
 using frame_id_t = int32_t;  // frame id type, 帧页ID, 页在BufferPool中的存储单元称为帧,一帧对应一页
@@ -48,9 +58,36 @@ using timestamp_t = int32_t;  // timestamp type, used for transaction concurrenc
 // log file
 static const std::string LOG_FILE_NAME = "db.log";
 static const std::string START_FILE_NAME = "start_file.txt";
+static constexpr int LOG_SEGMENT_SIZE = 16 * 1024 * 1024;                     // 日志段大小，日志段文件名为db.log.<段号>
+static constexpr int UPDATE_DELTA_MERGE_GAP = 8;                                // update日志中间隔小于该字节数的变化区间合并记录
 
-// replacer
+// group commit: 提交线程等待log writer线程批量刷日志
+static constexpr std::chrono::microseconds GROUP_COMMIT_MAX_WAIT{1000};      // 第一个提交到达后最多再等待的时间
+static constexpr size_t GROUP_COMMIT_MAX_BATCH = 32;                          // 攒够该数量的提交立即刷盘
+// async commit: SET enable_async_commit = true之后提交不等待日志刷盘，log writer保证提交日志在该时间内落盘
+static constexpr std::chrono::microseconds ASYNC_COMMIT_MAX_DELAY{10000};
+
+// page writer (write-back模式: 淘汰脏页时交给后台线程批量写回，每批次每个文件一次fdatasync)
+static constexpr bool ENABLE_PAGE_WRITER = true;
+static constexpr size_t PAGE_WRITER_THREAD_NUM = 2;                           // 后台刷脏线程个数，按fd分片
+static constexpr size_t PAGE_WRITER_BATCH_SIZE = 64;                          // 一个批次写回的页面个数
+static constexpr size_t PAGE_WRITER_MAX_PENDING = 4096;                       // 每个分片最多缓存的脏页个数
+static constexpr std::chrono::milliseconds PAGE_WRITER_INTERVAL{10};         // 队列不满一个批次时的最长等待时间
+
+// checkpoint: 模糊检查点不中止事务，只在日志中记录脏页表和活跃事务表，之后增量写回脏页；关闭时使用静态检查点
+static constexpr bool ENABLE_FUZZY_CHECKPOINT = true;
+static constexpr size_t CHECKPOINT_FLUSH_BATCH = 64;                          // 增量刷脏时每个分区每批次写回的页面个数
+static constexpr size_t RECOVERY_REDO_THREAD_NUM = 4;                         // 并行redo的线程个数，日志按页面分配给各线程
+
+// direct io: 表文件和索引文件以O_DIRECT打开，绕过内核page cache，避免与缓冲池重复缓存。启动时可以通过环境变量RMDB_DIRECT_IO覆盖
+static constexpr bool ENABLE_DIRECT_IO = false;
+static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;                           // O_DIRECT要求的内存地址、文件偏移和长度的对齐大小
+
+// replacer: LRU / CLOCK / LRU-K / 2Q，启动时可以通过环境变量RMDB_REPLACER覆盖
 static const std::string REPLACER_TYPE = "LRU";
+static constexpr size_t LRUK_REPLACER_K = 2;                                  // LRU-K中的K
+static constexpr uint64_t REPLACER_CORRELATED_PERIOD = 32;                    // 间隔小于该值(逻辑时钟)的连续访问视为同一次访问
+static constexpr size_t TWOQ_KIN_PERCENT = 25;                                // 2Q中A1队列占容量的百分比
 
 static const std::string DB_META_NAME = "db.meta";
 
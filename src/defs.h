@@ -40,18 +40,32 @@ struct Rid {
 };
 
 enum ColType {
-    TYPE_INT, TYPE_FLOAT, TYPE_STRING
+    TYPE_INT, TYPE_FLOAT, TYPE_STRING, TYPE_VARCHAR
 };
 
 inline std::string coltype2str(ColType type) {
     std::map<ColType, std::string> m = {
             {TYPE_INT,    "INT"},
             {TYPE_FLOAT,  "FLOAT"},
-            {TYPE_STRING, "STRING"}
+            {TYPE_STRING, "STRING"},
+            {TYPE_VARCHAR, "VARCHAR"}
     };
     return m.at(type);
 }
 
+// CHAR(n)和VARCHAR(n)在内存中的记录格式相同(定长、末尾补0)，只是在页面中的存储格式不同
+inline bool is_string_type(ColType type) { return type == TYPE_STRING || type == TYPE_VARCHAR; }
+
+// 判断两个类型的值能否直接比较/赋值，字符串字面量的类型为TYPE_STRING，可以与VARCHAR列比较
+inline bool coltype_compatible(ColType lhs, ColType rhs) {
+    return lhs == rhs || (is_string_type(lhs) && is_string_type(rhs));
+}
+
+// 索引所支撑的表级约束，由CREATE TABLE中的PRIMARY KEY/UNIQUE声明产生
+enum KeyType {
+    KEY_NONE, KEY_PRIMARY, KEY_UNIQUE
+};
+
 class RecScan {
 public:
     virtual ~RecScan() = default;
@@ -132,6 +132,11 @@ class IndexExistsError : public RMDBError {
     }
 };
 
+class PrimaryKeyExistsError : public RMDBError {
+   public:
+    PrimaryKeyExistsError(const std::string &tab_name) : RMDBError("Multiple primary keys defined: " + tab_name) {}
+};
+
 // QL errors
 class InvalidValueCountError : public RMDBError {
    public:
@@ -149,6 +154,18 @@ class IncompatibleTypeError : public RMDBError {
         : RMDBError("Incompatible type error: lhs " + lhs + ", rhs " + rhs) {}
 };
 
+class DuplicateKeyError : public RMDBError {
+   public:
+    DuplicateKeyError(const std::string &tab_name, const std::vector<std::string> &col_names) {
+        _msg += "Duplicate key: " + tab_name + ".(";
+        for(size_t i = 0; i < col_names.size(); ++i) {
+            if(i > 0) _msg += ", ";
+            _msg += col_names[i];
+        }
+        _msg += ")";
+    }
+};
+
 class AmbiguousColumnError : public RMDBError {
    public:
     AmbiguousColumnError(const std::string &col_name) : RMDBError("Ambiguous column: " + col_name) {}
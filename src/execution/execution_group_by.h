@@ -240,7 +240,7 @@ private:
                     value.set_int(*(int *)rec_buf);
                 }else if(col_meta->type == TYPE_FLOAT){
                     value.set_float(*(float *)rec_buf);
-                }else if (col_meta->type == TYPE_STRING){
+                }else if (is_string_type(col_meta->type)){
                     //error
                 }
                 //float value = *reinterpret_cast<float *>(record.data + col_meta->offset);
@@ -368,7 +368,7 @@ private:
                     value.set_int(*(int *)rec_buf);
                 }else if(col_meta->type == TYPE_FLOAT){
                     value.set_float(*(float *)rec_buf);
-                }else if (col_meta->type == TYPE_STRING){
+                }else if (is_string_type(col_meta->type)){
                     //error
                 }
                 //float value = *reinterpret_cast<float *>(record.data + col_meta->offset);
@@ -429,6 +429,7 @@ private:
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, rhs_val.float_val);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data, lhs_len), op, rhs_val.str_val);
             default:
                 return false;
@@ -446,6 +447,7 @@ private:
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, *(float *)rhs_data);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data), op, std::string(rhs_data));
             default:
                 return false;
@@ -48,7 +48,7 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
         switch(x->tag) {
             case T_CreateTable:
             {
-                sm_manager_->create_table(x->tab_name_, x->cols_, context);
+                sm_manager_->create_table(x->tab_name_, x->cols_, x->keys_, context);
                 break;
             }
             case T_DropTable:
@@ -79,10 +79,10 @@ void QlManager::run_mutli_query(std::shared_ptr<Plan> plan, Context *context){
     （1）停止接收新事务和正在运行事务
     （2）将仍保留在日志缓冲区中的内容写到日志文件中;
     （3）在日志文件中写入一个“检查点记录”;
-    （4）将当前数据库缓冲区中的内容写到数据库中;
+    （4）将当前数据库缓冲区中的内容和索引文件头写到数据库中;
     （5）把日志文件中检查点记录的地址写到“重新启动文件”中
  */
-void create_static_checkpoint(TransactionManager* txn_mgr_,Context* context){
+void create_static_checkpoint(TransactionManager* txn_mgr_,SmManager* sm_manager,Context* context){
     //设置标志位，停止接受新事务
     txn_mgr_->set_is_checkpointing(true);
     //停止正在运行的事务
@@ -102,11 +102,16 @@ void create_static_checkpoint(TransactionManager* txn_mgr_,Context* context){
 
     //将当前数据库缓冲区中的内容写到数据库中
     context->log_mgr_->get_bp()->flush_all_pages();
+    sm_manager->flush_index_headers();
     
     //把日志文件中检查点记录的地址写到“重新启动文件”中
     char data[sizeof(lsn_t)];
     memcpy(data, &c_lsn, sizeof(c_lsn));
     context->log_mgr_->get_dm()->write_start_file(data,sizeof(lsn_t));
+    context->log_mgr_->write_log_header(c_lsn);
+
+    //检查点之前的日志在恢复时不再需要，回收对应的日志段
+    context->log_mgr_->get_dm()->recycle_log(c_lsn);
 
     //手动提交，不记录日志
     //context->txn_->set_txn_mode(true);
@@ -116,6 +121,58 @@ void create_static_checkpoint(TransactionManager* txn_mgr_,Context* context){
     txn_mgr_->set_is_checkpointing(false);
 }
 
+/**
+ * @description:
+ *  创建模糊检查点，不停止任何事务，具体步骤如下：
+    （1）在日志的latch_内获取活跃事务表(ATT)和当前的全局lsn(begin_lsn)，之后获取缓冲池的脏页表(DPT)，并写回索引文件头。
+        之后才修改的索引，其修改对应的日志或脏页一定在恢复的扫描范围内，恢复时重做;
+    （2）把写回队列中已经淘汰的脏页写回磁盘，它们不在DPT中;
+    （3）在日志文件中写入带有ATT和DPT的“检查点记录”，并将日志缓冲区写到日志文件中;
+    （4）把日志文件中检查点记录的地址写到“重新启动文件”中，并更新日志文件头中的日志结束位置;
+    （5）回收恢复时不会再读取的日志段，即完全位于ATT和DPT中最早lsn之前的日志段;
+    （6）分批写回recLSN早于检查点的脏页，推进下一次恢复的起点
+ */
+void create_fuzzy_checkpoint(SmManager* sm_manager,Context* context){
+    LogManager* log_mgr = context->log_mgr_;
+    BufferPoolManager* bpm = log_mgr->get_bp();
+    DiskManager* disk_manager = log_mgr->get_dm();
+
+    std::vector<std::pair<txn_id_t, lsn_t>> active_txns;
+    lsn_t begin_lsn = log_mgr->snapshot_active_txns(active_txns);
+    auto dirty_page_table = bpm->get_dirty_page_table();
+    sm_manager->flush_index_headers();
+    disk_manager->flush_async_pages();
+
+    CheckPointRecord rec(begin_lsn);
+    lsn_t redo_lsn = begin_lsn;    // 恢复时开始扫描日志的位置，与RecoveryManager::read_checkpoint一致
+    for(auto &txn : active_txns){
+        rec.add_active_txn(txn.first, txn.second);
+        redo_lsn = std::min(redo_lsn, txn.second);
+    }
+    for(auto &entry : dirty_page_table){
+        std::string file_name;
+        try {
+            file_name = disk_manager->get_file_name(entry.first.fd);
+        } catch (RMDBError &) {
+            continue;   // 文件已经被关闭，其页面已经写回
+        }
+        rec.add_dirty_page(file_name, entry.first.page_no, entry.second);
+        if(entry.second != INVALID_LSN){
+            redo_lsn = std::min(redo_lsn, entry.second);
+        }
+    }
+    auto c_lsn = log_mgr->add_log_to_buffer(&rec);
+    log_mgr->flush_log_to_disk();
+
+    char data[sizeof(lsn_t)];
+    memcpy(data, &c_lsn, sizeof(c_lsn));
+    disk_manager->write_start_file(data,sizeof(lsn_t));
+    log_mgr->write_log_header(c_lsn);
+    disk_manager->recycle_log(redo_lsn);
+
+    bpm->flush_dirty_pages(c_lsn);
+}
+
 // 执行help; show tables; desc table; begin; commit; abort;语句
 void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Context *context) {
     if (auto x = std::dynamic_pointer_cast<OtherPlan>(plan)) {
@@ -131,6 +188,14 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
                 sm_manager_->show_tables(context);
                 break;
             }
+            case T_ShowRecoveryStats:
+            {
+                if (recovery_ == nullptr) {
+                    throw InternalError("recovery manager is not set");
+                }
+                recovery_->show_stats(context);
+                break;
+            }
             case T_ShowIndex:
             {
                 sm_manager_->show_indexs(x->tab_name_,context);
@@ -167,7 +232,11 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
             case T_Create_static_checkpoint:
             {
                 context->txn_ = txn_mgr_->get_transaction(*txn_id);
-                create_static_checkpoint(txn_mgr_,context);
+                if (ENABLE_FUZZY_CHECKPOINT) {
+                    create_fuzzy_checkpoint(sm_manager_,context);
+                } else {
+                    create_static_checkpoint(txn_mgr_,sm_manager_,context);
+                }
                 break;
             }
             default:
@@ -186,6 +255,10 @@ void QlManager::run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Co
             planner_->set_enable_sortmerge_join(x->bool_value_);
             break;
         }
+        case ast::SetKnobType::EnableAsyncCommit: {
+            txn_mgr_->set_async_commit(x->bool_value_);
+            break;
+        }
         default: {
             throw RMDBError("Not implemented!\n");
             break;
@@ -264,7 +337,7 @@ std::vector<std::vector<std::string>> QlManager::select_from(std::unique_ptr<Abs
                     col_str = std::to_string(*(int *)rec_buf);
                 } else if (col.type == TYPE_FLOAT) {
                     col_str = std::to_string(*(float *)rec_buf);
-                } else if (col.type == TYPE_STRING) {
+                } else if (is_string_type(col.type)) {
                     col_str = std::string((char *)rec_buf, col.len);
                     col_str.resize(strlen(col_str.c_str()));
                 }
@@ -280,7 +353,7 @@ std::vector<std::vector<std::string>> QlManager::select_from(std::unique_ptr<Abs
                     col_str = std::to_string(*(int *)rec_buf);
                 } else if (col.type == TYPE_FLOAT) {
                     col_str = std::to_string(*(float *)rec_buf);
-                } else if (col.type == TYPE_STRING) {
+                } else if (is_string_type(col.type)) {
                     col_str = std::string((char *)rec_buf, col.len);
                     col_str.resize(strlen(col_str.c_str()));
                 }
@@ -25,6 +25,7 @@ See the Mulan PSL v2 for more details. */
 #include "executor_abstract.h"
 #include "transaction/transaction_manager.h"
 #include "optimizer/planner.h"
+#include "recovery/log_recovery.h"
 
 class Planner;
 
@@ -33,11 +34,14 @@ class QlManager {
     SmManager *sm_manager_;
     TransactionManager *txn_mgr_;
     Planner *planner_;
+    RecoveryManager *recovery_ = nullptr;   // SHOW RECOVERY STATS读取启动恢复的统计信息
 
    public:
     QlManager(SmManager *sm_manager, TransactionManager *txn_mgr, Planner *planner) 
         : sm_manager_(sm_manager),  txn_mgr_(txn_mgr), planner_(planner) {}
 
+    void set_recovery_manager(RecoveryManager *recovery) { recovery_ = recovery; }
+
     void run_mutli_query(std::shared_ptr<Plan> plan, Context *context);
     void run_cmd_utility(std::shared_ptr<Plan> plan, txn_id_t *txn_id, Context *context);
     std::vector<std::vector<std::string>> select_from(std::unique_ptr<AbstractExecutor> executorTreeRoot, std::vector<TabCol> sel_cols, std::vector<AggregateExpr> sel_aggs,
@@ -100,7 +100,7 @@ public:
                         col_str = std::to_string(*(int *)rec_buf);
                     } else if (col.type == TYPE_FLOAT) {
                         col_str = std::to_string(*(float *)rec_buf);
-                    } else if (col.type == TYPE_STRING) {
+                    } else if (is_string_type(col.type)) {
                         col_str = std::string((char *)rec_buf, col.len);
                         col_str.resize(strlen(col_str.c_str()));
                     }
@@ -407,6 +407,7 @@ private:
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, rhs_val.float_val);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data, lhs_len), op, rhs_val.str_val);
             default:
                 return false;
@@ -424,6 +425,7 @@ private:
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, *(float *)rhs_data);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data), op, std::string(rhs_data));
             default:
                 return false;
@@ -52,8 +52,8 @@ class DeleteExecutor : public AbstractExecutor {
             WriteRecord *wr = new WriteRecord(WType::DELETE_TUPLE,tab_.name,rid,*rec,*rec);
             context_->txn_->append_write_record(wr);
             //加入log_buffer
-            DeleteLogRecord *del_log_record = new  DeleteLogRecord(context_->txn_->get_transaction_id(),*rec,rid,tab_name_);
-            context_->log_mgr_->add_log_to_buffer(del_log_record);
+            DeleteLogRecord *del_log_record = new  DeleteLogRecord(context_->txn_->get_transaction_id(),*rec,rid,tab_.id);
+            context_->txn_->set_prev_lsn(context_->log_mgr_->add_log_to_buffer(del_log_record));
 
             // 删除记录
             fh_->delete_record(rid, context_);
@@ -248,6 +248,7 @@ class IndexScanExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, rhs_val.float_val);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data, lhs_len), op, rhs_val.str_val);
             default:
                 return false;
@@ -265,6 +266,7 @@ class IndexScanExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, *(float *)rhs_data);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data), op, std::string(rhs_data));
             default:
                 return false;
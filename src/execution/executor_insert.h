@@ -24,7 +24,6 @@ class InsertExecutor : public AbstractExecutor {
     std::string tab_name_;          // 表名称
     Rid rid_;                       // 插入的位置，由于系统默认插入时不指定位置，因此当前rid_在插入后才赋值
     SmManager *sm_manager_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
 
    public:
     InsertExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<Value> values, Context *context) {
@@ -48,7 +47,7 @@ class InsertExecutor : public AbstractExecutor {
         for (size_t i = 0; i < values_.size(); i++) {
             auto &col = tab_.cols[i];
             auto &val = values_[i];
-            if (col.type != val.type) {
+            if (!coltype_compatible(col.type, val.type)) {
                 if(col.type == TYPE_FLOAT && val.type == TYPE_INT){
                     val.float_val = float(val.int_val);
                     val.type = TYPE_FLOAT;
@@ -60,43 +59,43 @@ class InsertExecutor : public AbstractExecutor {
             memcpy(rec.data + col.offset, val.raw->data, col.len);
         }
 
-        bool exist = false;
-        //check if record has been exist
-        scan_ = std::make_unique<RmScan>(fh_);
-        while (!scan_->is_end()) {
-            rid_ = scan_->rid();
-            auto record = fh_->get_record(rid_,nullptr);
-            if(memcmp(rec.data,record->data,record->size) == 0 && record->size == rec.size){
-                exist = true;
-                break;
+        // 唯一性检查：每个索引都是唯一索引(包括PRIMARY KEY/UNIQUE约束建立的索引)，
+        // 插入前对每个索引做一次点查，代价与表的大小无关
+        std::vector<std::unique_ptr<char[]>> keys;
+        for (auto &index : tab_.indexes) {
+            auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
+            std::unique_ptr<char[]> key(new char[index.col_tot_len]);
+            int offset = 0;
+            for (int i = 0; i < index.col_num; ++i) {
+                memcpy(key.get() + offset, rec.data + index.cols[i].offset, index.cols[i].len);
+                offset += index.cols[i].len;
+            }
+            std::vector<Rid> rids;
+            if (ih->get_value(key.get(), &rids, context_->txn_)) {
+                std::vector<std::string> col_names;
+                for (auto &col : index.cols) col_names.push_back(col.name);
+                throw DuplicateKeyError(tab_name_, col_names);
             }
-            scan_->next();
+            keys.push_back(std::move(key));
         }
 
-        // Insert into record file
-        if(!exist){
-            rid_ = fh_->insert_record(rec.data, context_);
-            //加入write_set
-            WriteRecord* wr = new WriteRecord(WType::INSERT_TUPLE,tab_.name,rid_,rec);
-            context_->txn_->append_write_record(wr);
-            
-            //加入log_buffer
-            InsertLogRecord *insert_log_record = new InsertLogRecord(context_->txn_->get_transaction_id(),rec,rid_,tab_.name);
-            context_->log_mgr_->add_log_to_buffer(insert_log_record);
-        }
-        
+        // Insert into record file，选定rid之后先加入log_buffer再修改页面
+        rid_ = fh_->insert_record(rec.data, context_, [&](const Rid &rid) {
+            Rid log_rid = rid;
+            InsertLogRecord insert_log_record(context_->txn_->get_transaction_id(), rec, log_rid, tab_.id);
+            lsn_t lsn = context_->log_mgr_->add_log_to_buffer(&insert_log_record);
+            context_->txn_->set_prev_lsn(lsn);
+            return lsn;
+        });
+        //加入write_set
+        WriteRecord* wr = new WriteRecord(WType::INSERT_TUPLE,tab_.name,rid_,rec);
+        context_->txn_->append_write_record(wr);
 
         // Insert into index
         for(size_t i = 0; i < tab_.indexes.size(); ++i) {
             auto& index = tab_.indexes[i];
             auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-            char* key = new char[index.col_tot_len];
-            int offset = 0;
-            for(int i = 0; i < index.col_num; ++i) {
-                memcpy(key + offset, rec.data + index.cols[i].offset, index.cols[i].len);
-                offset += index.cols[i].len;
-            }
-            ih->insert_entry(key, rid_, context_->txn_);
+            ih->insert_entry(keys[i].get(), rid_, context_->txn_);
         }
         return nullptr;
     }
@@ -154,6 +154,7 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, rhs_val.float_val);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data, rhs_val.str_val.size()), op, rhs_val.str_val);
             default:
                 return false;
@@ -171,6 +172,7 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, *(float *)rhs_data);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data), op, std::string(rhs_data));
             default:
                 return false;
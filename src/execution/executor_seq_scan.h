@@ -26,7 +26,7 @@ class SeqScanExecutor : public AbstractExecutor {
     std::vector<Condition> fed_conds_;  // 同conds_，两个字段相同
 
     Rid rid_;
-    std::unique_ptr<RecScan> scan_;     // table_iterator
+    std::unique_ptr<RmScan> scan_;      // table_iterator
 
     SmManager *sm_manager_;
 
@@ -49,12 +49,12 @@ class SeqScanExecutor : public AbstractExecutor {
 
     //找到第一条符合条件的记录
     void beginTuple() override {
+        scan_.reset();  // 先释放旧扫描pin住的页面
         scan_ = std::make_unique<RmScan>(fh_);
         while (!scan_->is_end()) {
             rid_ = scan_->rid();
-            auto record = fh_->get_record(rid_,nullptr);
-            // 检查记录是否符合条件
-            if (match_conditions(record.get(), fed_conds_)) {
+            // 直接在页面上检查记录是否符合条件，不拷贝记录
+            if (match_conditions(scan_->record().data, fed_conds_)) {
                 return;
             }
             scan_->next();
@@ -66,21 +66,22 @@ class SeqScanExecutor : public AbstractExecutor {
         scan_->next();
         while (!scan_->is_end()) {
             rid_ = scan_->rid();
-            auto record = fh_->get_record(rid_,nullptr);
-            // 检查记录是否符合条件
-            if (match_conditions(record.get(), fed_conds_)) {
+            // 直接在页面上检查记录是否符合条件，不拷贝记录
+            if (match_conditions(scan_->record().data, fed_conds_)) {
                 return;
             }
             scan_->next();
         }
     }
 
-    //获取当前记录
+    //获取当前记录，只有返回给上层算子的记录需要从页面中拷贝出来
     std::unique_ptr<RmRecord> Next() override {
         if (scan_->is_end()) {
             return nullptr;
         }
-        auto record = fh_->get_record(rid_,nullptr);
+        RmRecordView view = scan_->record();
+        auto record = std::make_unique<RmRecord>(view.size);
+        memcpy(record->data, view.data, view.size);
         return record;
     }
 
@@ -103,10 +104,10 @@ class SeqScanExecutor : public AbstractExecutor {
     };
 
     // 检查记录是否符合条件
-    bool match_conditions(const RmRecord *record, const std::vector<Condition> &conds) {
+    bool match_conditions(const char *data, const std::vector<Condition> &conds) {
         for (const auto &cond : conds) {
             auto lhs_col_meta = get_col(cols_, cond.lhs_col);
-            char *lhs_data = record->data + lhs_col_meta->offset;
+            const char *lhs_data = data + lhs_col_meta->offset;
             
             //特殊处理IN子句
             if(cond.op == CompOp::IN){
@@ -132,7 +133,7 @@ class SeqScanExecutor : public AbstractExecutor {
             } else {
                 // 右边是列
                 auto rhs_col_meta = get_col(cols_, cond.rhs_col);
-                char *rhs_data = record->data + rhs_col_meta->offset;
+                const char *rhs_data = data + rhs_col_meta->offset;
                 if (!eval_condition(lhs_data, lhs_col_meta->type, cond.op, rhs_data, rhs_col_meta->type)) {
                     return false;
                 }
@@ -148,6 +149,7 @@ class SeqScanExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, rhs_val.float_val);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data, lhs_len), op, rhs_val.str_val);
             default:
                 return false;
@@ -165,6 +167,7 @@ class SeqScanExecutor : public AbstractExecutor {
             case TYPE_FLOAT:
                 return eval_condition(*(float *)lhs_data, op, *(float *)rhs_data);
             case TYPE_STRING:
+            case TYPE_VARCHAR:
                 return eval_condition(std::string(lhs_data), op, std::string(rhs_data));
             default:
                 return false;
@@ -9,6 +9,8 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #pragma once
+#include <set>
+
 #include "execution_defs.h"
 #include "execution_manager.h"
 #include "executor_abstract.h"
@@ -25,7 +27,6 @@ class UpdateExecutor : public AbstractExecutor {
     std::string tab_name_;
     std::vector<SetClause> set_clauses_;
     SmManager *sm_manager_;
-    std::unique_ptr<RecScan> scan_;
 
    public:
     UpdateExecutor(SmManager *sm_manager, const std::string &tab_name, std::vector<SetClause> set_clauses,
@@ -45,23 +46,14 @@ class UpdateExecutor : public AbstractExecutor {
     std::unique_ptr<RmRecord> Next() override {
         //context_->lock_mgr_->lock_IX_on_table(context_->txn_,fh_->GetFd());
         context_->lock_mgr_->lock_exclusive_on_table(context_->txn_,fh_->GetFd());
-      
+
+        // 先计算出所有记录的新值，唯一性检查通过后再修改，避免语句执行到一半因为键冲突而失败
+        std::vector<RmRecord> old_recs;
+        std::vector<RmRecord> new_recs;
         for (auto &rid : rids_) {
             // 获取要更新的记录
             std::unique_ptr<RmRecord> rec = fh_->get_record(rid, context_);
-            auto old_rec = *(rec.get());
-
-            // 记录原始数据用于索引更新
-            std::vector<char*> old_keys;
-            for (const auto &index : tab_.indexes) {
-                char *old_key = new char[index.col_tot_len];
-                int offset = 0;
-                for (const auto &col : index.cols) {
-                    memcpy(old_key + offset, rec->data + col.offset, col.len);
-                    offset += col.len;
-                }
-                old_keys.push_back(old_key);
-            }
+            old_recs.push_back(*rec);
 
             // 更新记录内容
             for (auto &set_clause : set_clauses_) {
@@ -71,64 +63,111 @@ class UpdateExecutor : public AbstractExecutor {
                     throw ColumnNotFoundError(set_clause.lhs.col_name);
                 }
                 auto &col = *col_iter;
-                if (col.type != set_clause.rhs.type) {
+                if (!coltype_compatible(col.type, set_clause.rhs.type)) {
                     throw IncompatibleTypeError(coltype2str(col.type), coltype2str(set_clause.rhs.type));
                 }
                 (set_clause.rhs).init_raw(col.len);
                 memcpy(rec->data + col.offset, set_clause.rhs.raw->data, col.len);
                 set_clause.rhs.raw.reset();
             }
+            new_recs.push_back(*rec);
+        }
 
-            // 删除原索引项
-            for (size_t i = 0; i < tab_.indexes.size(); ++i) {
-                auto &index = tab_.indexes[i];
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-                ih->delete_entry(old_keys[i], context_->txn_);
-                delete[] old_keys[i];
-            }
-            // 插入新索引项
-            for (const auto &index : tab_.indexes) {
-                char *new_key = new char[index.col_tot_len];
-                int offset = 0;
-                for (const auto &col : index.cols) {
-                    memcpy(new_key + offset, rec->data + col.offset, col.len);
-                    offset += col.len;
+        // 唯一性检查：所有记录的新键值不能在本语句内重复；键值发生变化的记录还要检查
+        // 新键值没有被本语句之外的记录占用(一次点查)
+        for (auto &index : tab_.indexes) {
+            auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
+            std::set<std::string> new_keys;
+            for (size_t i = 0; i < rids_.size(); ++i) {
+                std::string old_key = get_key(index, old_recs[i].data);
+                std::string new_key = get_key(index, new_recs[i].data);
+                // 键值未变化的记录同样占用它的键，另一条记录改成这个键时也是冲突
+                bool dup = !new_keys.insert(new_key).second;
+                std::vector<Rid> owners;
+                if (!dup && old_key != new_key && ih->get_value(new_key.data(), &owners, context_->txn_)) {
+                    dup = std::find(rids_.begin(), rids_.end(), owners[0]) == rids_.end();
+                }
+                if (dup) {
+                    std::vector<std::string> col_names;
+                    for (auto &col : index.cols) col_names.push_back(col.name);
+                    throw DuplicateKeyError(tab_name_, col_names);
                 }
-                auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
-                ih->insert_entry(new_key, rid, context_->txn_);
-                delete[] new_key;
             }
+        }
 
-            bool exist = false;
-            scan_ = std::make_unique<RmScan>(fh_);
-            while (!scan_->is_end()) {
-                    auto r = scan_->rid();
-                    auto record = fh_->get_record(r,nullptr);
-                    if(r.page_no == rid.page_no && r.slot_no == rid.slot_no){
-                        //跳过待更新的RID
-                        scan_->next();
-                        continue;
-                    }
-                    if(memcmp(rec->data,record->data,record->size) == 0 && record->size == rec->size){
-                        exist = true;
-                        break;
-                    }
-                    scan_->next();
+        std::vector<Rid> new_rids = rids_;
+        for (size_t i = 0; i < rids_.size(); ++i) {
+            auto &rid = rids_[i];
+            if (!fh_->can_update_in_place(rid, new_recs[i].data)) {
+                // VARCHAR字段变长后原页面放不下，删除原记录后重新插入，记录的rid随之改变
+                new_rids[i] = relocate(rid, old_recs[i], new_recs[i]);
+                continue;
             }
-            if(!exist){
-                //加入write_set
-                WriteRecord *wr = new WriteRecord (WType::UPDATE_TUPLE,tab_.name,rid,old_rec,*rec);
-                context_->txn_->append_write_record(wr);
-                //加入log_buffer
-                UpdateLogRecord *update_log_record = new UpdateLogRecord(context_->txn_->get_transaction_id(),old_rec,*rec,rid,tab_name_);
-                context_->log_mgr_->add_log_to_buffer(update_log_record);
+            //加入write_set
+            WriteRecord *wr = new WriteRecord (WType::UPDATE_TUPLE,tab_.name,rid,old_recs[i],new_recs[i]);
+            context_->txn_->append_write_record(wr);
+            //加入log_buffer
+            UpdateLogRecord *update_log_record = new UpdateLogRecord(context_->txn_->get_transaction_id(),old_recs[i],new_recs[i],rid,tab_.id);
+            context_->txn_->set_prev_lsn(context_->log_mgr_->add_log_to_buffer(update_log_record));
+
+            // 更新记录到文件
+            fh_->update_record(rid, new_recs[i].data, context_);
+        }
 
-                // 更新记录到文件
-                fh_->update_record(rid, rec->data, context_);
+        // 索引在写日志之后更新，修改的索引页面以更新日志的lsn为页面lsn。
+        // 先删除所有旧索引项再插入新索引项，记录之间交换键值时不会出现暂时的冲突；
+        // 键值和rid都未变化的索引项不需要修改
+        for (auto &index : tab_.indexes) {
+            auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tab_name_, index.cols)).get();
+            std::vector<size_t> changed;
+            for (size_t i = 0; i < rids_.size(); ++i) {
+                if (new_rids[i] != rids_[i] || get_key(index, old_recs[i].data) != get_key(index, new_recs[i].data)) {
+                    changed.push_back(i);
+                }
+            }
+            for (auto i : changed) {
+                ih->delete_entry(get_key(index, old_recs[i].data).data(), context_->txn_);
+            }
+            for (auto i : changed) {
+                ih->insert_entry(get_key(index, new_recs[i].data).data(), new_rids[i], context_->txn_);
             }
         }
         return nullptr;
     }
 
     Rid &rid() override { return _abstract_rid; }
+
+   private:
+    /**
+     * @description: 把更新拆成一次删除和一次插入，分别写日志和write_set，回滚和恢复时按删除、插入处理
+     * @return {Rid} 新记录的rid
+     */
+    Rid relocate(const Rid &rid, RmRecord &old_rec, RmRecord &new_rec) {
+        Rid old_rid = rid;
+        context_->txn_->append_write_record(new WriteRecord(WType::DELETE_TUPLE, tab_.name, old_rid, old_rec));
+        DeleteLogRecord *delete_log_record =
+            new DeleteLogRecord(context_->txn_->get_transaction_id(), old_rec, old_rid, tab_.id);
+        context_->txn_->set_prev_lsn(context_->log_mgr_->add_log_to_buffer(delete_log_record));
+        fh_->delete_record(old_rid, context_);
+
+        Rid new_rid = fh_->insert_record(new_rec.data, context_, [&](const Rid &rid) {
+            Rid log_rid = rid;
+            InsertLogRecord insert_log_record(context_->txn_->get_transaction_id(), new_rec, log_rid, tab_.id);
+            lsn_t lsn = context_->log_mgr_->add_log_to_buffer(&insert_log_record);
+            context_->txn_->set_prev_lsn(lsn);
+            return lsn;
+        });
+        context_->txn_->append_write_record(new WriteRecord(WType::INSERT_TUPLE, tab_.name, new_rid, new_rec));
+        return new_rid;
+    }
+
+    // 按索引字段的顺序拼接出记录在该索引上的键
+    static std::string get_key(const IndexMeta &index, const char *data) {
+        std::string key;
+        key.reserve(index.col_tot_len);
+        for (const auto &col : index.cols) {
+            key.append(data + col.offset, col.len);
+        }
+        return key;
+    }
 };
\ No newline at end of file
@@ -9,6 +9,9 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "ix_index_handle.h"
+
+#include <unordered_set>
+
 #include "ix_scan.h"
 #include "math.h"
 
@@ -208,9 +211,9 @@ IxIndexHandle::IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffe
     file_hdr_ = new IxFileHdr();
     file_hdr_->deserialize(buf);
     
-    // disk_manager管理的fd对应的文件中，设置从file_hdr_->num_pages开始分配page_no
-    int now_page_no = disk_manager_->get_fd2pageno(fd);
-    disk_manager_->set_fd2pageno(fd, now_page_no + 1);
+    // 页面按页号递增分配，删除的页面不回收，num_pages_少于已经分配的页号，因此从文件末尾开始分配page_no
+    int file_pages = disk_manager_->get_file_size(disk_manager_->get_file_name(fd)) / PAGE_SIZE;
+    disk_manager_->set_fd2pageno(fd, std::max(disk_manager_->get_fd2pageno(fd), file_pages));
 }
 
 
@@ -232,12 +235,16 @@ std::pair<IxNodeHandle *, bool> IxIndexHandle::find_leaf_page(const char *key, O
     // 3. 找到包含该key值的叶子结点停止查找，并返回叶子节点
 
     page_id_t root_page_id = file_hdr_->root_page_;
-    IxNodeHandle *root = fetch_node(root_page_id);
+    // 插入/删除会修改路径上的结点，读取时记下它们修改之前的内容
+    auto fetch = [&](int page_no) {
+        return operation == Operation::FIND ? fetch_node(page_no) : fetch_node_for_write(page_no);
+    };
+    IxNodeHandle *root = fetch(root_page_id);
 	IxNodeHandle *cur = root;
     
 	while(!cur->is_leaf_page()){
 		IxNodeHandle *parent = cur;
-		cur = fetch_node(cur->internal_lookup(key));
+		cur = fetch(cur->internal_lookup(key));
 		buffer_pool_manager_->unpin_page(parent->get_page_id(), false);
 	}
     
@@ -307,9 +314,9 @@ IxNodeHandle *IxIndexHandle::split(IxNodeHandle *node) {
         new_node->page_hdr->next_leaf = node->page_hdr->next_leaf;
         node->page_hdr->next_leaf = new_node->get_page_no();
 		
-		IxNodeHandle* next_node = fetch_node(new_node->page_hdr->next_leaf);
+		IxNodeHandle* next_node = fetch_node_for_write(new_node->page_hdr->next_leaf);
         next_node->page_hdr->prev_leaf = new_node->get_page_no();
-		buffer_pool_manager_->unpin_page(next_node->get_page_id(), true);
+		unpin_dirty_node(next_node);
 	}
 
 	int pos = node->page_hdr->num_key / 2;
@@ -358,18 +365,19 @@ void IxIndexHandle::insert_into_parent(IxNodeHandle *old_node, const char *key,
 		file_hdr_->root_page_ = new_root_page;
 		new_node->page_hdr->parent = new_root_page;
 		old_node->page_hdr->parent = new_root_page;
+		unpin_dirty_node(new_root);
 	}
 	else{
-		IxNodeHandle* parent_node = fetch_node(old_node->get_parent_page_no());
+		IxNodeHandle* parent_node = fetch_node_for_write(old_node->get_parent_page_no());
 		int rid_idx = parent_node->find_child(old_node);
 		parent_node->insert_pair(rid_idx + 1, key, (Rid){new_node->get_page_id().page_no, -1});
 
 		if(parent_node->get_size() == parent_node->get_max_size()){
 			IxNodeHandle* new_parent = split(parent_node);
 			insert_into_parent(parent_node, new_parent->get_key(0), new_parent, transaction);
-			buffer_pool_manager_->unpin_page(new_parent->get_page_id(), true);
+			unpin_dirty_node(new_parent);
 		}
-		buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);
+		unpin_dirty_node(parent_node);
 	}
 }
 
@@ -389,6 +397,7 @@ page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transac
     // 1. 查找key值应该插入到哪个叶子节点
 
     std::unique_lock<std::mutex>lock(root_latch_);
+    begin_modify();
 	auto [leaf,b] = find_leaf_page(key, Operation::INSERT, transaction);
 	int cur_size = leaf->get_size(); //current size
 
@@ -399,6 +408,7 @@ page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transac
         leaf->insert_pair(pos, key, value);
     }else{
         buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+        end_modify(transaction);
         if(cmp == 0){
             throw InternalError("key has exists in index");
         }
@@ -411,9 +421,10 @@ page_id_t IxIndexHandle::insert_entry(const char *key, const Rid &value, Transac
             //更新last_leaf;
 			file_hdr_->last_leaf_ = new_node->get_page_no();
 		insert_into_parent(leaf, new_node->get_key(0), new_node, transaction);
-		buffer_pool_manager_->unpin_page(new_node->get_page_id(), true);//unpin
+		unpin_dirty_node(new_node);//unpin
 	}
-	buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+	unpin_dirty_node(leaf);
+	end_modify(transaction);
 	return true;
 }
 
@@ -430,17 +441,20 @@ bool IxIndexHandle::delete_entry(const char *key, Transaction *transaction) {
     // 4. 如果需要并发，并且需要删除叶子结点，则需要在事务的delete_page_set中添加删除结点的对应页面；记得处理并发的上锁
 
     std::unique_lock<std::mutex>lock(root_latch_);
+    begin_modify();
 	auto [leaf,b] = find_leaf_page(key, Operation::DELETE, transaction);
     
 	int size = leaf->get_size();
 	if(leaf->remove(key) == size){
 		buffer_pool_manager_->unpin_page(leaf->get_page_id(), false);
+		end_modify(transaction);
         //throw InternalError("delete failed");	
 		return false;
 	}
 	else{
 		coalesce_or_redistribute(leaf);
-		buffer_pool_manager_->unpin_page(leaf->get_page_id(), true);
+		unpin_dirty_node(leaf);
+		end_modify(transaction);
 		return true;
 	}
 }
@@ -474,26 +488,26 @@ bool IxIndexHandle::coalesce_or_redistribute(IxNodeHandle *node, Transaction *tr
 		maintain_parent(node);
 		return false;
 	}
-	IxNodeHandle *parent_node = fetch_node(node->get_parent_page_no()); 		
+	IxNodeHandle *parent_node = fetch_node_for_write(node->get_parent_page_no()); 		
 	IxNodeHandle *brother_node = nullptr;
 	int pos = parent_node->find_child(node);
 	if(pos){
-		brother_node = fetch_node(node->get_prev_leaf());
+		brother_node = fetch_node_for_write(node->get_prev_leaf());
 	}
 	else{
-		brother_node = fetch_node(node->get_next_leaf());
+		brother_node = fetch_node_for_write(node->get_next_leaf());
 	}
 	//unpin page
 	if(node->get_size() + brother_node->get_size() >= node->get_min_size() * 2){
 		redistribute(brother_node, node, parent_node, pos);
-		buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);
-    	buffer_pool_manager_->unpin_page(brother_node->get_page_id(), true);
+		unpin_dirty_node(parent_node);
+    	unpin_dirty_node(brother_node);
 		return false;
 	}
 	else{
 	    coalesce(&brother_node, &node, &parent_node, pos, transaction,root_is_latched);
-		buffer_pool_manager_->unpin_page(parent_node->get_page_id(), true);
-    	buffer_pool_manager_->unpin_page(brother_node->get_page_id(), true);
+		unpin_dirty_node(parent_node);
+    	unpin_dirty_node(brother_node);
         return true;
 	}
 }
@@ -518,11 +532,11 @@ bool IxIndexHandle::adjust_root(IxNodeHandle *old_root_node) {
 		}
 	}
 	else if(old_root_node->get_size() == 1){ //if size == 1
-		IxNodeHandle *new_root = fetch_node(old_root_node->value_at(0));
+		IxNodeHandle *new_root = fetch_node_for_write(old_root_node->value_at(0));
 		new_root->set_parent_page_no(INVALID_PAGE_ID);
 		file_hdr_->root_page_ = new_root->get_page_no(); //renew root page
 		release_node_handle(*old_root_node); //delete old root
-		buffer_pool_manager_->unpin_page(new_root->get_page_id(), true);
+		unpin_dirty_node(new_root);
 		return true;
 	}
     return false; 
@@ -696,6 +710,20 @@ Iid IxIndexHandle::leaf_begin() const {
     return iid;
 }
 
+/**
+ * @description: 把修改过的结点标记为脏页并unpin。记日志时推迟到end_modify()写完日志、记下页面lsn之后再unpin，
+ *  在此之前先标记为脏页，使这期间收集的脏页表包含该页面
+ * @param {IxNodeHandle*} node 修改过的结点
+ */
+bool IxIndexHandle::unpin_dirty_node(IxNodeHandle *node) {
+    if (log_manager_ == nullptr) {
+        return buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+    }
+    node->page->set_dirty(true);
+    dirty_nodes_.push_back(node);
+    return true;
+}
+
 /**
  * @brief 获取一个指定结点
  *
@@ -709,6 +737,18 @@ IxNodeHandle *IxIndexHandle::fetch_node(int page_no) const {
     return node;
 }
 
+/**
+ * @description: 获取插入/删除过程中可能被修改的结点，记日志时记下它在本次操作中第一次被修改之前的内容
+ * @note pin the page, remember to unpin it outside!
+ */
+IxNodeHandle *IxIndexHandle::fetch_node_for_write(int page_no) {
+    IxNodeHandle *node = fetch_node(page_no);
+    if (log_manager_ != nullptr && before_images_.count(page_no) == 0) {
+        before_images_.emplace(page_no, std::string(node->page->get_data(), PAGE_SIZE));
+    }
+    return node;
+}
+
 /**
  * @brief 创建一个新结点
  *
@@ -726,6 +766,9 @@ IxNodeHandle *IxIndexHandle::create_node() {
     // 从3开始分配page_no，第一次分配之后，new_page_id.page_no=3，file_hdr_.num_pages=4
     Page *page = buffer_pool_manager_->new_page(&new_page_id);
     node = new IxNodeHandle(file_hdr_, page);
+    if (log_manager_ != nullptr) {
+        before_images_[new_page_id.page_no] = std::string(page->get_data(), PAGE_SIZE);
+    }
     return node;
 }
 
@@ -738,18 +781,18 @@ void IxIndexHandle::maintain_parent(IxNodeHandle *node) {
     IxNodeHandle *curr = node;
     while (curr->get_parent_page_no() != IX_NO_PAGE) {
         // Load its parent
-        IxNodeHandle *parent = fetch_node(curr->get_parent_page_no());
+        IxNodeHandle *parent = fetch_node_for_write(curr->get_parent_page_no());
         int rank = parent->find_child(curr);
         char *parent_key = parent->get_key(rank);
         char *child_first_key = curr->get_key(0);
         if (memcmp(parent_key, child_first_key, file_hdr_->col_tot_len_) == 0) {
-            assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
+            unpin_dirty_node(parent);
             break;
         }
         memcpy(parent_key, child_first_key, file_hdr_->col_tot_len_);  // 修改了parent node
         curr = parent;
 
-        assert(buffer_pool_manager_->unpin_page(parent->get_page_id(), true));
+        unpin_dirty_node(parent);
     }
 }
 
@@ -761,13 +804,13 @@ void IxIndexHandle::maintain_parent(IxNodeHandle *node) {
 void IxIndexHandle::erase_leaf(IxNodeHandle *leaf) {
     assert(leaf->is_leaf_page());
 
-    IxNodeHandle *prev = fetch_node(leaf->get_prev_leaf());
+    IxNodeHandle *prev = fetch_node_for_write(leaf->get_prev_leaf());
     prev->set_next_leaf(leaf->get_next_leaf());
-    buffer_pool_manager_->unpin_page(prev->get_page_id(), true);
+    unpin_dirty_node(prev);
 
-    IxNodeHandle *next = fetch_node(leaf->get_next_leaf());
+    IxNodeHandle *next = fetch_node_for_write(leaf->get_next_leaf());
     next->set_prev_leaf(leaf->get_prev_leaf());  // 注意此处是SetPrevLeaf()
-    buffer_pool_manager_->unpin_page(next->get_page_id(), true);
+    unpin_dirty_node(next);
 }
 
 /**
@@ -786,8 +829,98 @@ void IxIndexHandle::maintain_child(IxNodeHandle *node, int child_idx) {
     if (!node->is_leaf_page()) {
         //  Current node is inner node, load its child and set its parent to current node
         int child_page_no = node->value_at(child_idx);
-        IxNodeHandle *child = fetch_node(child_page_no);
+        IxNodeHandle *child = fetch_node_for_write(child_page_no);
         child->set_parent_page_no(node->get_page_no());
-        buffer_pool_manager_->unpin_page(child->get_page_id(), true);
+        unpin_dirty_node(child);
     }
+}
+
+/**
+ * @description: 把文件头(根结点、叶子链表首尾、页面个数)写回索引文件的第0页。文件头不经过缓冲池，
+ *  修改时只写进INDEX日志，在检查点和恢复结束时写回。写回前先把日志刷盘，
+ *  磁盘上的文件头不会反映日志还没有落盘的修改
+ */
+void IxIndexHandle::write_file_hdr() {
+    std::lock_guard<std::mutex> lock(root_latch_);
+    if (log_manager_ != nullptr) {
+        log_manager_->flush_log_to_disk();
+    }
+    std::string data = serialize_file_hdr();
+    disk_manager_->write_page(fd_, IX_FILE_HDR_PAGE, data.data(), data.size());
+}
+
+std::string IxIndexHandle::serialize_file_hdr() const {
+    std::string data(file_hdr_->tot_len_, '\0');
+    file_hdr_->serialize(data.data());
+    return data;
+}
+
+/**
+ * @description: 开始一次插入/删除，记下操作之前的文件头，调用者需持有root_latch_
+ */
+void IxIndexHandle::begin_modify() {
+    if (log_manager_ != nullptr) {
+        hdr_image_ = serialize_file_hdr();
+    }
+}
+
+/**
+ * @description: 结束一次插入/删除。把本次修改的页面(相对于修改之前的内容)和变化后的文件头写成一条INDEX日志，
+ *  以日志的lsn作为这些页面的页面lsn，之后才unpin，保证页面写回之前日志已经落盘(写回时按页面lsn刷日志)。
+ *  一次操作的所有修改在同一条日志中，redo之后的B+树总是某次操作完成之后的状态
+ * @param {Transaction*} transaction 执行操作的事务，建立索引和恢复时为nullptr
+ */
+void IxIndexHandle::end_modify(Transaction *transaction) {
+    if (!dirty_nodes_.empty()) {
+        txn_id_t txn_id = transaction != nullptr ? transaction->get_transaction_id() : INVALID_TXN_ID;
+        IndexLogRecord log(txn_id, disk_manager_->get_file_name(fd_));
+        std::unordered_set<page_id_t> logged;
+        for (auto node : dirty_nodes_) {
+            page_id_t page_no = node->get_page_no();
+            if (logged.insert(page_no).second) {
+                log.add_page(page_no, before_images_.at(page_no).data(), node->page->get_data());
+            }
+        }
+        std::string hdr = serialize_file_hdr();
+        if (hdr != hdr_image_) {
+            log.set_file_hdr(hdr);
+        }
+        lsn_t lsn = log_manager_->add_log_to_buffer(&log);
+        for (auto node : dirty_nodes_) {
+            node->page->set_page_lsn(lsn);
+        }
+        for (auto node : dirty_nodes_) {
+            buffer_pool_manager_->unpin_page(node->get_page_id(), true);
+        }
+    }
+    dirty_nodes_.clear();
+    before_images_.clear();
+}
+
+/**
+ * @description: 建立索引时写一条带有初始文件头的INDEX日志。之前删除的同名索引的日志在恢复时不再重做，
+ *  之后的插入都写日志，建立索引之后不需要把索引页面写回
+ */
+void IxIndexHandle::log_create(Transaction *transaction) {
+    std::lock_guard<std::mutex> lock(root_latch_);
+    if (log_manager_ == nullptr) {
+        return;
+    }
+    txn_id_t txn_id = transaction != nullptr ? transaction->get_transaction_id() : INVALID_TXN_ID;
+    IndexLogRecord log(txn_id, disk_manager_->get_file_name(fd_), true);
+    log.set_file_hdr(serialize_file_hdr());
+    log_manager_->add_log_to_buffer(&log);
+}
+
+/**
+ * @description: 恢复时用日志中最新的文件头替换内存中的文件头
+ * @param {string&} image 序列化的文件头
+ */
+void IxIndexHandle::set_file_hdr(const std::string &image) {
+    std::lock_guard<std::mutex> lock(root_latch_);
+    std::vector<char> data(image.begin(), image.end());
+    IxFileHdr *file_hdr = new IxFileHdr();
+    file_hdr->deserialize(data.data());
+    delete file_hdr_;
+    file_hdr_ = file_hdr;
 }
\ No newline at end of file
@@ -10,7 +10,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <unordered_map>
+
 #include "ix_defs.h"
+#include "recovery/log_manager.h"
 #include "transaction/transaction.h"
 
 enum class Operation { FIND = 0, INSERT, DELETE };  // 三种操作：查找、插入、删除
@@ -31,6 +34,7 @@ inline int ix_compare(const char *a, const char *b, ColType type, int col_len) {
             return (fa < fb) ? -1 : ((fa > fb) ? 1 : 0);
         }
         case TYPE_STRING:
+        case TYPE_VARCHAR:  // 索引键中的VARCHAR与CHAR一样补0到定长
             return memcmp(a, b, col_len);
         default:
             throw InternalError("Unexpected data type");
@@ -185,6 +189,12 @@ class IxIndexHandle {
     int fd_;                                    // 存储B+树的文件 (tab索引文件)
     IxFileHdr* file_hdr_;                       // 存了root_page，但其初始化为2（第0页存FILE_HDR_PAGE，第1页存LEAF_HEADER_PAGE）
     std::mutex root_latch_;
+    LogManager *log_manager_ = nullptr;         // 不为空时，每次插入/删除修改的页面和文件头写成一条INDEX日志
+
+    // 当前插入/删除操作修改的页面，受root_latch_保护
+    std::unordered_map<page_id_t, std::string> before_images_;  // 页面在本次操作中被修改之前的内容
+    std::vector<IxNodeHandle *> dirty_nodes_;                   // 修改过的结点，写完日志之后才unpin，页面不会先于日志落盘
+    std::string hdr_image_;                                     // 操作开始时序列化的文件头
 
    public:
     IxIndexHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, int fd);
@@ -195,6 +205,8 @@ class IxIndexHandle {
 
     int get_ix_file_fd(){return fd_;}
 
+    void set_log_manager(LogManager *log_manager) { log_manager_ = log_manager; }
+
     BufferPoolManager* get_buf_mgr(){return buffer_pool_manager_;}
 
     // for search
@@ -229,6 +241,12 @@ class IxIndexHandle {
     Iid leaf_end() const;
 
     Iid leaf_begin() const;
+
+    void write_file_hdr();
+
+    void log_create(Transaction *transaction);
+
+    void set_file_hdr(const std::string &image);
     // for get/create node
     IxNodeHandle *fetch_node(int page_no) const;
    private:
@@ -239,6 +257,16 @@ class IxIndexHandle {
 
     IxNodeHandle *create_node();
 
+    IxNodeHandle *fetch_node_for_write(int page_no);
+
+    bool unpin_dirty_node(IxNodeHandle *node);
+
+    void begin_modify();
+
+    void end_modify(Transaction *transaction);
+
+    std::string serialize_file_hdr() const;
+
     // for maintain data structure
     void maintain_parent(IxNodeHandle *node);
 
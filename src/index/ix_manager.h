@@ -59,7 +59,7 @@ class IxManager {
         // Create index file
         disk_manager_->create_file(ix_name);
         // Open index file
-        int fd = disk_manager_->open_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name, true);
 
         // Create file header and write to file
         // Theoretically we have: |page_hdr| + (|attr| + |rid|) * n <= PAGE_SIZE
@@ -152,13 +152,13 @@ class IxManager {
     // 注意这里打开文件，创建并返回了index file handle的指针
     std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<ColMeta>& index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
-        int fd = disk_manager_->open_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name, true);
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
     std::unique_ptr<IxIndexHandle> open_index(const std::string &filename, const std::vector<std::string>& index_cols) {
         std::string ix_name = get_index_name(filename, index_cols);
-        int fd = disk_manager_->open_file(ix_name);
+        int fd = disk_manager_->open_file(ix_name, true);
         return std::make_unique<IxIndexHandle>(disk_manager_, buffer_pool_manager_, fd);
     }
 
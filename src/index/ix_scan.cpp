@@ -19,6 +19,11 @@ void IxScan::next() {
     IxNodeHandle *node = ih_->fetch_node(iid_.page_no);
     assert(node->is_leaf_page());
     assert(iid_.slot_no < node->get_size());
+    // 进入一个新的叶子结点时预读下一个叶子结点，读取与扫描当前结点重叠
+    if (iid_.page_no != ih_->file_hdr_->last_leaf_ && node->get_next_leaf() != prefetched_leaf_) {
+        prefetched_leaf_ = node->get_next_leaf();
+        bpm_->prefetch(PageId{ih_->fd_, prefetched_leaf_});
+    }
     // increment slot no
     iid_.slot_no++;
     if (iid_.page_no != ih_->file_hdr_->last_leaf_ && iid_.slot_no == node->get_size()) {
@@ -23,6 +23,7 @@ class IxScan : public RecScan {
     Iid iid_;  // 初始为lower（用于遍历的指针）
     Iid end_;  // 初始为upper
     BufferPoolManager *bpm_;
+    int prefetched_leaf_ = IX_NO_PAGE;  // 已经发出预读请求的叶子结点
 
    public:
     IxScan(const IxIndexHandle *ih, const Iid &lower, const Iid &upper,BufferPoolManager * bpm)
@@ -38,6 +38,9 @@ class Optimizer {
         } else if (auto x = std::dynamic_pointer_cast<ast::ShowTables>(query->parse)) {
             // show tables;
             return std::make_shared<OtherPlan>(T_ShowTable, std::string());
+        }else if (auto x = std::dynamic_pointer_cast<ast::ShowRecoveryStats>(query->parse)) {
+            // show recovery stats;
+            return std::make_shared<OtherPlan>(T_ShowRecoveryStats, std::string());
         }else if (auto x = std::dynamic_pointer_cast<ast::ShowIndex>(query->parse)) {
             //show indexs;
             return std::make_shared<OtherPlan>(T_ShowIndex, x->tab_name);
@@ -24,6 +24,7 @@ typedef enum PlanTag{
     T_Help,
     T_ShowTable,
     T_ShowIndex,
+    T_ShowRecoveryStats,
     T_DescTable,
     T_CreateTable,
     T_DropTable,
@@ -205,17 +206,20 @@ class DMLPlan : public Plan
 class DDLPlan : public Plan
 {
     public:
-        DDLPlan(PlanTag tag, std::string tab_name, std::vector<std::string> col_names, std::vector<ColDef> cols)
+        DDLPlan(PlanTag tag, std::string tab_name, std::vector<std::string> col_names, std::vector<ColDef> cols,
+                std::vector<KeyDef> keys = std::vector<KeyDef>())
         {
             Plan::tag = tag;
             tab_name_ = std::move(tab_name);
             cols_ = std::move(cols);
             tab_col_names_ = std::move(col_names);
+            keys_ = std::move(keys);
         }
         ~DDLPlan(){}
         std::string tab_name_;
         std::vector<std::string> tab_col_names_;
         std::vector<ColDef> cols_;
+        std::vector<KeyDef> keys_;      // create table中声明的约束
 };
 
 // help; show tables; desc tables; begin; abort; commit; rollback语句对应的plan
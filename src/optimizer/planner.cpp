@@ -458,17 +458,24 @@ std::shared_ptr<Plan> Planner::do_planner(std::shared_ptr<Query> query, Context
     if (auto x = std::dynamic_pointer_cast<ast::CreateTable>(query->parse)) {
         // create table;
         std::vector<ColDef> col_defs;
+        std::vector<KeyDef> key_defs;
         for (auto &field : x->fields) {
             if (auto sv_col_def = std::dynamic_pointer_cast<ast::ColDef>(field)) {
                 ColDef col_def = {.name = sv_col_def->col_name,
                                   .type = interp_sv_type(sv_col_def->type_len->type),
                                   .len = sv_col_def->type_len->len};
                 col_defs.push_back(col_def);
+                if (sv_col_def->key != ast::SV_KEY_NONE) {
+                    key_defs.push_back({interp_key_type(sv_col_def->key), {sv_col_def->col_name}});
+                }
+            } else if (auto sv_key_def = std::dynamic_pointer_cast<ast::KeyDef>(field)) {
+                key_defs.push_back({interp_key_type(sv_key_def->key), sv_key_def->col_names});
             } else {
                 throw InternalError("Unexpected field type");
             }
         }
-        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs);
+        plannerRoot = std::make_shared<DDLPlan>(T_CreateTable, x->tab_name, std::vector<std::string>(), col_defs,
+                                                key_defs);
     } else if (auto x = std::dynamic_pointer_cast<ast::DropTable>(query->parse)) {
         // drop table;
         plannerRoot = std::make_shared<DDLPlan>(T_DropTable, x->tab_name, std::vector<std::string>(), std::vector<ColDef>());
@@ -62,10 +62,17 @@ class Planner {
 
     ColType interp_sv_type(ast::SvType sv_type) {
         std::map<ast::SvType, ColType> m = {
-            {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING}};
+            {ast::SV_TYPE_INT, TYPE_INT}, {ast::SV_TYPE_FLOAT, TYPE_FLOAT}, {ast::SV_TYPE_STRING, TYPE_STRING},
+            {ast::SV_TYPE_VARCHAR, TYPE_VARCHAR}};
         return m.at(sv_type);
     }
 
+    KeyType interp_key_type(ast::SvKeyType sv_key_type) {
+        std::map<ast::SvKeyType, KeyType> m = {
+            {ast::SV_KEY_NONE, KEY_NONE}, {ast::SV_KEY_PRIMARY, KEY_PRIMARY}, {ast::SV_KEY_UNIQUE, KEY_UNIQUE}};
+        return m.at(sv_key_type);
+    }
+
     std::vector<Condition> pop_conds(std::vector<Condition> &conds, std::string tab_names);
     std::shared_ptr<Plan> pop_scan(int *scantbl, TabCol col, std::vector<std::string> &joined_tables, 
                 std::vector<std::shared_ptr<Plan>> plans);
@@ -20,7 +20,7 @@ enum JoinType {
 namespace ast {
 
 enum SvType {
-    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_BOOL
+    SV_TYPE_INT, SV_TYPE_FLOAT, SV_TYPE_STRING, SV_TYPE_VARCHAR, SV_TYPE_BOOL
 };
 
 enum SvCompOp {
@@ -33,8 +33,12 @@ enum OrderByDir {
     OrderBy_DESC
 };
 
+enum SvKeyType {
+    SV_KEY_NONE, SV_KEY_PRIMARY, SV_KEY_UNIQUE
+};
+
 enum SetKnobType {
-    EnableNestLoop, EnableSortMerge
+    EnableNestLoop, EnableSortMerge, EnableAsyncCommit
 };
 
 // Base class for tree nodes
@@ -48,6 +52,9 @@ struct Help : public TreeNode {
 struct ShowTables : public TreeNode {
 };
 
+struct ShowRecoveryStats : public TreeNode {
+};
+
 struct ShowIndex : public TreeNode {
     std::string tab_name;
     ShowIndex(std::string tab_name_) : tab_name(std::move(tab_name_)) {}
@@ -82,9 +89,19 @@ struct Field : public TreeNode {
 struct ColDef : public Field {
     std::string col_name;
     std::shared_ptr<TypeLen> type_len;
+    SvKeyType key;      // 列级约束，如 id int primary key
 
-    ColDef(std::string col_name_, std::shared_ptr<TypeLen> type_len_) :
-            col_name(std::move(col_name_)), type_len(std::move(type_len_)) {}
+    ColDef(std::string col_name_, std::shared_ptr<TypeLen> type_len_, SvKeyType key_ = SV_KEY_NONE) :
+            col_name(std::move(col_name_)), type_len(std::move(type_len_)), key(key_) {}
+};
+
+// 表级约束，如 primary key (a, b) / unique (c)
+struct KeyDef : public Field {
+    SvKeyType key;
+    std::vector<std::string> col_names;
+
+    KeyDef(SvKeyType key_, std::vector<std::string> col_names_) :
+            key(key_), col_names(std::move(col_names_)) {}
 };
 
 struct CreateTable : public TreeNode {
@@ -309,6 +326,8 @@ struct SemValue {
 
     std::shared_ptr<TypeLen> sv_type_len;
 
+    SvKeyType sv_key_type;
+
     std::shared_ptr<Field> sv_field;
     std::vector<std::shared_ptr<Field>> sv_fields;
 
@@ -379,8 +379,8 @@ static void yynoreturn yy_fatal_error ( const char* msg  );
 	(yy_hold_char) = *yy_cp; \
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 61
-#define YY_END_OF_BUFFER 62
+#define YY_NUM_RULES 68
+#define YY_END_OF_BUFFER 69
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -388,33 +388,37 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[222] =
+static const flex_int16_t yy_accept[271] =
     {   0,
-        0,    0,    0,    0,   62,   60,    6,    7,    7,   60,
-       55,   60,   60,   60,   57,   55,   55,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,    3,    4,    6,    7,
-        0,   59,   57,    5,    1,   58,   53,   54,   52,   56,
-       56,   56,   22,   56,   56,   37,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   49,
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,    2,    5,   58,   56,   32,   38,
-       45,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   28,
-       56,   47,   46,   56,   56,   56,   26,   56,   56,   44,
-       56,   56,   56,   56,   56,   56,   56,   29,   56,   56,
-       56,   56,   17,   16,   56,   34,   56,   56,   23,   56,
-       56,   35,   56,   56,   19,   33,   56,   56,   56,    8,
-       56,   56,   42,   56,   56,   56,   11,    9,   56,   48,
-       56,   56,   56,   43,   30,   50,   56,   31,   56,   36,
-       56,   56,   56,   15,   56,   56,   24,   10,   14,   21,
-       56,   51,   18,   56,   27,   56,   13,   25,   20,   56,
-       56,   56,   56,   56,   12,   56,   56,   56,   56,   56,
-
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   40,   56,   56,   41,   56,   39,
-        0
+        0,    0,    0,    0,   69,   67,    6,    7,    7,   67,
+       62,   62,   62,   67,   62,   67,   62,   67,   64,   62,
+       62,   62,   62,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,    3,    3,    4,    6,    7,    0,
+       66,   64,    5,    1,   65,   60,   61,   59,   63,   63,
+       63,   63,   22,   63,   63,   63,   38,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,   63,
+       56,   63,   63,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,    2,
+
+        5,   65,   63,   33,   39,   52,   63,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,   28,   63,   47,   54,   53,   63,
+       63,   63,   63,   63,   26,   63,   63,   51,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   29,   63,   63,
+       63,   63,   17,   16,   63,   35,   63,   63,   23,   63,
+       63,   36,   63,   63,   19,   34,   63,   63,   63,   63,
+       63,    8,   63,   63,   49,   63,   63,   63,   63,   63,
+       11,    9,   63,   55,   63,   63,   63,   50,   31,   57,
+       63,   32,   63,   37,   63,   63,   63,   63,   63,   45,
+
+       15,   63,   63,   63,   63,   24,   10,   14,   21,   63,
+       58,   18,   63,   63,   63,   27,   63,   13,   48,   25,
+       20,   63,   63,   46,   63,   63,   63,   30,   63,   63,
+       63,   44,   12,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,   63,
+       63,   63,   63,   63,   63,   63,   63,   63,   63,   41,
+       63,   63,   63,   42,   63,   63,   40,   63,   43,    0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -427,12 +431,12 @@ static const YY_CHAR yy_ec[256] =
        14,   14,   14,   14,   14,   14,   14,    1,   15,   16,
        17,   18,    1,    1,   19,   20,   21,   22,   23,   24,
        25,   26,   27,   28,   29,   30,   31,   32,   33,   34,
-       35,   36,   37,   38,   39,   40,   41,   42,   43,   35,
-        1,    1,    1,    1,   44,    1,   45,   46,   47,   48,
+       35,   36,   37,   38,   39,   40,   41,   42,   43,   44,
+        1,    1,    1,    1,   45,    1,   19,   20,   21,   22,
 
-       49,   50,   51,   52,   53,   54,   55,   56,   57,   58,
-       59,   60,   35,   61,   62,   63,   64,   65,   66,   67,
-       68,   35,    1,    1,    1,    1,    1,    1,    1,    1,
+       23,   24,   25,   26,   27,   28,   29,   30,   31,   32,
+       33,   34,   35,   36,   37,   38,   39,   40,   41,   42,
+       43,   44,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -449,193 +453,209 @@ static const YY_CHAR yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static const YY_CHAR yy_meta[69] =
+static const YY_CHAR yy_meta[46] =
     {   0,
-        1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    3,    1,    1,    1,    1,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
-        3,    3,    3,    3,    3,    3,    3,    3
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1
     } ;
 
-static const flex_int16_t yy_base[226] =
+static const flex_int16_t yy_base[271] =
     {   0,
-        0,    0,  409,  407,  411,  439,  408,  439,  406,  402,
-      439,  392,   58,  394,   59,   57,  371,   50,   54,   50,
-       55,   47,   62,   49,   76,   48,   60,    0,  101,   52,
-       67,  101,   98,   95,  111,  105,  439,  337,  292,  439,
-      280,  439,  121,    0,  439,  169,  439,  439,  439,    0,
-       99,  114,  116,  116,  117,    0,  125,  121,  122,  136,
-      115,  130,  124,  131,  136,  143,  146,  107,  150,  159,
-      155,  142,  154,  166,  159,  161,  157,  174,  163,  180,
-      164,  179,  174,  187,  439,    0,  124,  177,    0,    0,
-        0,  184,  182,  192,  193,  210,  208,  211,  199,  214,
-
-      201,  203,  216,  210,  205,  215,  211,  223,  224,  215,
-      218,    0,    0,  229,  223,  231,    0,  215,  224,    0,
-      233,  243,  251,  236,  241,  244,  251,    0,  257,  248,
-      250,  252,    0,    0,  261,    0,  270,  257,    0,  263,
-      266,    0,  259,  267,    0,    0,  268,  279,  284,    0,
-      279,  285,    0,  274,  291,  293,    0,    0,  280,    0,
-      298,  299,  304,    0,    0,    0,  305,    0,  295,    0,
-      316,  300,  315,  302,  318,  307,    0,    0,    0,    0,
-       57,    0,    0,  324,    0,   50,    0,    0,    0,  314,
-      320,  331,  331,  322,    0,  331,  322,  324,  342,  330,
-
-      332,  345,  343,  343,  348,  346,  359,  352,  354,  353,
-      357,  360,  371,  370,    0,  375,  369,    0,  366,    0,
-      439,  429,  432,   81,  435
+        1,   47,   48,   94,   95,  506,   46,  506,   93,   96,
+      506,  506,  506,  128,  506,  132,  506,  136,  133,  506,
+      129,  506,  131,  135,  161,  159,  160,  165,  186,  163,
+      168,  158,  117,  171,  115,  191,  116,  153,  190,  189,
+      198,  187,  201,  180,  506,  506,  211,  225,  506,  226,
+      506,  229,  231,  506,  216,  506,  506,  506,  277,  278,
+      246,  209,  259,  256,  282,  258,  284,  266,  255,  264,
+      260,  262,  269,  265,  261,  263,  267,  268,  249,  272,
+      271,  276,  270,  257,  273,  285,  279,  283,  280,  281,
+      287,  293,  286,  294,  288,  289,  296,  292,  275,  506,
+
+      315,  321,  290,  323,  324,  325,  302,  295,  299,  300,
+      314,  311,  316,  301,  318,  298,  303,  320,  310,  304,
+      317,  308,  322,  326,  313,  319,  347,  348,  350,  329,
+      327,  328,  330,  331,  353,  332,  333,  355,  334,  336,
+      335,  337,  338,  341,  339,  340,  342,  357,  345,  343,
+      344,  346,  363,  365,  349,  366,  360,  351,  367,  352,
+      356,  368,  354,  358,  369,  376,  359,  361,  362,  370,
+      364,  387,  371,  374,  391,  372,  375,  377,  373,  378,
+      392,  393,  379,  403,  381,  382,  383,  407,  409,  410,
+      389,  412,  380,  415,  384,  396,  397,  385,  400,  422,
+
+      388,  401,  404,  394,  411,  426,  428,  429,  432,  390,
+      433,  434,  395,  405,  416,  436,  398,  439,  440,  442,
+      444,  413,  427,  445,  408,  418,  431,  448,  417,  430,
+      423,  450,  455,  435,  414,  421,  424,  443,  437,  425,
+      438,  441,  446,  447,  449,  452,  420,  451,  456,  453,
+      454,  457,  458,  459,  460,  461,  463,  462,  465,  468,
+      474,  466,  469,  470,  464,  472,  471,  467,  473,  506
     } ;
 
-static const flex_int16_t yy_def[226] =
+static const flex_int16_t yy_def[271] =
     {   0,
-      221,    1,  222,  222,  221,  221,  221,  221,  221,  223,
-      221,  221,  221,  221,  221,  221,  221,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  221,  221,  221,  221,
-      223,  221,  221,  225,  221,  221,  221,  221,  221,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  221,  225,  221,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-      224,  224,  224,  224,  224,  224,  224,  224,  224,  224,
-        0,  221,  221,  221,  221
+      270,    1,  270,    3,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,   14,  270,  270,   14,  270,
+      270,  270,  270,  270,   24,   25,   25,   25,   27,   27,
+       25,   28,   30,   25,   30,   35,   30,   30,   33,   34,
+       30,   32,   35,   35,  270,  270,  270,    7,  270,   10,
+      270,   19,  270,  270,  270,  270,  270,  270,   35,   35,
+       33,   35,   35,   35,   35,   35,   35,   35,   35,   34,
+       35,   33,   35,   35,   35,   33,   33,   33,   35,   35,
+       35,   35,   35,   35,   32,   35,   35,   35,   35,   35,
+       33,   35,   35,   35,   35,   35,   35,   30,   34,  270,
+
+       53,   55,   30,   35,   35,   35,   35,   30,   35,   32,
+       35,   34,   35,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   34,   34,   33,   32,   35,   35,   35,   34,
+       35,   33,   35,   34,   35,   35,   35,   35,   35,   34,
+       35,   35,   35,   35,   30,   35,   32,   35,   35,   35,
+       35,   35,   35,   35,   35,   35,   34,   35,   35,   35,
+       32,   35,   35,   30,   35,   35,   30,   35,   35,   35,
+       35,   35,   35,   34,   35,   35,   35,   34,   35,   34,
+       35,   35,   35,   35,   34,   34,   34,   35,   35,   35,
+       35,   35,   35,   35,   30,   34,   35,   35,   35,   35,
+
+       35,   34,   34,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   35,   30,   35,   35,   35,   35,   35,   35,
+       35,   30,   32,   35,   35,   35,   35,   35,   35,   34,
+       33,   35,   35,   35,   35,   35,   30,   34,   32,   35,
+       35,   35,   35,   35,   35,   35,   35,   33,   34,   35,
+       35,   33,   30,   33,   33,   35,   35,   35,   35,   35,
+       34,   32,   35,   35,   35,   35,   35,   35,   35,    0
     } ;
 
-static const flex_int16_t yy_nxt[508] =
+static const flex_int16_t yy_nxt[552] =
     {   0,
-        6,    7,    8,    9,   10,   11,   11,   11,   12,   11,
-       13,   11,   14,   15,   11,   16,   11,   17,   18,   19,
-       20,   21,   22,   23,   24,   25,   26,   27,   28,   28,
-       29,   28,   30,   28,   28,   31,   32,   33,   34,   35,
-       36,   28,   28,    6,   18,   19,   20,   21,   22,   23,
-       24,   25,   26,   27,   28,   28,   29,   28,   30,   28,
-       31,   32,   33,   34,   35,   36,   28,   28,   44,   51,
-       46,   43,   43,   47,   48,   57,   55,   60,   62,   70,
-       64,   52,   58,   50,   67,   59,   53,   74,   63,   54,
-       61,   65,   71,  192,   68,   51,   56,   66,   69,   75,
-
-      190,   57,   55,   60,   62,   70,   64,   52,   58,   67,
-       59,   53,   74,   63,   54,   61,   80,   65,   71,   72,
-       68,   56,   66,   76,   69,   75,   77,   73,   82,   83,
-       84,   88,   46,   81,   43,   89,   90,   87,   78,   79,
-       91,   92,   80,   93,   96,   72,  106,   99,  100,   76,
-      101,   94,   77,   73,   82,   83,   84,   88,   81,   95,
-      102,   89,   90,   78,   79,   97,   91,   92,  103,   93,
-       96,  106,   98,   99,  100,  104,  101,   94,  105,  107,
-      108,  111,   87,  112,   95,  113,  102,  114,  115,  118,
-      116,   97,  119,  120,  103,  109,  110,   98,  117,  121,
-
-      123,  104,  122,  124,  105,  107,  108,  111,  112,  125,
-      127,  113,  126,  114,  115,  118,  116,  128,  119,  120,
-      109,  110,  129,  117,  130,  121,  123,  122,  131,  124,
-      132,  133,  134,  135,  138,  125,  127,  126,  136,  137,
-      139,  141,  128,  140,  142,  143,  144,  145,  129,  146,
-      130,  147,  148,  149,  131,  150,  132,  133,  134,  135,
-      138,  151,  152,  136,  137,  153,  139,  141,  140,  154,
-      142,  143,  144,  145,  155,  146,  156,  147,  148,  149,
-      150,  157,  158,  159,   42,  160,  151,  161,  152,  162,
-      163,  153,  164,   39,  165,  154,  166,  167,  171,  155,
-
-      168,  156,  169,  170,  172,  173,  157,  174,  158,  159,
-      160,  175,  161,  176,  162,  177,  163,  178,  164,  165,
-      179,  180,  166,  167,  171,  168,  181,  169,  170,  182,
-      172,  173,  183,  174,  184,  186,  175,  185,  187,  176,
-      188,  177,  178,  189,  191,  193,  179,  180,  195,   85,
-      194,  196,  181,  197,  198,  182,  199,  183,  200,  201,
-      184,  186,  185,  187,  202,  205,  188,  203,  189,  204,
-      191,  193,  206,  207,  195,  194,  208,  196,  209,  197,
-      198,  210,  199,  200,  201,  211,  212,   49,  213,  214,
-      202,  205,  203,  215,  204,  216,  217,  218,  206,  207,
-
-      219,   45,  208,  220,  209,   43,   42,  210,   40,   39,
-      221,  211,  212,  213,   38,  214,   38,  221,  221,  215,
-      221,  216,  217,  218,  221,  221,  219,  221,  220,   37,
-       37,   37,   41,   41,   41,   86,  221,   86,    5,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-
-      221,  221,  221,  221,  221,  221,  221
+        0,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+       15,   16,   17,   18,   19,   20,   21,   22,   23,   24,
+       25,   26,   27,   28,   29,   30,   31,   32,   33,   34,
+       35,   36,   35,   37,   38,   35,   39,   40,   41,   42,
+       43,   44,   35,   35,   35,    6,    5,   48,   45,   45,
+       46,   45,   45,   45,   45,   47,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,    5,  270,   49,   50,   50,   50,   50,
+
+       51,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   50,   50,   50,   50,   50,   50,   50,   50,   50,
+       50,   52,   53,   54,   55,   56,   57,   58,   59,   82,
+       60,   86,   60,   60,   61,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   62,   60,   60,   60,
+       60,   63,   60,   60,   64,   60,   60,   60,   60,   65,
+       60,   60,   71,   66,   68,   60,   79,   60,   87,   81,
+       80,   69,   60,   83,   70,   72,   73,   60,   78,   60,
+
+       60,   60,   60,   67,   75,   99,   74,   60,   60,   84,
+       60,   90,   88,   60,   91,   76,   94,   85,   96,   98,
+       97,   77,   89,  100,    5,    5,   92,   93,    5,  102,
+      104,  101,  101,   95,  101,  101,  101,  101,  101,  101,
+      101,  101,  101,  101,  101,  101,  101,  101,  101,  101,
+      101,  101,  101,  101,  101,  101,  101,  101,  101,  101,
+      101,  101,  101,  101,  101,  101,  101,  101,  101,  101,
+      101,  101,  101,  101,  101,  101,    5,    5,  103,  105,
+      106,    5,  107,    5,  108,  109,  111,  115,  121,  112,
+      117,  116,  123,  110,  114,  118,  113,  145,  128,  119,
+
+      120,  122,  126,  132,  129,  131,  130,  124,  125,  133,
+      134,  137,  127,  139,    5,  141,  138,  142,  135,  136,
+        5,  143,    5,    5,    5,  146,  140,  144,  147,  149,
+      148,  150,  151,  152,  154,  156,  153,  155,  158,  157,
+      159,  162,  160,  161,  163,  165,    5,    5,  164,    5,
+      166,  167,    5,  171,    5,  177,    5,  168,  175,  170,
+      169,  179,    5,  174,    5,    5,    5,    5,    5,  176,
+      173,  183,  172,  182,  180,    5,  178,  181,  187,  195,
+      184,  185,  188,  186,  198,  190,    5,  191,  189,  197,
+        5,    5,    5,  193,  194,  192,  201,  199,  205,  204,
+
+      206,  196,    5,  208,  209,  210,    5,  200,    5,    5,
+      202,    5,  203,  211,    5,  215,  207,  212,  214,  213,
+      217,    5,  216,  219,  218,    5,  220,    5,    5,  222,
+      221,    5,    5,    5,  223,    5,  226,  224,    5,    5,
+      225,    5,  227,    5,    5,  229,  233,    5,  228,    5,
+      232,  234,  236,  235,    5,  237,  239,  240,  230,  241,
+      238,  246,  244,  231,  251,  242,  247,    5,  243,    5,
+        5,    0,    5,    0,  255,  245,  248,    0,  253,  249,
+      250,    0,    0,  252,    0,    0,  254,  261,  262,  256,
+        0,  258,  259,  257,  260,  263,  264,  265,  268,  266,
+
+        0,  267,    0,    0,  269,    5,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270
     } ;
 
-static const flex_int16_t yy_chk[508] =
+static const flex_int16_t yy_chk[552] =
     {   0,
+        0,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,   13,   18,
-       15,   13,   15,   16,   16,   20,   19,   21,   22,   26,
-       23,   18,   20,  224,   24,   20,   18,   30,   22,   18,
-       21,   23,   27,  186,   25,   18,   19,   23,   25,   31,
-
-      181,   20,   19,   21,   22,   26,   23,   18,   20,   24,
-       20,   18,   30,   22,   18,   21,   33,   23,   27,   29,
-       25,   19,   23,   32,   25,   31,   32,   29,   34,   35,
-       36,   51,   43,   33,   43,   52,   53,   87,   32,   32,
-       54,   55,   33,   57,   59,   29,   68,   61,   62,   32,
-       63,   58,   32,   29,   34,   35,   36,   51,   33,   58,
-       64,   52,   53,   32,   32,   60,   54,   55,   65,   57,
-       59,   68,   60,   61,   62,   66,   63,   58,   67,   69,
-       70,   71,   46,   72,   58,   73,   64,   74,   75,   77,
-       76,   60,   78,   79,   65,   70,   70,   60,   76,   80,
-
-       82,   66,   81,   83,   67,   69,   70,   71,   72,   84,
-       92,   73,   88,   74,   75,   77,   76,   93,   78,   79,
-       70,   70,   94,   76,   95,   80,   82,   81,   96,   83,
-       97,   98,   99,  100,  103,   84,   92,   88,  101,  102,
-      104,  106,   93,  105,  107,  108,  109,  110,   94,  111,
-       95,  114,  115,  116,   96,  118,   97,   98,   99,  100,
-      103,  119,  121,  101,  102,  122,  104,  106,  105,  123,
-      107,  108,  109,  110,  124,  111,  125,  114,  115,  116,
-      118,  126,  127,  129,   41,  130,  119,  131,  121,  132,
-      135,  122,  137,   39,  138,  123,  140,  141,  148,  124,
-
-      143,  125,  144,  147,  149,  151,  126,  152,  127,  129,
-      130,  154,  131,  155,  132,  156,  135,  159,  137,  138,
-      161,  162,  140,  141,  148,  143,  163,  144,  147,  167,
-      149,  151,  169,  152,  171,  173,  154,  172,  174,  155,
-      175,  156,  159,  176,  184,  190,  161,  162,  191,   38,
-      190,  192,  163,  193,  194,  167,  196,  169,  197,  198,
-      171,  173,  172,  174,  199,  202,  175,  200,  176,  201,
-      184,  190,  203,  204,  191,  190,  205,  192,  206,  193,
-      194,  207,  196,  197,  198,  208,  209,   17,  210,  211,
-      199,  202,  200,  212,  201,  213,  214,  216,  203,  204,
-
-      217,   14,  205,  219,  206,   12,   10,  207,    9,    7,
-        5,  208,  209,  210,    4,  211,    3,    0,    0,  212,
-        0,  213,  214,  216,    0,    0,  217,    0,  219,  222,
-      222,  222,  223,  223,  223,  225,    0,  225,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-      221,  221,  221,  221,  221,  221,  221,  221,  221,  221,
-
-      221,  221,  221,  221,  221,  221,  221
+        1,    1,    1,    1,    1,    1,    2,    7,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    4,    5,    9,   10,   10,   10,   10,
+
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   10,   10,   10,   10,   10,   10,   10,   10,   10,
+       10,   14,   16,   18,   19,   21,   21,   23,   24,   33,
+       35,   37,   33,   24,   24,   24,   24,   24,   24,   24,
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+       24,   24,   24,   24,   24,   24,   24,   24,   24,   24,
+       25,   26,   27,   25,   26,   30,   31,   28,   38,   32,
+       31,   26,   25,   34,   26,   27,   28,   25,   30,   32,
+
+       25,   26,   27,   25,   29,   44,   28,   28,   29,   36,
+       31,   40,   39,   34,   40,   29,   41,   36,   42,   43,
+       42,   29,   39,   47,   48,   50,   40,   40,   52,   55,
+       62,   53,   53,   41,   53,   53,   53,   53,   53,   53,
+       53,   53,   53,   53,   53,   53,   53,   53,   53,   53,
+       53,   53,   53,   53,   53,   53,   53,   53,   53,   53,
+       53,   53,   53,   53,   53,   53,   53,   53,   53,   53,
+       53,   53,   53,   53,   53,   53,   59,   60,   61,   63,
+       64,   65,   66,   67,   68,   69,   70,   73,   79,   71,
+       75,   74,   81,   69,   72,   76,   71,   99,   84,   77,
+
+       78,   80,   82,   88,   85,   87,   86,   81,   81,   89,
+       90,   92,   83,   94,  101,   96,   93,   97,   90,   91,
+      102,   98,  104,  105,  106,  103,   95,   98,  107,  109,
+      108,  110,  111,  112,  114,  116,  113,  115,  118,  117,
+      119,  122,  120,  121,  123,  125,  127,  128,  124,  129,
+      126,  130,  135,  134,  138,  142,  148,  131,  140,  133,
+      132,  144,  153,  139,  154,  156,  159,  162,  165,  141,
+      137,  149,  136,  147,  145,  166,  143,  146,  155,  168,
+      150,  151,  157,  152,  171,  160,  172,  161,  158,  170,
+      175,  181,  182,  164,  167,  163,  174,  173,  179,  178,
+
+      180,  169,  184,  185,  186,  187,  188,  173,  189,  190,
+      176,  192,  177,  191,  194,  197,  183,  193,  196,  195,
+      199,  200,  198,  202,  201,  206,  203,  207,  208,  205,
+      204,  209,  211,  212,  210,  216,  215,  213,  218,  219,
+      214,  220,  217,  221,  224,  223,  226,  228,  222,  232,
+      225,  227,  230,  229,  233,  231,  235,  236,  223,  237,
+      234,  242,  240,  223,  247,  238,  243,  260,  239,  264,
+      267,    0,  269,    0,  251,  241,  244,    0,  249,  245,
+      246,    0,    0,  248,    0,    0,  250,  257,  258,  252,
+        0,  254,  255,  253,  256,  259,  261,  262,  266,  263,
+
+        0,  265,    0,    0,  268,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270
     } ;
 
 static yy_state_type yy_last_accepting_state;
@@ -677,9 +697,9 @@ char *yytext;
         } \
     }
 
-#line 681 "lex.yy.cpp"
+#line 701 "lex.yy.cpp"
 
-#line 683 "lex.yy.cpp"
+#line 703 "lex.yy.cpp"
 
 #define INITIAL 0
 #define STATE_COMMENT 1
@@ -917,7 +937,7 @@ YY_DECL
 
 #line 48 "lex.l"
     /* block comment */
-#line 921 "lex.yy.cpp"
+#line 941 "lex.yy.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -944,13 +964,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 222 )
+				if ( yy_current_state >= 271 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 439 );
+		while ( yy_base[yy_current_state] != 506 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1127,170 +1147,205 @@ YY_RULE_SETUP
 case 30:
 YY_RULE_SETUP
 #line 82 "lex.l"
-{ return FLOAT; }
+{ return VARCHAR; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
 #line 83 "lex.l"
-{ return INDEX; }
+{ return FLOAT; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
 #line 84 "lex.l"
-{ return AND; }
+{ return INDEX; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
 #line 85 "lex.l"
-{return JOIN;}
+{ return AND; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
 #line 86 "lex.l"
-{ return EXIT; }
+{return JOIN;}
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
 #line 87 "lex.l"
-{ return HELP; }
+{ return EXIT; }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
 #line 88 "lex.l"
-{ return ORDER; }
+{ return HELP; }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
 #line 89 "lex.l"
-{  return BY;  }
+{ return ORDER; }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
 #line 90 "lex.l"
-{ return ASC; }
+{  return BY;  }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
 #line 91 "lex.l"
-{return STATIC_CHECKPOINT;}
+{ return ASC; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
 #line 92 "lex.l"
-{ return ENABLE_NESTLOOP; }
+{return STATIC_CHECKPOINT;}
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
 #line 93 "lex.l"
-{ return ENABLE_SORTMERGE; }
+{ return ENABLE_NESTLOOP; }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
 #line 94 "lex.l"
+{ return ENABLE_SORTMERGE; }
+	YY_BREAK
+case 43:
+YY_RULE_SETUP
+#line 95 "lex.l"
+{ return ENABLE_ASYNC_COMMIT; }
+	YY_BREAK
+case 44:
+YY_RULE_SETUP
+#line 96 "lex.l"
+{ return RECOVERY; }
+	YY_BREAK
+case 45:
+YY_RULE_SETUP
+#line 97 "lex.l"
+{ return STATS; }
+	YY_BREAK
+case 46:
+YY_RULE_SETUP
+#line 98 "lex.l"
+{ return PRIMARY; }
+	YY_BREAK
+case 47:
+YY_RULE_SETUP
+#line 99 "lex.l"
+{ return KEY; }
+	YY_BREAK
+case 48:
+YY_RULE_SETUP
+#line 100 "lex.l"
+{ return UNIQUE; }
+	YY_BREAK
+case 49:
+YY_RULE_SETUP
+#line 101 "lex.l"
 { 
     yylval->sv_bool = true;
     return VALUE_BOOL; 
 }
 	YY_BREAK
-case 43:
+case 50:
 YY_RULE_SETUP
-#line 98 "lex.l"
+#line 105 "lex.l"
 {
     yylval->sv_bool = false;
     return VALUE_BOOL;
 }
 	YY_BREAK
-case 44:
+case 51:
 YY_RULE_SETUP
-#line 103 "lex.l"
+#line 110 "lex.l"
 { return SUM; }
 	YY_BREAK
-case 45:
+case 52:
 YY_RULE_SETUP
-#line 104 "lex.l"
+#line 111 "lex.l"
 { return AVG; }
 	YY_BREAK
-case 46:
+case 53:
 YY_RULE_SETUP
-#line 105 "lex.l"
+#line 112 "lex.l"
 { return MIN; }
 	YY_BREAK
-case 47:
+case 54:
 YY_RULE_SETUP
-#line 106 "lex.l"
+#line 113 "lex.l"
 { return MAX; }
 	YY_BREAK
-case 48:
+case 55:
 YY_RULE_SETUP
-#line 107 "lex.l"
+#line 114 "lex.l"
 { return COUNT; }
 	YY_BREAK
-case 49:
+case 56:
 YY_RULE_SETUP
-#line 109 "lex.l"
+#line 116 "lex.l"
 { return IN; }
 	YY_BREAK
-case 50:
+case 57:
 YY_RULE_SETUP
-#line 111 "lex.l"
+#line 118 "lex.l"
 { return GROUP; }
 	YY_BREAK
-case 51:
+case 58:
 YY_RULE_SETUP
-#line 112 "lex.l"
+#line 119 "lex.l"
 { return HAVING; }
 	YY_BREAK
 /* operators */
-case 52:
+case 59:
 YY_RULE_SETUP
-#line 115 "lex.l"
+#line 122 "lex.l"
 { return GEQ; }
 	YY_BREAK
-case 53:
+case 60:
 YY_RULE_SETUP
-#line 116 "lex.l"
+#line 123 "lex.l"
 { return LEQ; }
 	YY_BREAK
-case 54:
+case 61:
 YY_RULE_SETUP
-#line 117 "lex.l"
+#line 124 "lex.l"
 { return NEQ; }
 	YY_BREAK
-case 55:
+case 62:
 YY_RULE_SETUP
-#line 119 "lex.l"
+#line 126 "lex.l"
 { return yytext[0]; }
 	YY_BREAK
 /* id */
-case 56:
+case 63:
 YY_RULE_SETUP
-#line 121 "lex.l"
+#line 128 "lex.l"
 {
     yylval->sv_str = yytext;
     return IDENTIFIER;
 }
 	YY_BREAK
 /* literals */
-case 57:
+case 64:
 YY_RULE_SETUP
-#line 126 "lex.l"
+#line 133 "lex.l"
 {
     yylval->sv_int = atoi(yytext);
     return VALUE_INT;
 }
 	YY_BREAK
-case 58:
+case 65:
 YY_RULE_SETUP
-#line 130 "lex.l"
+#line 137 "lex.l"
 {
     yylval->sv_float = atof(yytext);
     return VALUE_FLOAT;
 }
 	YY_BREAK
-case 59:
-/* rule 59 can match eol */
+case 66:
+/* rule 66 can match eol */
 YY_RULE_SETUP
-#line 134 "lex.l"
+#line 141 "lex.l"
 {
     yylval->sv_str = std::string(yytext + 1, strlen(yytext) - 2);
     return VALUE_STRING;
@@ -1299,21 +1354,21 @@ YY_RULE_SETUP
 /* EOF */
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(STATE_COMMENT):
-#line 139 "lex.l"
+#line 146 "lex.l"
 { return T_EOF; }
 	YY_BREAK
 /* unexpected char */
-case 60:
+case 67:
 YY_RULE_SETUP
-#line 141 "lex.l"
+#line 148 "lex.l"
 { std::cerr << "Lexer Error: unexpected character " << yytext[0] << std::endl; }
 	YY_BREAK
-case 61:
+case 68:
 YY_RULE_SETUP
-#line 142 "lex.l"
+#line 149 "lex.l"
 ECHO;
 	YY_BREAK
-#line 1317 "lex.yy.cpp"
+#line 1372 "lex.yy.cpp"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -1608,7 +1663,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 222 )
+			if ( yy_current_state >= 271 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
@@ -1636,11 +1691,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 222 )
+		if ( yy_current_state >= 271 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 221);
+	yy_is_jam = (yy_current_state == 270);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2279,6 +2334,6 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 142 "lex.l"
+#line 149 "lex.l"
 
 
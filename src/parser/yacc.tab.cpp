@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,7 +67,7 @@
 
 
 /* First part of user prologue.  */
-#line 1 "yacc.y"
+#line 1 "/root/repo/src/parser/yacc.y"
 
 #include "ast.h"
 #include "yacc.tab.h"
@@ -81,7 +82,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 
 using namespace ast;
 
-#line 85 "yacc.tab.cpp"
+#line 86 "/root/repo/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -104,107 +105,126 @@ using namespace ast;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_YACC_TAB_H_INCLUDED
-# define YY_YY_YACC_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SHOW = 258,
-    TABLES = 259,
-    CREATE = 260,
-    TABLE = 261,
-    DROP = 262,
-    DESC = 263,
-    INSERT = 264,
-    INTO = 265,
-    VALUES = 266,
-    DELETE = 267,
-    FROM = 268,
-    ASC = 269,
-    ORDER = 270,
-    BY = 271,
-    WHERE = 272,
-    UPDATE = 273,
-    SET = 274,
-    SELECT = 275,
-    INT = 276,
-    CHAR = 277,
-    FLOAT = 278,
-    INDEX = 279,
-    AND = 280,
-    JOIN = 281,
-    EXIT = 282,
-    HELP = 283,
-    TXN_BEGIN = 284,
-    TXN_COMMIT = 285,
-    TXN_ABORT = 286,
-    TXN_ROLLBACK = 287,
-    ENABLE_NESTLOOP = 288,
-    ENABLE_SORTMERGE = 289,
-    IN = 290,
-    AS = 291,
-    LEQ = 292,
-    NEQ = 293,
-    GEQ = 294,
-    T_EOF = 295,
-    COUNT = 296,
-    SUM = 297,
-    AVG = 298,
-    MIN = 299,
-    MAX = 300,
-    GROUP = 301,
-    HAVING = 302,
-    STATIC_CHECKPOINT = 303,
-    IDENTIFIER = 304,
-    VALUE_STRING = 305,
-    OP_IN = 306,
-    VALUE_INT = 307,
-    VALUE_FLOAT = 308,
-    VALUE_BOOL = 309
-  };
-#endif
-
-/* Value type.  */
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SHOW = 3,                       /* SHOW  */
+  YYSYMBOL_TABLES = 4,                     /* TABLES  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_TABLE = 6,                      /* TABLE  */
+  YYSYMBOL_DROP = 7,                       /* DROP  */
+  YYSYMBOL_DESC = 8,                       /* DESC  */
+  YYSYMBOL_INSERT = 9,                     /* INSERT  */
+  YYSYMBOL_INTO = 10,                      /* INTO  */
+  YYSYMBOL_VALUES = 11,                    /* VALUES  */
+  YYSYMBOL_DELETE = 12,                    /* DELETE  */
+  YYSYMBOL_FROM = 13,                      /* FROM  */
+  YYSYMBOL_ASC = 14,                       /* ASC  */
+  YYSYMBOL_ORDER = 15,                     /* ORDER  */
+  YYSYMBOL_BY = 16,                        /* BY  */
+  YYSYMBOL_WHERE = 17,                     /* WHERE  */
+  YYSYMBOL_UPDATE = 18,                    /* UPDATE  */
+  YYSYMBOL_SET = 19,                       /* SET  */
+  YYSYMBOL_SELECT = 20,                    /* SELECT  */
+  YYSYMBOL_INT = 21,                       /* INT  */
+  YYSYMBOL_CHAR = 22,                      /* CHAR  */
+  YYSYMBOL_VARCHAR = 23,                   /* VARCHAR  */
+  YYSYMBOL_FLOAT = 24,                     /* FLOAT  */
+  YYSYMBOL_INDEX = 25,                     /* INDEX  */
+  YYSYMBOL_AND = 26,                       /* AND  */
+  YYSYMBOL_JOIN = 27,                      /* JOIN  */
+  YYSYMBOL_EXIT = 28,                      /* EXIT  */
+  YYSYMBOL_HELP = 29,                      /* HELP  */
+  YYSYMBOL_TXN_BEGIN = 30,                 /* TXN_BEGIN  */
+  YYSYMBOL_TXN_COMMIT = 31,                /* TXN_COMMIT  */
+  YYSYMBOL_TXN_ABORT = 32,                 /* TXN_ABORT  */
+  YYSYMBOL_TXN_ROLLBACK = 33,              /* TXN_ROLLBACK  */
+  YYSYMBOL_ENABLE_NESTLOOP = 34,           /* ENABLE_NESTLOOP  */
+  YYSYMBOL_ENABLE_SORTMERGE = 35,          /* ENABLE_SORTMERGE  */
+  YYSYMBOL_ENABLE_ASYNC_COMMIT = 36,       /* ENABLE_ASYNC_COMMIT  */
+  YYSYMBOL_RECOVERY = 37,                  /* RECOVERY  */
+  YYSYMBOL_STATS = 38,                     /* STATS  */
+  YYSYMBOL_PRIMARY = 39,                   /* PRIMARY  */
+  YYSYMBOL_KEY = 40,                       /* KEY  */
+  YYSYMBOL_UNIQUE = 41,                    /* UNIQUE  */
+  YYSYMBOL_IN = 42,                        /* IN  */
+  YYSYMBOL_AS = 43,                        /* AS  */
+  YYSYMBOL_LEQ = 44,                       /* LEQ  */
+  YYSYMBOL_NEQ = 45,                       /* NEQ  */
+  YYSYMBOL_GEQ = 46,                       /* GEQ  */
+  YYSYMBOL_T_EOF = 47,                     /* T_EOF  */
+  YYSYMBOL_COUNT = 48,                     /* COUNT  */
+  YYSYMBOL_SUM = 49,                       /* SUM  */
+  YYSYMBOL_AVG = 50,                       /* AVG  */
+  YYSYMBOL_MIN = 51,                       /* MIN  */
+  YYSYMBOL_MAX = 52,                       /* MAX  */
+  YYSYMBOL_GROUP = 53,                     /* GROUP  */
+  YYSYMBOL_HAVING = 54,                    /* HAVING  */
+  YYSYMBOL_STATIC_CHECKPOINT = 55,         /* STATIC_CHECKPOINT  */
+  YYSYMBOL_IDENTIFIER = 56,                /* IDENTIFIER  */
+  YYSYMBOL_VALUE_STRING = 57,              /* VALUE_STRING  */
+  YYSYMBOL_OP_IN = 58,                     /* OP_IN  */
+  YYSYMBOL_VALUE_INT = 59,                 /* VALUE_INT  */
+  YYSYMBOL_VALUE_FLOAT = 60,               /* VALUE_FLOAT  */
+  YYSYMBOL_VALUE_BOOL = 61,                /* VALUE_BOOL  */
+  YYSYMBOL_62_ = 62,                       /* ';'  */
+  YYSYMBOL_63_ = 63,                       /* '='  */
+  YYSYMBOL_64_ = 64,                       /* '('  */
+  YYSYMBOL_65_ = 65,                       /* ')'  */
+  YYSYMBOL_66_ = 66,                       /* ','  */
+  YYSYMBOL_67_ = 67,                       /* '.'  */
+  YYSYMBOL_68_ = 68,                       /* '<'  */
+  YYSYMBOL_69_ = 69,                       /* '>'  */
+  YYSYMBOL_70_ = 70,                       /* '*'  */
+  YYSYMBOL_YYACCEPT = 71,                  /* $accept  */
+  YYSYMBOL_start = 72,                     /* start  */
+  YYSYMBOL_stmt = 73,                      /* stmt  */
+  YYSYMBOL_static_checkpoint = 74,         /* static_checkpoint  */
+  YYSYMBOL_txnStmt = 75,                   /* txnStmt  */
+  YYSYMBOL_dbStmt = 76,                    /* dbStmt  */
+  YYSYMBOL_setStmt = 77,                   /* setStmt  */
+  YYSYMBOL_ddl = 78,                       /* ddl  */
+  YYSYMBOL_dml = 79,                       /* dml  */
+  YYSYMBOL_subquery = 80,                  /* subquery  */
+  YYSYMBOL_fieldList = 81,                 /* fieldList  */
+  YYSYMBOL_colNameList = 82,               /* colNameList  */
+  YYSYMBOL_field = 83,                     /* field  */
+  YYSYMBOL_keyType = 84,                   /* keyType  */
+  YYSYMBOL_type = 85,                      /* type  */
+  YYSYMBOL_valueList = 86,                 /* valueList  */
+  YYSYMBOL_value = 87,                     /* value  */
+  YYSYMBOL_condition = 88,                 /* condition  */
+  YYSYMBOL_optWhereClause = 89,            /* optWhereClause  */
+  YYSYMBOL_whereClause = 90,               /* whereClause  */
+  YYSYMBOL_col = 91,                       /* col  */
+  YYSYMBOL_colList = 92,                   /* colList  */
+  YYSYMBOL_col_with_alias = 93,            /* col_with_alias  */
+  YYSYMBOL_op = 94,                        /* op  */
+  YYSYMBOL_expr = 95,                      /* expr  */
+  YYSYMBOL_opt_as_alias = 96,              /* opt_as_alias  */
+  YYSYMBOL_aggregate_expr = 97,            /* aggregate_expr  */
+  YYSYMBOL_setClauses = 98,                /* setClauses  */
+  YYSYMBOL_setClause = 99,                 /* setClause  */
+  YYSYMBOL_selector = 100,                 /* selector  */
+  YYSYMBOL_selector_item = 101,            /* selector_item  */
+  YYSYMBOL_tableList = 102,                /* tableList  */
+  YYSYMBOL_opt_order_clause = 103,         /* opt_order_clause  */
+  YYSYMBOL_order_clause = 104,             /* order_clause  */
+  YYSYMBOL_opt_asc_desc = 105,             /* opt_asc_desc  */
+  YYSYMBOL_opt_group_clause = 106,         /* opt_group_clause  */
+  YYSYMBOL_group_clause = 107,             /* group_clause  */
+  YYSYMBOL_opt_having_clause = 108,        /* opt_having_clause  */
+  YYSYMBOL_set_knob_type = 109,            /* set_knob_type  */
+  YYSYMBOL_tbName = 110,                   /* tbName  */
+  YYSYMBOL_colName = 111                   /* colName  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
-
-
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-int yyparse (void);
-
-#endif /* !YY_YY_YACC_TAB_H_INCLUDED  */
 
 
 
@@ -245,6 +265,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -304,6 +336,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -322,6 +355,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -340,17 +374,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -379,7 +419,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -444,8 +484,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -511,27 +550,29 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  54
+#define YYFINAL  56
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   212
+#define YYLAST   233
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  64
+#define YYNTOKENS  71
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  40
+#define YYNNTS  41
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  101
+#define YYNRULES  108
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  204
+#define YYNSTATES  219
 
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   309
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   316
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -541,9 +582,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      57,    58,    63,     2,    59,     2,    60,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    55,
-      61,    56,    62,     2,     2,     2,     2,     2,     2,     2,
+      64,    65,    70,     2,    66,     2,    67,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    62,
+      68,    63,    69,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -567,274 +608,284 @@ static const yytype_int8 yytranslate[] =
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    48,    49,    50,    51,    52,    53,    54
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    70,    70,    75,    80,    85,    93,    94,    95,    96,
-      97,    98,   102,   108,   112,   116,   120,   127,   131,   138,
-     145,   149,   153,   157,   161,   168,   172,   176,   180,   187,
-     196,   200,   207,   211,   218,   225,   229,   233,   240,   244,
-     251,   255,   259,   263,   270,   274,   278,   282,   286,   290,
-     297,   298,   305,   309,   316,   320,   327,   331,   337,   341,
-     361,   365,   369,   373,   377,   381,   388,   392,   399,   403,
-     407,   411,   415,   419,   423,   427,   445,   449,   456,   463,
-     467,   471,   479,   483,   490,   494,   498,   506,   510,   514,
-     521,   522,   523,   529,   533,   537,   544,   549,   555,   556,
-     559,   561
+       0,    71,    71,    76,    81,    86,    94,    95,    96,    97,
+      98,    99,   103,   109,   113,   117,   121,   128,   132,   136,
+     143,   150,   154,   158,   162,   166,   173,   177,   181,   185,
+     192,   201,   205,   212,   216,   223,   227,   231,   238,   242,
+     249,   253,   257,   261,   268,   272,   279,   283,   287,   291,
+     298,   302,   306,   310,   314,   318,   325,   326,   333,   337,
+     344,   348,   355,   359,   365,   369,   389,   393,   397,   401,
+     405,   409,   416,   420,   427,   431,   435,   439,   443,   447,
+     451,   455,   473,   477,   484,   491,   495,   499,   507,   511,
+     518,   522,   526,   534,   538,   542,   549,   550,   551,   557,
+     561,   565,   572,   577,   583,   584,   585,   588,   590
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SHOW", "TABLES", "CREATE", "TABLE",
-  "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE", "FROM", "ASC",
-  "ORDER", "BY", "WHERE", "UPDATE", "SET", "SELECT", "INT", "CHAR",
-  "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP", "TXN_BEGIN",
-  "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK", "ENABLE_NESTLOOP",
-  "ENABLE_SORTMERGE", "IN", "AS", "LEQ", "NEQ", "GEQ", "T_EOF", "COUNT",
-  "SUM", "AVG", "MIN", "MAX", "GROUP", "HAVING", "STATIC_CHECKPOINT",
-  "IDENTIFIER", "VALUE_STRING", "OP_IN", "VALUE_INT", "VALUE_FLOAT",
-  "VALUE_BOOL", "';'", "'='", "'('", "')'", "','", "'.'", "'<'", "'>'",
-  "'*'", "$accept", "start", "stmt", "static_checkpoint", "txnStmt",
-  "dbStmt", "setStmt", "ddl", "dml", "subquery", "fieldList",
-  "colNameList", "field", "type", "valueList", "value", "condition",
-  "optWhereClause", "whereClause", "col", "colList", "col_with_alias",
-  "op", "expr", "opt_as_alias", "aggregate_expr", "setClauses",
-  "setClause", "selector", "selector_item", "tableList",
+  "\"end of file\"", "error", "\"invalid token\"", "SHOW", "TABLES",
+  "CREATE", "TABLE", "DROP", "DESC", "INSERT", "INTO", "VALUES", "DELETE",
+  "FROM", "ASC", "ORDER", "BY", "WHERE", "UPDATE", "SET", "SELECT", "INT",
+  "CHAR", "VARCHAR", "FLOAT", "INDEX", "AND", "JOIN", "EXIT", "HELP",
+  "TXN_BEGIN", "TXN_COMMIT", "TXN_ABORT", "TXN_ROLLBACK",
+  "ENABLE_NESTLOOP", "ENABLE_SORTMERGE", "ENABLE_ASYNC_COMMIT", "RECOVERY",
+  "STATS", "PRIMARY", "KEY", "UNIQUE", "IN", "AS", "LEQ", "NEQ", "GEQ",
+  "T_EOF", "COUNT", "SUM", "AVG", "MIN", "MAX", "GROUP", "HAVING",
+  "STATIC_CHECKPOINT", "IDENTIFIER", "VALUE_STRING", "OP_IN", "VALUE_INT",
+  "VALUE_FLOAT", "VALUE_BOOL", "';'", "'='", "'('", "')'", "','", "'.'",
+  "'<'", "'>'", "'*'", "$accept", "start", "stmt", "static_checkpoint",
+  "txnStmt", "dbStmt", "setStmt", "ddl", "dml", "subquery", "fieldList",
+  "colNameList", "field", "keyType", "type", "valueList", "value",
+  "condition", "optWhereClause", "whereClause", "col", "colList",
+  "col_with_alias", "op", "expr", "opt_as_alias", "aggregate_expr",
+  "setClauses", "setClause", "selector", "selector_item", "tableList",
   "opt_order_clause", "order_clause", "opt_asc_desc", "opt_group_clause",
   "group_clause", "opt_having_clause", "set_knob_type", "tbName",
   "colName", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,    59,    61,    40,    41,    44,
-      46,    60,    62,    42
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-100)
+#define YYPACT_NINF (-106)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-101)
+#define YYTABLE_NINF (-108)
 
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      75,    18,     9,    23,   -35,     6,     8,   -35,    33,    83,
-    -100,  -100,  -100,  -100,  -100,  -100,  -100,    30,   -18,  -100,
-    -100,  -100,  -100,  -100,  -100,  -100,    28,   -35,   -35,  -100,
-     -35,   -35,  -100,  -100,   -35,   -35,    25,  -100,  -100,     5,
-       7,    20,    24,    31,    34,    51,  -100,    49,  -100,  -100,
-      -1,  -100,    52,  -100,  -100,  -100,   -35,    72,    74,  -100,
-      85,   128,   137,    96,   116,     2,    -4,    -4,    -4,    -4,
-     108,   -35,   123,    96,  -100,    96,    96,    96,   114,   106,
-    -100,  -100,     1,  -100,   125,  -100,  -100,  -100,  -100,  -100,
-     121,  -100,  -100,   126,   127,   129,   130,   131,  -100,    17,
-    -100,  -100,  -100,    38,  -100,    78,    50,  -100,    94,    21,
-     163,    82,  -100,   161,    79,    82,    96,  -100,    21,   154,
-     154,   154,   154,   154,   154,   -35,   -35,   145,  -100,    96,
-    -100,   135,  -100,  -100,  -100,    96,  -100,   103,  -100,    83,
-    -100,  -100,  -100,  -100,  -100,  -100,    -4,   106,   136,   106,
-      -4,  -100,  -100,   146,  -100,  -100,  -100,  -100,  -100,  -100,
-    -100,  -100,   178,   181,  -100,   147,  -100,  -100,    21,     0,
-    -100,  -100,  -100,  -100,  -100,  -100,  -100,  -100,   148,   182,
-    -100,   142,  -100,   -35,  -100,   -24,  -100,   148,  -100,    17,
-     106,   148,  -100,     3,  -100,   145,   161,  -100,  -100,  -100,
-    -100,   181,   143,  -100
+     112,    17,     9,    32,   -40,    26,    43,   -40,    78,    98,
+    -106,  -106,  -106,  -106,  -106,  -106,  -106,    31,    44,  -106,
+    -106,  -106,  -106,  -106,  -106,  -106,    69,    70,   -40,   -40,
+    -106,   -40,   -40,  -106,  -106,   -40,   -40,    92,  -106,  -106,
+    -106,    53,    54,    59,    71,    87,    94,    93,  -106,   124,
+    -106,  -106,    -1,  -106,   104,  -106,  -106,  -106,   -40,  -106,
+     116,   120,  -106,   121,   175,   170,   132,   128,    96,    77,
+      77,    77,    77,   134,   -40,    51,   132,  -106,     7,   132,
+     132,   127,   113,  -106,  -106,     6,  -106,   130,  -106,  -106,
+    -106,  -106,  -106,   131,  -106,  -106,   133,   135,   136,   137,
+     138,  -106,    18,  -106,  -106,  -106,   155,  -106,   -22,  -106,
+     140,    67,   -13,  -106,    28,    20,   179,    41,  -106,   180,
+       5,    41,   132,  -106,    20,   162,   162,   162,   162,   162,
+     162,   -40,   -40,   154,  -106,  -106,     7,   132,  -106,   144,
+     145,  -106,   -17,  -106,   132,  -106,    61,  -106,    98,  -106,
+    -106,  -106,  -106,  -106,  -106,    77,   113,   146,   113,    77,
+    -106,  -106,   156,  -106,  -106,  -106,  -106,  -106,  -106,  -106,
+    -106,   195,   198,  -106,   110,   157,   158,  -106,  -106,  -106,
+      20,     1,  -106,  -106,  -106,  -106,  -106,  -106,  -106,  -106,
+     159,   202,  -106,  -106,   149,   160,  -106,   -40,  -106,   -36,
+    -106,   159,  -106,  -106,    18,   113,   159,  -106,     3,  -106,
+     154,   180,  -106,  -106,  -106,  -106,   198,   161,  -106
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        4,     3,    13,    14,    15,    16,     5,     0,     0,    11,
-       9,     6,    10,     7,     8,    17,     0,     0,     0,    12,
-       0,     0,   100,    22,     0,     0,     0,    98,    99,     0,
-       0,     0,     0,     0,     0,   101,    79,    59,    82,    83,
-       0,    80,     0,    55,     1,     2,     0,     0,     0,    21,
-       0,     0,    50,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    18,     0,     0,     0,     0,     0,
-      26,   101,    50,    76,     0,    19,    42,    40,    41,    43,
-       0,    66,    67,     0,     0,     0,     0,     0,    58,    50,
-      84,    81,    54,     0,    30,     0,     0,    32,     0,     0,
-       0,     0,    52,    51,     0,     0,     0,    27,     0,    69,
-      69,    69,    69,    69,    69,     0,     0,    94,    20,     0,
-      35,     0,    37,    34,    23,     0,    24,     0,    38,     0,
-      64,    63,    65,    60,    61,    62,     0,     0,     0,     0,
-       0,    77,    78,     0,    70,    71,    72,    73,    74,    75,
-      86,    85,     0,    88,    31,     0,    33,    25,     0,     0,
-      48,    53,    49,    47,    44,    46,    45,    68,     0,     0,
-      28,     0,    39,     0,    56,    97,    93,     0,    36,    50,
-       0,     0,    95,    92,    87,    94,    96,    57,    91,    90,
-      89,    88,     0,    29
+       9,     6,    10,     7,     8,    17,     0,     0,     0,     0,
+      12,     0,     0,   107,    23,     0,     0,     0,   104,   105,
+     106,     0,     0,     0,     0,     0,     0,   108,    85,    65,
+      88,    89,     0,    86,     0,    61,     1,     2,     0,    19,
+       0,     0,    22,     0,     0,    56,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    18,     0,     0,
+       0,     0,     0,    27,   108,    56,    82,     0,    20,    48,
+      46,    47,    49,     0,    72,    73,     0,     0,     0,     0,
+       0,    64,    56,    90,    87,    60,     0,    39,     0,    31,
+       0,     0,     0,    33,     0,     0,     0,     0,    58,    57,
+       0,     0,     0,    28,     0,    75,    75,    75,    75,    75,
+      75,     0,     0,   100,    38,    21,     0,     0,    40,     0,
+       0,    43,    35,    24,     0,    25,     0,    44,     0,    70,
+      69,    71,    66,    67,    68,     0,     0,     0,     0,     0,
+      83,    84,     0,    76,    77,    78,    79,    80,    81,    92,
+      91,     0,    94,    32,     0,     0,     0,    36,    34,    26,
+       0,     0,    54,    59,    55,    53,    50,    52,    51,    74,
+       0,     0,    29,    37,     0,     0,    45,     0,    62,   103,
+      99,     0,    41,    42,    56,     0,     0,   101,    98,    93,
+     100,   102,    63,    97,    96,    95,    94,     0,    30
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -100,  -100,  -100,  -100,  -100,  -100,  -100,  -100,  -100,   -15,
-    -100,   132,    73,  -100,  -100,   -99,    56,   -79,    14,    -9,
-      19,  -100,    22,   -60,    53,   -77,  -100,    89,    68,   138,
-      29,    10,  -100,  -100,    13,  -100,  -100,  -100,    -3,   -37
+    -106,  -106,  -106,  -106,  -106,  -106,  -106,  -106,  -106,    21,
+    -106,   -67,    83,    79,  -106,  -106,  -105,    64,   -82,    19,
+      -9,    22,  -106,    62,   -63,   -68,   -80,  -106,   100,    80,
+     152,    33,    13,  -106,  -106,    23,  -106,  -106,  -106,    -3,
+     -39
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    17,    18,    19,    20,    21,    22,    23,    24,   111,
-     103,   106,   104,   133,   137,    91,   112,    80,   113,    92,
-     185,    48,   146,   114,   154,    49,    82,    83,    50,    51,
-      99,   180,   194,   200,   163,   186,   192,    39,    52,    53
+       0,    17,    18,    19,    20,    21,    22,    23,    24,   117,
+     108,   112,   109,   110,   142,   146,    94,   118,    83,   119,
+      95,   199,    50,   155,   120,   163,    51,    85,    86,    52,
+      53,   102,   192,   209,   215,   172,   200,   207,    41,    54,
+      55
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      47,    33,   115,   117,    36,    93,    94,    95,    96,    97,
-     138,   198,    71,   183,    32,    27,    34,   199,    79,   152,
-     127,    35,    25,   190,    57,    58,    84,    59,    60,    30,
-      54,    61,    62,    28,    79,   191,   102,    55,   105,   107,
-     107,    56,    26,   125,    63,    45,    86,    31,    87,    88,
-      89,    45,    86,    74,    87,    88,    89,    29,    72,    72,
-     116,    64,   191,    47,    65,    90,    37,    38,   100,   182,
-     115,    86,   175,    87,    88,    89,   126,    66,     1,    84,
-       2,    67,     3,     4,     5,    70,   170,     6,    68,   174,
-     176,    69,   105,     7,     8,     9,   128,   129,   166,   130,
-     131,   132,    10,    11,    12,    13,    14,    15,   134,   135,
-     195,  -100,    73,   115,   148,    16,   140,   141,   142,   140,
-     141,   142,   160,   161,    40,    41,    42,    43,    44,    75,
-      47,    76,    45,   172,   173,   143,   149,   150,   143,    78,
-     144,   145,    77,   144,   145,    81,    46,    40,    41,    42,
-      43,    44,   136,   135,    79,    45,    86,    98,    87,    88,
-      89,   167,   168,   110,    40,    41,    42,    43,    44,   184,
-      85,   109,    45,   155,   156,   157,   158,   159,   184,   119,
-     100,   118,   197,   139,   120,   121,   147,   122,   123,   124,
-     153,   162,   165,   110,   178,   177,   179,    45,   187,   181,
-     188,   203,   164,   171,   196,   151,   193,   169,   201,   108,
-     101,   202,   189
+      49,    34,   121,   123,    37,    96,    97,    98,    99,   100,
+     147,   213,    74,   114,   197,    28,    33,   214,   205,   161,
+     133,    25,   106,    82,   107,    60,    61,    87,    62,    63,
+     206,    56,    64,    65,    29,    82,    35,   105,    31,   111,
+     113,   113,    26,   135,   136,   131,   106,   157,   107,   149,
+     150,   151,   143,   144,    27,    77,    36,    32,   164,   165,
+     166,   167,   168,    84,    30,    75,    49,    75,   152,   206,
+     174,   103,   122,   153,   154,   196,   121,    89,   187,    90,
+      91,    92,    58,    87,   132,   149,   150,   151,   138,   139,
+     140,   141,   182,   145,   144,   186,   188,   111,   113,    42,
+      43,    44,    45,    46,   152,   178,    57,    47,    59,   153,
+     154,    66,    38,    39,    40,     1,    67,     2,    68,     3,
+       4,     5,   210,    69,     6,   121,   179,   180,   169,   170,
+       7,     8,     9,    47,    89,    70,    90,    91,    92,    49,
+      10,    11,    12,    13,    14,    15,    42,    43,    44,    45,
+      46,    71,    47,    89,    47,    90,    91,    92,    72,    16,
+    -107,    42,    43,    44,    45,    46,    93,    73,    48,    47,
+      89,    76,    90,    91,    92,   193,   144,   116,   184,   185,
+      78,   198,   158,   159,    79,    80,    81,    82,    84,    88,
+     101,   115,   198,   124,   103,   134,   125,   212,   126,   148,
+     127,   128,   129,   130,   137,   162,   156,   171,   175,   176,
+     116,   190,   189,   191,   202,    47,   194,   195,   201,   173,
+     183,   177,   160,   208,   211,   203,   218,   104,   181,   217,
+     204,     0,     0,   216
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int16 yycheck[] =
 {
-       9,     4,    79,    82,     7,    65,    66,    67,    68,    69,
-     109,     8,    13,    13,    49,     6,    10,    14,    17,   118,
-      99,    13,     4,    47,    27,    28,    63,    30,    31,     6,
-       0,    34,    35,    24,    17,    59,    73,    55,    75,    76,
-      77,    13,    24,    26,    19,    49,    50,    24,    52,    53,
-      54,    49,    50,    56,    52,    53,    54,    48,    59,    59,
-      59,    56,    59,    72,    57,    63,    33,    34,    71,   168,
-     147,    50,   149,    52,    53,    54,    59,    57,     3,   116,
-       5,    57,     7,     8,     9,    36,   146,    12,    57,   149,
-     150,    57,   129,    18,    19,    20,    58,    59,   135,    21,
-      22,    23,    27,    28,    29,    30,    31,    32,    58,    59,
-     189,    60,    60,   190,    35,    40,    37,    38,    39,    37,
-      38,    39,   125,   126,    41,    42,    43,    44,    45,    57,
-     139,    57,    49,   148,   149,    56,   114,   115,    56,    11,
-      61,    62,    57,    61,    62,    49,    63,    41,    42,    43,
-      44,    45,    58,    59,    17,    49,    50,    49,    52,    53,
-      54,    58,    59,    57,    41,    42,    43,    44,    45,   178,
-      54,    57,    49,   120,   121,   122,   123,   124,   187,    58,
-     183,    56,   191,    20,    58,    58,    25,    58,    58,    58,
-      36,    46,    57,    57,    16,    49,    15,    49,    16,    52,
-      58,    58,   129,   147,   190,   116,   187,   139,   195,    77,
-      72,   201,   183
+       9,     4,    82,    85,     7,    68,    69,    70,    71,    72,
+     115,     8,    13,    80,    13,     6,    56,    14,    54,   124,
+     102,     4,    39,    17,    41,    28,    29,    66,    31,    32,
+      66,     0,    35,    36,    25,    17,    10,    76,     6,    78,
+      79,    80,    25,    65,    66,    27,    39,    42,    41,    44,
+      45,    46,    65,    66,    37,    58,    13,    25,   126,   127,
+     128,   129,   130,    56,    55,    66,    75,    66,    63,    66,
+     137,    74,    66,    68,    69,   180,   156,    57,   158,    59,
+      60,    61,    13,   122,    66,    44,    45,    46,    21,    22,
+      23,    24,   155,    65,    66,   158,   159,   136,   137,    48,
+      49,    50,    51,    52,    63,   144,    62,    56,    38,    68,
+      69,    19,    34,    35,    36,     3,    63,     5,    64,     7,
+       8,     9,   204,    64,    12,   205,    65,    66,   131,   132,
+      18,    19,    20,    56,    57,    64,    59,    60,    61,   148,
+      28,    29,    30,    31,    32,    33,    48,    49,    50,    51,
+      52,    64,    56,    57,    56,    59,    60,    61,    64,    47,
+      67,    48,    49,    50,    51,    52,    70,    43,    70,    56,
+      57,    67,    59,    60,    61,    65,    66,    64,   157,   158,
+      64,   190,   120,   121,    64,    64,    11,    17,    56,    61,
+      56,    64,   201,    63,   197,    40,    65,   206,    65,    20,
+      65,    65,    65,    65,    64,    43,    26,    53,    64,    64,
+      64,    16,    56,    15,    65,    56,    59,    59,    16,   136,
+     156,   142,   122,   201,   205,    65,    65,    75,   148,   216,
+     197,    -1,    -1,   210
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     3,     5,     7,     8,     9,    12,    18,    19,    20,
-      27,    28,    29,    30,    31,    32,    40,    65,    66,    67,
-      68,    69,    70,    71,    72,     4,    24,     6,    24,    48,
-       6,    24,    49,   102,    10,    13,   102,    33,    34,   101,
-      41,    42,    43,    44,    45,    49,    63,    83,    85,    89,
-      92,    93,   102,   103,     0,    55,    13,   102,   102,   102,
-     102,   102,   102,    19,    56,    57,    57,    57,    57,    57,
-      36,    13,    59,    60,   102,    57,    57,    57,    11,    17,
-      81,    49,    90,    91,   103,    54,    50,    52,    53,    54,
-      63,    79,    83,    87,    87,    87,    87,    87,    49,    94,
-     102,    93,   103,    74,    76,   103,    75,   103,    75,    57,
-      57,    73,    80,    82,    87,    89,    59,    81,    56,    58,
-      58,    58,    58,    58,    58,    26,    59,    81,    58,    59,
-      21,    22,    23,    77,    58,    59,    58,    78,    79,    20,
-      37,    38,    39,    56,    61,    62,    86,    25,    35,    86,
-      86,    91,    79,    36,    88,    88,    88,    88,    88,    88,
-     102,   102,    46,    98,    76,    57,   103,    58,    59,    92,
-      87,    80,    73,    73,    87,    89,    87,    49,    16,    15,
-      95,    52,    79,    13,    83,    84,    99,    16,    58,    94,
-      47,    59,   100,    84,    96,    81,    82,    83,     8,    14,
-      97,    98,    95,    58
+      28,    29,    30,    31,    32,    33,    47,    72,    73,    74,
+      75,    76,    77,    78,    79,     4,    25,    37,     6,    25,
+      55,     6,    25,    56,   110,    10,    13,   110,    34,    35,
+      36,   109,    48,    49,    50,    51,    52,    56,    70,    91,
+      93,    97,   100,   101,   110,   111,     0,    62,    13,    38,
+     110,   110,   110,   110,   110,   110,    19,    63,    64,    64,
+      64,    64,    64,    43,    13,    66,    67,   110,    64,    64,
+      64,    11,    17,    89,    56,    98,    99,   111,    61,    57,
+      59,    60,    61,    70,    87,    91,    95,    95,    95,    95,
+      95,    56,   102,   110,   101,   111,    39,    41,    81,    83,
+      84,   111,    82,   111,    82,    64,    64,    80,    88,    90,
+      95,    97,    66,    89,    63,    65,    65,    65,    65,    65,
+      65,    27,    66,    89,    40,    65,    66,    64,    21,    22,
+      23,    24,    85,    65,    66,    65,    86,    87,    20,    44,
+      45,    46,    63,    68,    69,    94,    26,    42,    94,    94,
+      99,    87,    43,    96,    96,    96,    96,    96,    96,   110,
+     110,    53,   106,    83,    82,    64,    64,    84,   111,    65,
+      66,   100,    95,    88,    80,    80,    95,    97,    95,    56,
+      16,    15,   103,    65,    59,    59,    87,    13,    91,    92,
+     107,    16,    65,    65,   102,    54,    66,   108,    92,   104,
+      89,    90,    91,     8,    14,   105,   106,   103,    65
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    64,    65,    65,    65,    65,    66,    66,    66,    66,
-      66,    66,    67,    68,    68,    68,    68,    69,    69,    70,
-      71,    71,    71,    71,    71,    72,    72,    72,    72,    73,
-      74,    74,    75,    75,    76,    77,    77,    77,    78,    78,
-      79,    79,    79,    79,    80,    80,    80,    80,    80,    80,
-      81,    81,    82,    82,    83,    83,    84,    84,    85,    85,
-      86,    86,    86,    86,    86,    86,    87,    87,    88,    88,
-      89,    89,    89,    89,    89,    89,    90,    90,    91,    92,
-      92,    92,    93,    93,    94,    94,    94,    95,    95,    96,
-      97,    97,    97,    98,    98,    99,   100,   100,   101,   101,
-     102,   103
+       0,    71,    72,    72,    72,    72,    73,    73,    73,    73,
+      73,    73,    74,    75,    75,    75,    75,    76,    76,    76,
+      77,    78,    78,    78,    78,    78,    79,    79,    79,    79,
+      80,    81,    81,    82,    82,    83,    83,    83,    84,    84,
+      85,    85,    85,    85,    86,    86,    87,    87,    87,    87,
+      88,    88,    88,    88,    88,    88,    89,    89,    90,    90,
+      91,    91,    92,    92,    93,    93,    94,    94,    94,    94,
+      94,    94,    95,    95,    96,    96,    97,    97,    97,    97,
+      97,    97,    98,    98,    99,   100,   100,   100,   101,   101,
+     102,   102,   102,   103,   103,   104,   105,   105,   105,   106,
+     106,   107,   108,   108,   109,   109,   109,   110,   111
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     2,     1,     1,     1,     1,     2,     4,     4,
-       6,     3,     2,     6,     6,     7,     4,     5,     7,     9,
-       1,     3,     1,     3,     2,     1,     4,     1,     1,     3,
-       1,     1,     1,     1,     3,     3,     3,     3,     3,     3,
-       0,     2,     1,     3,     3,     1,     1,     3,     3,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     2,     0,
-       5,     5,     5,     5,     5,     5,     1,     3,     3,     1,
-       1,     3,     1,     1,     1,     3,     3,     3,     0,     2,
-       1,     1,     0,     3,     0,     2,     2,     0,     1,     1,
-       1,     1
+       1,     1,     2,     1,     1,     1,     1,     2,     4,     3,
+       4,     6,     3,     2,     6,     6,     7,     4,     5,     7,
+       9,     1,     3,     1,     3,     2,     3,     4,     2,     1,
+       1,     4,     4,     1,     1,     3,     1,     1,     1,     1,
+       3,     3,     3,     3,     3,     3,     0,     2,     1,     3,
+       3,     1,     1,     3,     3,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     2,     0,     5,     5,     5,     5,
+       5,     5,     1,     3,     3,     1,     1,     3,     1,     1,
+       1,     3,     3,     3,     0,     2,     1,     1,     0,     3,
+       0,     2,     2,     0,     1,     1,     1,     1,     1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -856,10 +907,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -903,12 +953,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -936,24 +993,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -964,19 +1029,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -986,14 +1048,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -1026,7 +1089,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -1038,9 +1102,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1055,8 +1119,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1079,12 +1143,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1094,13 +1207,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1114,10 +1227,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1132,7 +1245,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1166,31 +1278,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1214,52 +1310,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1267,17 +1365,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1286,7 +1390,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1298,7 +1402,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1309,29 +1413,32 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1339,7 +1446,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 int
 yyparse (void)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1358,55 +1465,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1414,17 +1516,10 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1447,10 +1542,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1481,7 +1577,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1492,11 +1588,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1516,6 +1612,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1536,18 +1633,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1619,733 +1728,787 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 71 "yacc.y"
+  case 2: /* start: stmt ';'  */
+#line 72 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1629 "yacc.tab.cpp"
+#line 1738 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 3:
-#line 76 "yacc.y"
+  case 3: /* start: HELP  */
+#line 77 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1638 "yacc.tab.cpp"
+#line 1747 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 4:
-#line 81 "yacc.y"
+  case 4: /* start: EXIT  */
+#line 82 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1647 "yacc.tab.cpp"
+#line 1756 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 5:
-#line 86 "yacc.y"
+  case 5: /* start: T_EOF  */
+#line 87 "/root/repo/src/parser/yacc.y"
     {
         parse_tree = nullptr;
         YYACCEPT;
     }
-#line 1656 "yacc.tab.cpp"
+#line 1765 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 12:
-#line 103 "yacc.y"
+  case 12: /* static_checkpoint: CREATE STATIC_CHECKPOINT  */
+#line 104 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<StaticCheckpoint>();
     }
-#line 1664 "yacc.tab.cpp"
+#line 1773 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 13:
-#line 109 "yacc.y"
+  case 13: /* txnStmt: TXN_BEGIN  */
+#line 110 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1672 "yacc.tab.cpp"
+#line 1781 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 14:
-#line 113 "yacc.y"
+  case 14: /* txnStmt: TXN_COMMIT  */
+#line 114 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1680 "yacc.tab.cpp"
+#line 1789 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 15:
-#line 117 "yacc.y"
+  case 15: /* txnStmt: TXN_ABORT  */
+#line 118 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1688 "yacc.tab.cpp"
+#line 1797 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 16:
-#line 121 "yacc.y"
+  case 16: /* txnStmt: TXN_ROLLBACK  */
+#line 122 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1696 "yacc.tab.cpp"
+#line 1805 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 17:
-#line 128 "yacc.y"
+  case 17: /* dbStmt: SHOW TABLES  */
+#line 129 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1704 "yacc.tab.cpp"
+#line 1813 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 18:
-#line 132 "yacc.y"
+  case 18: /* dbStmt: SHOW INDEX FROM tbName  */
+#line 133 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowIndex>((yyvsp[0].sv_str));
     }
-#line 1712 "yacc.tab.cpp"
+#line 1821 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 19:
-#line 139 "yacc.y"
+  case 19: /* dbStmt: SHOW RECOVERY STATS  */
+#line 137 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_node) = std::make_shared<ShowRecoveryStats>();
+    }
+#line 1829 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 20: /* setStmt: SET set_knob_type '=' VALUE_BOOL  */
+#line 144 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SetStmt>((yyvsp[-2].sv_setKnobType), (yyvsp[0].sv_bool));
     }
-#line 1720 "yacc.tab.cpp"
+#line 1837 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 20:
-#line 146 "yacc.y"
+  case 21: /* ddl: CREATE TABLE tbName '(' fieldList ')'  */
+#line 151 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-3].sv_str), (yyvsp[-1].sv_fields));
     }
-#line 1728 "yacc.tab.cpp"
+#line 1845 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 21:
-#line 150 "yacc.y"
+  case 22: /* ddl: DROP TABLE tbName  */
+#line 155 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1736 "yacc.tab.cpp"
+#line 1853 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 22:
-#line 154 "yacc.y"
+  case 23: /* ddl: DESC tbName  */
+#line 159 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1744 "yacc.tab.cpp"
+#line 1861 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 23:
-#line 158 "yacc.y"
+  case 24: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 163 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1752 "yacc.tab.cpp"
+#line 1869 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 24:
-#line 162 "yacc.y"
+  case 25: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 167 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1760 "yacc.tab.cpp"
+#line 1877 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 25:
-#line 169 "yacc.y"
+  case 26: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 174 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1768 "yacc.tab.cpp"
+#line 1885 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 26:
-#line 173 "yacc.y"
+  case 27: /* dml: DELETE FROM tbName optWhereClause  */
+#line 178 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1776 "yacc.tab.cpp"
+#line 1893 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 27:
-#line 177 "yacc.y"
+  case 28: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 182 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1784 "yacc.tab.cpp"
+#line 1901 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 28:
-#line 181 "yacc.y"
+  case 29: /* dml: SELECT selector FROM tableList optWhereClause opt_group_clause opt_order_clause  */
+#line 186 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<SelectStmt>((yyvsp[-5].sv_exprs), (yyvsp[-3].sv_strs), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_group_by), (yyvsp[0].sv_orderby));
     }
-#line 1792 "yacc.tab.cpp"
+#line 1909 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 29:
-#line 188 "yacc.y"
+  case 30: /* subquery: '(' SELECT selector FROM tableList optWhereClause opt_group_clause opt_order_clause ')'  */
+#line 193 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_subquery) = std::make_shared<Subquery>(
             std::make_shared<SelectStmt>((yyvsp[-6].sv_exprs), (yyvsp[-4].sv_strs), (yyvsp[-3].sv_conds), (yyvsp[-2].sv_group_by), (yyvsp[-1].sv_orderby))
         );
     }
-#line 1802 "yacc.tab.cpp"
+#line 1919 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 30:
-#line 197 "yacc.y"
+  case 31: /* fieldList: field  */
+#line 202 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1810 "yacc.tab.cpp"
+#line 1927 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 31:
-#line 201 "yacc.y"
+  case 32: /* fieldList: fieldList ',' field  */
+#line 206 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 1818 "yacc.tab.cpp"
+#line 1935 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 32:
-#line 208 "yacc.y"
+  case 33: /* colNameList: colName  */
+#line 213 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 1826 "yacc.tab.cpp"
+#line 1943 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 33:
-#line 212 "yacc.y"
+  case 34: /* colNameList: colNameList ',' colName  */
+#line 217 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 1834 "yacc.tab.cpp"
+#line 1951 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 34:
-#line 219 "yacc.y"
+  case 35: /* field: colName type  */
+#line 224 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 1842 "yacc.tab.cpp"
+#line 1959 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 36: /* field: colName type keyType  */
+#line 228 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-2].sv_str), (yyvsp[-1].sv_type_len), (yyvsp[0].sv_key_type));
+    }
+#line 1967 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 37: /* field: keyType '(' colNameList ')'  */
+#line 232 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_field) = std::make_shared<KeyDef>((yyvsp[-3].sv_key_type), (yyvsp[-1].sv_strs));
+    }
+#line 1975 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 38: /* keyType: PRIMARY KEY  */
+#line 239 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_key_type) = SV_KEY_PRIMARY;
+    }
+#line 1983 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 35:
-#line 226 "yacc.y"
+  case 39: /* keyType: UNIQUE  */
+#line 243 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_key_type) = SV_KEY_UNIQUE;
+    }
+#line 1991 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 40: /* type: INT  */
+#line 250 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_INT, sizeof(int));
     }
-#line 1850 "yacc.tab.cpp"
+#line 1999 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 36:
-#line 230 "yacc.y"
+  case 41: /* type: CHAR '(' VALUE_INT ')'  */
+#line 254 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 1858 "yacc.tab.cpp"
+#line 2007 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 37:
-#line 234 "yacc.y"
+  case 42: /* type: VARCHAR '(' VALUE_INT ')'  */
+#line 258 "/root/repo/src/parser/yacc.y"
+    {
+        (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, (yyvsp[-1].sv_int));
+    }
+#line 2015 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 43: /* type: FLOAT  */
+#line 262 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
     }
-#line 1866 "yacc.tab.cpp"
+#line 2023 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 38:
-#line 241 "yacc.y"
+  case 44: /* valueList: value  */
+#line 269 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 1874 "yacc.tab.cpp"
+#line 2031 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 39:
-#line 245 "yacc.y"
+  case 45: /* valueList: valueList ',' value  */
+#line 273 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 1882 "yacc.tab.cpp"
+#line 2039 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 40:
-#line 252 "yacc.y"
+  case 46: /* value: VALUE_INT  */
+#line 280 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 1890 "yacc.tab.cpp"
+#line 2047 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 41:
-#line 256 "yacc.y"
+  case 47: /* value: VALUE_FLOAT  */
+#line 284 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 1898 "yacc.tab.cpp"
+#line 2055 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 42:
-#line 260 "yacc.y"
+  case 48: /* value: VALUE_STRING  */
+#line 288 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 1906 "yacc.tab.cpp"
+#line 2063 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 43:
-#line 264 "yacc.y"
+  case 49: /* value: VALUE_BOOL  */
+#line 292 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<BoolLit>((yyvsp[0].sv_bool));
     }
-#line 1914 "yacc.tab.cpp"
+#line 2071 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 44:
-#line 271 "yacc.y"
+  case 50: /* condition: expr op expr  */
+#line 299 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_expr), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1922 "yacc.tab.cpp"
+#line 2079 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 45:
-#line 275 "yacc.y"
+  case 51: /* condition: aggregate_expr op expr  */
+#line 303 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_aggregate_expr), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1930 "yacc.tab.cpp"
+#line 2087 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 46:
-#line 279 "yacc.y"
+  case 52: /* condition: expr op aggregate_expr  */
+#line 307 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_expr), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_aggregate_expr));
     }
-#line 1938 "yacc.tab.cpp"
+#line 2095 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 47:
-#line 283 "yacc.y"
+  case 53: /* condition: expr op subquery  */
+#line 311 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_expr), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_subquery));
     }
-#line 1946 "yacc.tab.cpp"
+#line 2103 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 48:
-#line 287 "yacc.y"
+  case 54: /* condition: subquery op expr  */
+#line 315 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_subquery), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 1954 "yacc.tab.cpp"
+#line 2111 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 49:
-#line 291 "yacc.y"
+  case 55: /* condition: expr IN subquery  */
+#line 319 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_expr),SvCompOp::SV_OP_IN,(yyvsp[0].sv_subquery));
     }
-#line 1962 "yacc.tab.cpp"
+#line 2119 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 50:
-#line 297 "yacc.y"
+  case 56: /* optWhereClause: %empty  */
+#line 325 "/root/repo/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 1968 "yacc.tab.cpp"
+#line 2125 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 51:
-#line 299 "yacc.y"
+  case 57: /* optWhereClause: WHERE whereClause  */
+#line 327 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 1976 "yacc.tab.cpp"
+#line 2133 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 52:
-#line 306 "yacc.y"
+  case 58: /* whereClause: condition  */
+#line 334 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 1984 "yacc.tab.cpp"
+#line 2141 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 53:
-#line 310 "yacc.y"
+  case 59: /* whereClause: whereClause AND condition  */
+#line 338 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 1992 "yacc.tab.cpp"
+#line 2149 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 54:
-#line 317 "yacc.y"
+  case 60: /* col: tbName '.' colName  */
+#line 345 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 2000 "yacc.tab.cpp"
+#line 2157 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 55:
-#line 321 "yacc.y"
+  case 61: /* col: colName  */
+#line 349 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 2008 "yacc.tab.cpp"
+#line 2165 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 56:
-#line 328 "yacc.y"
+  case 62: /* colList: col  */
+#line 356 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 2016 "yacc.tab.cpp"
+#line 2173 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 57:
-#line 332 "yacc.y"
+  case 63: /* colList: colList ',' col  */
+#line 360 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 2024 "yacc.tab.cpp"
+#line 2181 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 58:
-#line 338 "yacc.y"
+  case 64: /* col_with_alias: col AS IDENTIFIER  */
+#line 366 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_col)->tab_name, (yyvsp[-2].sv_col)->col_name, (yyvsp[0].sv_str));
     }
-#line 2032 "yacc.tab.cpp"
+#line 2189 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 59:
-#line 342 "yacc.y"
+  case 65: /* col_with_alias: col  */
+#line 370 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_col) = (yyvsp[0].sv_col);
     }
-#line 2040 "yacc.tab.cpp"
+#line 2197 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 60:
-#line 362 "yacc.y"
+  case 66: /* op: '='  */
+#line 390 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_EQ;
     }
-#line 2048 "yacc.tab.cpp"
+#line 2205 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 61:
-#line 366 "yacc.y"
+  case 67: /* op: '<'  */
+#line 394 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LT;
     }
-#line 2056 "yacc.tab.cpp"
+#line 2213 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 62:
-#line 370 "yacc.y"
+  case 68: /* op: '>'  */
+#line 398 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GT;
     }
-#line 2064 "yacc.tab.cpp"
+#line 2221 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 63:
-#line 374 "yacc.y"
+  case 69: /* op: NEQ  */
+#line 402 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_NE;
     }
-#line 2072 "yacc.tab.cpp"
+#line 2229 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 64:
-#line 378 "yacc.y"
+  case 70: /* op: LEQ  */
+#line 406 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_LE;
     }
-#line 2080 "yacc.tab.cpp"
+#line 2237 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 65:
-#line 382 "yacc.y"
+  case 71: /* op: GEQ  */
+#line 410 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = SV_OP_GE;
     }
-#line 2088 "yacc.tab.cpp"
+#line 2245 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 66:
-#line 389 "yacc.y"
+  case 72: /* expr: value  */
+#line 417 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2096 "yacc.tab.cpp"
+#line 2253 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 67:
-#line 393 "yacc.y"
+  case 73: /* expr: col  */
+#line 421 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2104 "yacc.tab.cpp"
+#line 2261 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 68:
-#line 400 "yacc.y"
+  case 74: /* opt_as_alias: AS IDENTIFIER  */
+#line 428 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_str) = (yyvsp[0].sv_str); 
     }
-#line 2112 "yacc.tab.cpp"
+#line 2269 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 69:
-#line 403 "yacc.y"
+  case 75: /* opt_as_alias: %empty  */
+#line 431 "/root/repo/src/parser/yacc.y"
                     { /* ignore*/ }
-#line 2118 "yacc.tab.cpp"
+#line 2275 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 70:
-#line 408 "yacc.y"
+  case 76: /* aggregate_expr: COUNT '(' '*' ')' opt_as_alias  */
+#line 436 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("COUNT", std::make_shared<StarExpr>(), (yyvsp[0].sv_str));
     }
-#line 2126 "yacc.tab.cpp"
+#line 2283 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 71:
-#line 412 "yacc.y"
+  case 77: /* aggregate_expr: COUNT '(' expr ')' opt_as_alias  */
+#line 440 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("COUNT", (yyvsp[-2].sv_expr), (yyvsp[0].sv_str));
     }
-#line 2134 "yacc.tab.cpp"
+#line 2291 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 72:
-#line 416 "yacc.y"
+  case 78: /* aggregate_expr: SUM '(' expr ')' opt_as_alias  */
+#line 444 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("SUM", (yyvsp[-2].sv_expr), (yyvsp[0].sv_str));
     }
-#line 2142 "yacc.tab.cpp"
+#line 2299 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 73:
-#line 420 "yacc.y"
+  case 79: /* aggregate_expr: AVG '(' expr ')' opt_as_alias  */
+#line 448 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("AVG", (yyvsp[-2].sv_expr), (yyvsp[0].sv_str));
     }
-#line 2150 "yacc.tab.cpp"
+#line 2307 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 74:
-#line 424 "yacc.y"
+  case 80: /* aggregate_expr: MIN '(' expr ')' opt_as_alias  */
+#line 452 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("MIN", (yyvsp[-2].sv_expr), (yyvsp[0].sv_str));
     }
-#line 2158 "yacc.tab.cpp"
+#line 2315 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 75:
-#line 428 "yacc.y"
+  case 81: /* aggregate_expr: MAX '(' expr ')' opt_as_alias  */
+#line 456 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_aggregate_expr) = std::make_shared<AggregateExpr>("MAX", (yyvsp[-2].sv_expr), (yyvsp[0].sv_str));
     }
-#line 2166 "yacc.tab.cpp"
+#line 2323 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 76:
-#line 446 "yacc.y"
+  case 82: /* setClauses: setClause  */
+#line 474 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2174 "yacc.tab.cpp"
+#line 2331 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 77:
-#line 450 "yacc.y"
+  case 83: /* setClauses: setClauses ',' setClause  */
+#line 478 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2182 "yacc.tab.cpp"
+#line 2339 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 78:
-#line 457 "yacc.y"
+  case 84: /* setClause: colName '=' value  */
+#line 485 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2190 "yacc.tab.cpp"
+#line 2347 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 79:
-#line 464 "yacc.y"
+  case 85: /* selector: '*'  */
+#line 492 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_exprs) = std::vector<std::shared_ptr<ast::Expr>>{};
     }
-#line 2198 "yacc.tab.cpp"
+#line 2355 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 80:
-#line 468 "yacc.y"
+  case 86: /* selector: selector_item  */
+#line 496 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_exprs) = std::vector<std::shared_ptr<ast::Expr>>{(yyvsp[0].sv_expr)};
     }
-#line 2206 "yacc.tab.cpp"
+#line 2363 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 81:
-#line 472 "yacc.y"
+  case 87: /* selector: selector ',' selector_item  */
+#line 500 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_exprs) = (yyvsp[-2].sv_exprs);
         (yyval.sv_exprs).push_back((yyvsp[0].sv_expr));
     }
-#line 2215 "yacc.tab.cpp"
+#line 2372 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 82:
-#line 480 "yacc.y"
+  case 88: /* selector_item: col_with_alias  */
+#line 508 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = (yyvsp[0].sv_col);
     }
-#line 2223 "yacc.tab.cpp"
+#line 2380 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 83:
-#line 484 "yacc.y"
+  case 89: /* selector_item: aggregate_expr  */
+#line 512 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_expr) = (yyvsp[0].sv_aggregate_expr);
     }
-#line 2231 "yacc.tab.cpp"
+#line 2388 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 84:
-#line 491 "yacc.y"
+  case 90: /* tableList: tbName  */
+#line 519 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2239 "yacc.tab.cpp"
+#line 2396 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 85:
-#line 495 "yacc.y"
+  case 91: /* tableList: tableList ',' tbName  */
+#line 523 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2247 "yacc.tab.cpp"
+#line 2404 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 86:
-#line 499 "yacc.y"
+  case 92: /* tableList: tableList JOIN tbName  */
+#line 527 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2255 "yacc.tab.cpp"
+#line 2412 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 87:
-#line 507 "yacc.y"
+  case 93: /* opt_order_clause: ORDER BY order_clause  */
+#line 535 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = (yyvsp[0].sv_orderby); 
     }
-#line 2263 "yacc.tab.cpp"
+#line 2420 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 88:
-#line 510 "yacc.y"
+  case 94: /* opt_order_clause: %empty  */
+#line 538 "/root/repo/src/parser/yacc.y"
                     { /* ignore*/ }
-#line 2269 "yacc.tab.cpp"
+#line 2426 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 89:
-#line 515 "yacc.y"
+  case 95: /* order_clause: colList opt_asc_desc  */
+#line 543 "/root/repo/src/parser/yacc.y"
     { 
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_cols), (yyvsp[0].sv_orderby_dir));
     }
-#line 2277 "yacc.tab.cpp"
+#line 2434 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 90:
-#line 521 "yacc.y"
+  case 96: /* opt_asc_desc: ASC  */
+#line 549 "/root/repo/src/parser/yacc.y"
         { (yyval.sv_orderby_dir) = OrderBy_ASC; }
-#line 2283 "yacc.tab.cpp"
+#line 2440 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 91:
-#line 522 "yacc.y"
+  case 97: /* opt_asc_desc: DESC  */
+#line 550 "/root/repo/src/parser/yacc.y"
            { (yyval.sv_orderby_dir) = OrderBy_DESC; }
-#line 2289 "yacc.tab.cpp"
+#line 2446 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 92:
-#line 523 "yacc.y"
+  case 98: /* opt_asc_desc: %empty  */
+#line 551 "/root/repo/src/parser/yacc.y"
       { (yyval.sv_orderby_dir) = OrderBy_DEFAULT; }
-#line 2295 "yacc.tab.cpp"
+#line 2452 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 93:
-#line 530 "yacc.y"
+  case 99: /* opt_group_clause: GROUP BY group_clause  */
+#line 558 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_group_by) = (yyvsp[0].sv_group_by);
     }
-#line 2303 "yacc.tab.cpp"
+#line 2460 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 94:
-#line 533 "yacc.y"
+  case 100: /* opt_group_clause: %empty  */
+#line 561 "/root/repo/src/parser/yacc.y"
                     { /* ignore*/ }
-#line 2309 "yacc.tab.cpp"
+#line 2466 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 95:
-#line 538 "yacc.y"
+  case 101: /* group_clause: colList opt_having_clause  */
+#line 566 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_group_by) = std::make_shared<GroupBy>((yyvsp[-1].sv_cols), (yyvsp[0].sv_having));
     }
-#line 2317 "yacc.tab.cpp"
+#line 2474 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 96:
-#line 545 "yacc.y"
+  case 102: /* opt_having_clause: HAVING whereClause  */
+#line 573 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_having) = std::make_shared<Having>((yyvsp[0].sv_conds));
     }
-#line 2325 "yacc.tab.cpp"
+#line 2482 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 97:
-#line 549 "yacc.y"
+  case 103: /* opt_having_clause: %empty  */
+#line 577 "/root/repo/src/parser/yacc.y"
     {
         (yyval.sv_having) = nullptr;
     }
-#line 2333 "yacc.tab.cpp"
+#line 2490 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 98:
-#line 555 "yacc.y"
+  case 104: /* set_knob_type: ENABLE_NESTLOOP  */
+#line 583 "/root/repo/src/parser/yacc.y"
                     { (yyval.sv_setKnobType) = EnableNestLoop; }
-#line 2339 "yacc.tab.cpp"
+#line 2496 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
-  case 99:
-#line 556 "yacc.y"
+  case 105: /* set_knob_type: ENABLE_SORTMERGE  */
+#line 584 "/root/repo/src/parser/yacc.y"
                        { (yyval.sv_setKnobType) = EnableSortMerge; }
-#line 2345 "yacc.tab.cpp"
+#line 2502 "/root/repo/src/parser/yacc.tab.cpp"
+    break;
+
+  case 106: /* set_knob_type: ENABLE_ASYNC_COMMIT  */
+#line 585 "/root/repo/src/parser/yacc.y"
+                          { (yyval.sv_setKnobType) = EnableAsyncCommit; }
+#line 2508 "/root/repo/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2349 "yacc.tab.cpp"
+#line 2512 "/root/repo/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2360,11 +2523,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2389,50 +2551,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (&yylloc, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2465,6 +2622,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2481,13 +2639,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2501,7 +2660,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2512,13 +2671,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2529,7 +2686,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2537,24 +2694,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (&yylloc, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2570,18 +2725,17 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 562 "yacc.y"
+
+#line 591 "/root/repo/src/parser/yacc.y"
 
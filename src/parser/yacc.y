@@ -21,7 +21,7 @@ using namespace ast;
 %define parse.error verbose
 
 // keywords
-%token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM ASC ORDER BY WHERE UPDATE SET SELECT INT CHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ENABLE_NESTLOOP ENABLE_SORTMERGE
+%token SHOW TABLES CREATE TABLE DROP DESC INSERT INTO VALUES DELETE FROM ASC ORDER BY WHERE UPDATE SET SELECT INT CHAR VARCHAR FLOAT INDEX AND JOIN EXIT HELP TXN_BEGIN TXN_COMMIT TXN_ABORT TXN_ROLLBACK ENABLE_NESTLOOP ENABLE_SORTMERGE ENABLE_ASYNC_COMMIT RECOVERY STATS PRIMARY KEY UNIQUE
 // non-keywords
 %token IN 
 %token AS
@@ -42,6 +42,7 @@ using namespace ast;
 %type <sv_field> field
 %type <sv_fields> fieldList
 %type <sv_type_len> type
+%type <sv_key_type> keyType
 %type <sv_comp_op> op
 %type <sv_expr> expr selector_item
 %type <sv_val> value
@@ -132,6 +133,10 @@ dbStmt:
     {
         $$ = std::make_shared<ShowIndex>($4);
     }
+    | SHOW RECOVERY STATS
+    {
+        $$ = std::make_shared<ShowRecoveryStats>();
+    }
     ;
 
 setStmt:
@@ -219,6 +224,25 @@ field:
     {
         $$ = std::make_shared<ColDef>($1, $2);
     }
+    | colName type keyType
+    {
+        $$ = std::make_shared<ColDef>($1, $2, $3);
+    }
+    | keyType '(' colNameList ')'
+    {
+        $$ = std::make_shared<KeyDef>($1, $3);
+    }
+    ;
+
+keyType:
+        PRIMARY KEY
+    {
+        $$ = SV_KEY_PRIMARY;
+    }
+    | UNIQUE
+    {
+        $$ = SV_KEY_UNIQUE;
+    }
     ;
 
 type:
@@ -230,6 +254,10 @@ type:
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_STRING, $3);
     }
+    | VARCHAR '(' VALUE_INT ')'
+    {
+        $$ = std::make_shared<TypeLen>(SV_TYPE_VARCHAR, $3);
+    }
     | FLOAT
     {
         $$ = std::make_shared<TypeLen>(SV_TYPE_FLOAT, sizeof(float));
@@ -554,6 +582,7 @@ opt_having_clause:
 set_knob_type:
     ENABLE_NESTLOOP { $$ = EnableNestLoop; }
     | ENABLE_SORTMERGE { $$ = EnableSortMerge; }
+    | ENABLE_ASYNC_COMMIT { $$ = EnableAsyncCommit; }
     ;
 
 tbName: IDENTIFIER;
@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 
 static constexpr int BITMAP_WIDTH = 8;
 static constexpr unsigned BITMAP_HIGHEST_BIT = 0x80u;  // 128 (2^7)
+static constexpr int BITMAP_WORD_BYTES = 8;             // 按字扫描时每次读取的字节数
+static constexpr uint64_t BITMAP_WORD_HIGHEST_BIT = uint64_t(1) << 63;
 
 class Bitmap {
    public:
@@ -31,7 +33,7 @@ class Bitmap {
     static bool is_set(const char *bm, int pos) { return (bm[get_bucket(pos)] & get_bit(pos)) != 0; }
 
     /**
-     * @brief 找下一个为0 or 1的位
+     * @brief 找下一个为0 or 1的位，每次比较64位，用clz定位字中的第一个目标位
      * @param bit false表示要找下一个为0的位，true表示要找下一个为1的位
      * @param bm 要找的起始地址为bm
      * @param max_n 要找的从起始地址开始的偏移为[curr+1,max_n)
@@ -39,10 +41,16 @@ class Bitmap {
      * @return 找到了就返回偏移位置，没找到就返回max_n
      */
     static int next_bit(bool bit, const char *bm, int max_n, int curr) {
-        for (int i = curr + 1; i < max_n; i++) {
-            if (is_set(bm, i) == bit) {
-                return i;
+        for (int pos = curr + 1; pos < max_n;) {
+            int bucket = get_bucket(pos);
+            uint64_t word = load_word(bm, bucket, max_n);
+            if (!bit) word = ~word;
+            word &= ~uint64_t(0) >> (pos % BITMAP_WIDTH);  // 去掉起始字节中pos之前的位
+            if (word != 0) {
+                int found = bucket * BITMAP_WIDTH + __builtin_clzll(word);
+                return found < max_n ? found : max_n;      // 末尾补齐的位不计入
             }
+            pos = (bucket + BITMAP_WORD_BYTES) * BITMAP_WIDTH;
         }
         return max_n;
     }
@@ -50,6 +58,28 @@ class Bitmap {
     // 找第一个为0 or 1的位
     static int first_bit(bool bit, const char *bm, int max_n) { return next_bit(bit, bm, max_n, -1); }
 
+    // 统计[0,max_n)中为1的位的个数
+    static int count(const char *bm, int max_n) {
+        int cnt = 0;
+        for (int bucket = 0; bucket * BITMAP_WIDTH < max_n; bucket += BITMAP_WORD_BYTES) {
+            cnt += __builtin_popcountll(load_word(bm, bucket, max_n));
+        }
+        return cnt;
+    }
+
+    // 按从小到大的顺序对[0,max_n)中每个为1的位调用f(pos)，每个字用clz逐个取出置位后清除
+    template <typename F>
+    static void for_each_set(const char *bm, int max_n, F &&f) {
+        for (int bucket = 0; bucket * BITMAP_WIDTH < max_n; bucket += BITMAP_WORD_BYTES) {
+            uint64_t word = load_word(bm, bucket, max_n);
+            while (word != 0) {
+                int lead = __builtin_clzll(word);
+                f(bucket * BITMAP_WIDTH + lead);
+                word &= ~(BITMAP_WORD_HIGHEST_BIT >> lead);
+            }
+        }
+    }
+
     // for example:
     // rid_.slot_no = Bitmap::next_bit(true, page_handle.bitmap, file_handle_->file_hdr_.num_records_per_page,
     // rid_.slot_no); int slot_no = Bitmap::first_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page);
@@ -57,5 +87,22 @@ class Bitmap {
    private:
     static int get_bucket(int pos) { return pos / BITMAP_WIDTH; }
 
+    /**
+     * @brief 从第bucket个字节开始读取最多8个字节，组成高位在前的64位字，使第pos位对应字中从高到低的第pos%64位。
+     * 超出(max_n+7)/8个字节的部分不读取，以0补齐
+     */
+    static uint64_t load_word(const char *bm, int bucket, int max_n) {
+        int size = (max_n + BITMAP_WIDTH - 1) / BITMAP_WIDTH - bucket;
+        uint64_t word = 0;
+        memcpy(&word, bm + bucket, size < BITMAP_WORD_BYTES ? size : BITMAP_WORD_BYTES);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        // 最后一个字节中超出max_n的位可能是脏数据，清零
+        int tail = bucket * BITMAP_WIDTH + BITMAP_WORD_BYTES * BITMAP_WIDTH - max_n;
+        if (tail > 0) word &= ~uint64_t(0) << tail;
+        return word;
+    }
+
     static char get_bit(int pos) { return BITMAP_HIGHEST_BIT >> static_cast<char>(pos % BITMAP_WIDTH); }
 };
@@ -13,26 +13,68 @@ See the Mulan PSL v2 for more details. */
 #include "defs.h"
 #include "storage/buffer_pool_manager.h"
 
+constexpr uint32_t RM_FILE_MAGIC = 0x42444d52;   // "RMDB"，表数据文件头的标识
+/* 表数据文件的格式版本，文件头或页面布局发生不兼容的变化时递增，打开文件时检查，旧格式的文件不能直接打开
+ * 1: 文件头增加magic/version和num_var_cols/var_cols，含VARCHAR字段的表使用slotted page
+ * 2: 去掉空闲页链表(文件头的first_free_page_no和页头的next_free_page_no)，空闲空间由内存中的RmFreeSpaceMap管理 */
+constexpr int RM_FILE_VERSION = 2;
+
 constexpr int RM_NO_PAGE = -1;
 constexpr int RM_FILE_HDR_PAGE = 0;
 constexpr int RM_FIRST_RECORD_PAGE = 1;
 constexpr int RM_MAX_RECORD_SIZE = 512;
+constexpr int RM_MAX_VAR_COLS = 64;
+constexpr int RM_FSM_MAX_PROBES = 8;    // 一次插入最多检查几个空闲空间表中未知或过时的页面，之后直接扩展文件
+constexpr int RM_MAX_STORED_SIZE = RM_MAX_RECORD_SIZE + RM_MAX_VAR_COLS * (int)sizeof(uint16_t);
+
+/* 变长字段(VARCHAR)在内存记录中的位置，内存中的记录仍然是定长的，变长字段补0到最大长度 */
+struct RmVarCol {
+    int offset;     // 字段在内存记录中的偏移
+    int len;        // 字段的最大长度
+};
 
 /* 文件头，记录表数据文件的元信息，写入磁盘中文件的第0号页面 */
 struct RmFileHdr {
-    int record_size;            // 表中每条记录的大小，由于不包含变长字段，因此当前字段初始化后保持不变
+    uint32_t magic;             // RM_FILE_MAGIC
+    int version;                // 文件格式版本RM_FILE_VERSION
+    int record_size;            // 表中每条记录在内存中的大小(变长字段按最大长度计算)，初始化后保持不变
     int num_pages;              // 文件中分配的页面个数（初始化为1）
     int num_records_per_page;   // 每个页面最多能存储的元组个数
-    int first_free_page_no;     // 文件中当前第一个包含空闲空间的页面号（初始化为-1）
     int bitmap_size;            // 每个页面bitmap大小
+    int num_var_cols;           // 变长字段个数，大于0时页面使用slotted page格式
+    RmVarCol var_cols[RM_MAX_VAR_COLS];     // 变长字段的位置，按offset升序排列
+
+    bool is_slotted() const { return num_var_cols > 0; }
+
+    // slotted page中一条记录的最大存储长度：每个变长字段多存2字节长度
+    int max_stored_size() const { return record_size + num_var_cols * (int)sizeof(uint16_t); }
 };
 
 /* 表数据文件中每个页面的页头，记录每个页面的元信息 */
 struct RmPageHdr {
-    int next_free_page_no;  // 当前页面满了之后，下一个包含空闲空间的页面号（初始化为-1）
     int num_records;        // 当前页面中当前已经存储的记录个数（初始化为0）
 };
 
+/**
+ * slotted page的页头，紧跟在RmPageHdr之后。页面布局为：
+ * [lsn][RmPageHdr][RmSlottedPageHdr][bitmap][slot目录 -> ... 空闲空间 ... <- 记录数据]
+ * slot目录从前往后增长，记录数据从页尾往前增长，rid的slot_no是记录在slot目录中的下标
+ */
+struct RmSlottedPageHdr {
+    int num_slots;          // slot目录中的项数，删除记录不会缩小目录，保证rid不变
+    int free_end;           // 记录数据区的起始位置(页内偏移)，空闲空间为[slot目录末尾, free_end)
+    int live_bytes;         // 页面中有效记录占用的字节数，删除和缩短留下的空洞在整理页面时回收
+};
+
+/* slot目录项，记录在页面中的位置和存储长度 */
+struct RmSlot {
+    uint16_t offset;
+    uint16_t len;
+};
+
+// 页面中记录区之前的固定开销：页面lsn和页头
+constexpr int RM_PAGE_HDR_SIZE = (int)(Page::OFFSET_PAGE_HDR + sizeof(RmPageHdr));
+
 /* 表中的记录 */
 struct RmRecord {
     char* data;  // 记录的数据
@@ -105,6 +147,7 @@ public:
         }
         data = new char[size];
         memcpy(data, data_ + sizeof(int), size);
+        allocated_ = true;
     }
 
     ~RmRecord() {
@@ -115,3 +158,9 @@ public:
         data = nullptr;
     }
 };
+
+/* 记录的零拷贝视图：data直接指向缓冲池页面中的槽位，只在该页面被pin住期间有效 */
+struct RmRecordView {
+    const char *data;   // 记录的数据
+    int size;           // 记录的大小
+};
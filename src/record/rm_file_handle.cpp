@@ -31,8 +31,11 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* cont
     // 3. 初始化一个指向RmRecord的指针（赋值其内部的data和size）
     int record_size = file_hdr_.record_size;
     std::unique_ptr<RmRecord> record = std::make_unique<RmRecord>(record_size);
-    char *record_data = page_handle.get_slot(rid.slot_no);
-    std::memcpy(record->data, record_data, record_size);
+    if (file_hdr_.is_slotted()) {
+        decode_record(page_handle.get_slot_data(rid.slot_no), record->data);
+    } else {
+        std::memcpy(record->data, page_handle.get_slot(rid.slot_no), record_size);
+    }
 
     buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(),false);
     return record;
@@ -42,43 +45,61 @@ std::unique_ptr<RmRecord> RmFileHandle::get_record(const Rid& rid, Context* cont
  * @description: 在当前表中插入一条记录，不指定插入位置
  * @param {char*} buf 要插入的记录的数据
  * @param {Context*} context
+ * @param {function} log_insert 选定rid之后、修改页面之前调用，写插入日志并返回其lsn，插入后记为页面lsn
  * @return {Rid} 插入的记录的记录号（位置）
  */
-Rid RmFileHandle::insert_record(char* buf, Context* context) {
+Rid RmFileHandle::insert_record(char* buf, Context* context, const std::function<lsn_t(const Rid &)> &log_insert) {
     // Todo:
     // 1. 获取当前未满的page handle
     // 2. 在page handle中找到空闲slot位置
     // 3. 将buf复制到空闲slot位置
     // 4. 更新page_handle.page_hdr中的数据结构
-    // 注意考虑插入一条记录后页面已满的情况，需要更新file_hdr_.first_free_page_no
 
-    // 1. 获取当前未满的 page handle
+    // 1. 从空闲空间表中认领一个未满的页面，认领期间其他插入者不会使用该页面
     RmPageHandle page_handle = create_page_handle();
-    // 2. 在 page handle 中找到空闲 slot 位置
-    int slot_no = Bitmap::next_bit(0,page_handle.bitmap, file_hdr_.num_records_per_page,-1);
-    // 3. 将数据 buf 复制到空闲 slot 位置
-    char* slot_ptr = page_handle.get_slot(slot_no);
-    memcpy(slot_ptr, buf, file_hdr_.record_size);
+    // 2. 在 page handle 中找到空闲 slot 位置；slotted page优先复用slot目录中已经空出的项，没有时追加到目录末尾
+    int slot_no = file_hdr_.is_slotted()
+                      ? Bitmap::next_bit(false, page_handle.bitmap, page_handle.slotted_hdr->num_slots, -1)
+                      : Bitmap::next_bit(false, page_handle.bitmap, file_hdr_.num_records_per_page, -1);
+    Rid rid{page_handle.page->get_page_id().page_no, slot_no};
+    // 3. 确定rid之后先写插入日志，页面一直被pin住直到日志lsn记为页面lsn，写回页面之前一定会先把这条日志刷盘
+    lsn_t lsn = INVALID_LSN;
+    if (log_insert != nullptr) {
+        try {
+            lsn = log_insert(rid);
+        } catch (...) {
+            release_page_handle(page_handle);
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            throw;
+        }
+    }
+    // 4. 将数据 buf 复制到空闲 slot 位置，create_page_handle()保证页面空间足够
+    if (file_hdr_.is_slotted()) {
+        put_slotted_record(page_handle, slot_no, buf);
+    } else {
+        char* slot_ptr = page_handle.get_slot(slot_no);
+        memcpy(slot_ptr, buf, file_hdr_.record_size);
+    }
     Bitmap::set(page_handle.bitmap,slot_no);
-    // 4. 更新 page handle 中的页头数据结构
+    // 5. 更新 page handle 中的页头数据结构
     page_handle.page_hdr->num_records++;
-    // 5. 如果插入记录后页面已满，更新文件头中的 first_free_page_no
-    if (page_handle.page_hdr->num_records >= file_hdr_.num_records_per_page) {
-        release_page_handle(page_handle);
-    }
+    stamp_page_lsn(page_handle.page, lsn);
+    // 6. 归还页面，空闲空间表中记下页面剩余的空间
+    release_page_handle(page_handle);
 
     page_handle.page->set_dirty(true);
     buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 
-    return Rid{page_handle.page->get_page_id().page_no, slot_no};
+    return rid;
 }
 
 /**
  * @description: 在当前表中的指定位置插入一条记录
  * @param {Rid&} rid 要插入记录的位置
  * @param {char*} buf 要插入记录的数据
+ * @param {Context*} context 事务的最后一条日志即该插入的日志，记为页面lsn
  */
-void RmFileHandle::insert_record(const Rid& rid, char* buf) {
+void RmFileHandle::insert_record(const Rid& rid, char* buf, Context* context) {
     // 1. 获取指定页面的页面句柄
     auto page_handle = fetch_page_handle(rid.page_no);
     
@@ -90,69 +111,113 @@ void RmFileHandle::insert_record(const Rid& rid, char* buf) {
     }
     std::cout<<"insert:["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
     // 3. 将buf复制到指定slot位置
-    char* slot_addr = page_handle.get_slot(rid.slot_no);
-    memcpy(slot_addr, buf, file_hdr_.record_size);
+    if (file_hdr_.is_slotted()) {
+        if (!put_slotted_record(page_handle, rid.slot_no, buf)) {
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            throw InternalError("RmFileHandle::insert_record: page is out of space");
+        }
+    } else {
+        char* slot_addr = page_handle.get_slot(rid.slot_no);
+        memcpy(slot_addr, buf, file_hdr_.record_size);
+    }
     // 4. 更新页面头部的bitmap和记录数
     Bitmap::set(page_handle.bitmap, rid.slot_no);
     page_handle.page_hdr->num_records++;
-    // 5. 如果页面已满，则更新file_hdr_.first_free_page_no
-    if (page_handle.page_hdr->num_records == file_hdr_.num_records_per_page) {
-        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
-        page_handle.page_hdr->next_free_page_no = RM_NO_PAGE;
+    // 5. 更新空闲空间表中页面的剩余空间
+    update_free_level(page_handle);
+    // 插入日志在插入之前写入，页面lsn记为该日志的lsn
+    if (context != nullptr && context->txn_ != nullptr) {
+        stamp_page_lsn(page_handle.page, context->txn_->get_prev_lsn());
     }
     // 标记页面为脏页并unpin
     page_handle.page->set_dirty(true);
     buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 
-void RmFileHandle::insert_record_for_recovery(const Rid& rid, char* buf) {
-    if (rid.page_no == INVALID_PAGE_ID || rid.page_no <0){
-        throw PageNotExistError("tbname",rid.page_no);
-    }
-    PageId pid(fd_,rid.page_no);
-    Page* page;
-    RmPageHandle* page_handle;
-    try
-    {
-        page = buffer_pool_manager_->fetch_page(pid);
-        if (page == nullptr) {
-            throw std::runtime_error("Failed to fetch page from buffer pool.");
-        }
-        page_handle = new RmPageHandle(&file_hdr_,page);
+/**
+ * @description: 把修改页面的日志lsn记为页面lsn，页面lsn只增不减
+ */
+void RmFileHandle::stamp_page_lsn(Page *page, lsn_t lsn) {
+    if (lsn != INVALID_LSN && page->get_page_lsn() < lsn) {
+        page->set_page_lsn(lsn);
+    }
+}
+
+/**
+ * @description: 获取恢复时要修改的页面句柄，页面不存在(崩溃前没有写回磁盘)时在指定页号上创建空页面
+ * @param {int} page_no 页面号
+ */
+RmPageHandle RmFileHandle::fetch_page_handle_for_recovery(int page_no) {
+    if (page_no == INVALID_PAGE_ID || page_no < 0) {
+        throw PageNotExistError("tbname", page_no);
+    }
+    Page *page = nullptr;
+    try {
+        page = buffer_pool_manager_->fetch_page(PageId(fd_, page_no));
+    } catch (const std::exception &e) {
+        page = nullptr;
+    }
+    if (page != nullptr) {
+        return RmPageHandle(&file_hdr_, page);
+    }
+    PageId pid(fd_, -1);
+    page = buffer_pool_manager_->new_page(&pid, page_no);
+    RmPageHandle page_handle(&file_hdr_, page);
+    page_handle.page_hdr->num_records = 0;
+    std::memset(page_handle.bitmap, 0, file_hdr_.bitmap_size);
+    if (file_hdr_.is_slotted()) {
+        page_handle.init_slotted();
     }
-    catch(const std::exception& e)
-    {
-        PageId pid(fd_,-1);
-        page = buffer_pool_manager_->new_page(&pid,rid.page_no);
+    return page_handle;
+}
 
-        RmPageHandle new_page_handle(&file_hdr_, page);
-        RmPageHdr *page_hdr = new_page_handle.page_hdr;
-        page_hdr->next_free_page_no = RM_NO_PAGE;
-        page_hdr->num_records = 0;
-        std::memset(new_page_handle.bitmap, 0, file_hdr_.bitmap_size);
+/**
+ * @description: 恢复时判断页面是否已经包含lsn对应的修改，若已包含则直接unpin页面
+ * @return {bool} 页面lsn不早于lsn时返回true，调用者跳过这条日志
+ * @param {lsn_t} lsn 重做的日志lsn，undo时为INVALID_LSN，不做判断
+ */
+bool RmFileHandle::skip_for_recovery(RmPageHandle &page_handle, lsn_t lsn) {
+    if (lsn == INVALID_LSN || page_handle.page->get_page_lsn() < lsn) {
+        return false;
+    }
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+    return true;
+}
 
-        page_handle = new RmPageHandle(&file_hdr_,page);
+/**
+ * @description: 恢复时在指定位置插入一条记录
+ * @param {lsn_t} lsn 重做的日志lsn，修改后记录到页面lsn中；undo时为INVALID_LSN
+ */
+void RmFileHandle::insert_record_for_recovery(const Rid& rid, char* buf, lsn_t lsn) {
+    RmPageHandle page_handle = fetch_page_handle_for_recovery(rid.page_no);
+    if (skip_for_recovery(page_handle, lsn)) {
+        return;
     }
-    if (Bitmap::is_set(page_handle->bitmap, rid.slot_no)) {
-        //throw std::runtime_error("The specified slot is already occupied.");
+    if (Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
         std::cout<<"insert: The specified slot is already occupied.["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
         return;
     }
-    std::cout<<"insert:["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
     // 3. 将buf复制到指定slot位置
-    char* slot_addr = page_handle->get_slot(rid.slot_no);
-    memcpy(slot_addr, buf, file_hdr_.record_size);
-    // 4. 更新页面头部的bitmap和记录数
-    Bitmap::set(page_handle->bitmap, rid.slot_no);
-    page_handle->page_hdr->num_records++;
-    // 5. 如果页面已满，则更新file_hdr_.first_free_page_no
-    if (page_handle->page_hdr->num_records == file_hdr_.num_records_per_page) {
-        file_hdr_.first_free_page_no = page_handle->page_hdr->next_free_page_no;
-        page_handle->page_hdr->next_free_page_no = RM_NO_PAGE;
+    if (file_hdr_.is_slotted()) {
+        // 按日志顺序重做时页面空间一定足够
+        if (!put_slotted_record(page_handle, rid.slot_no, buf)) {
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            throw InternalError("RmFileHandle::insert_record_for_recovery: page is out of space");
+        }
+    } else {
+        char* slot_addr = page_handle.get_slot(rid.slot_no);
+        memcpy(slot_addr, buf, file_hdr_.record_size);
     }
+    // 4. 更新页面头部的bitmap和记录数
+    Bitmap::set(page_handle.bitmap, rid.slot_no);
+    page_handle.page_hdr->num_records++;
+    // 5. 更新空闲空间表中页面的剩余空间
+    update_free_level(page_handle);
+    stamp_page_lsn(page_handle.page, lsn);
     // 标记页面为脏页并unpin
-    page_handle->page->set_dirty(true);
-    buffer_pool_manager_->unpin_page(page_handle->page->get_page_id(), true);
+    page_handle.page->set_dirty(true);
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 
 /**
@@ -164,7 +229,6 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     // Todo:
     // 1. 获取指定记录所在的page handle
     // 2. 更新page_handle.page_hdr中的数据结构
-    // 注意考虑删除一条记录后页面未满的情况，需要调用release_page_handle()
 
     // 1. 获取指定记录所在的page handle
     RmPageHandle page_handle = fetch_page_handle(rid.page_no);
@@ -180,12 +244,17 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     Bitmap::reset(page_handle.bitmap, rid.slot_no);
     page_handle.page_hdr->num_records--;
 
-    char* slot = page_handle.get_slot(rid.slot_no);
-    memset(slot, 0, file_hdr_.record_size);
-
-    // 4. 如果页面在删除记录后变得未满，调用release_page_handle()进行处理
-    if (page_handle.page_hdr->num_records < file_hdr_.num_records_per_page) {
-        release_page_handle(page_handle);
+    if (file_hdr_.is_slotted()) {
+        remove_slotted_record(page_handle, rid.slot_no);
+    } else {
+        char* slot = page_handle.get_slot(rid.slot_no);
+        memset(slot, 0, file_hdr_.record_size);
+    }
+    // 4. 删除后页面有了空闲空间，更新空闲空间表
+    update_free_level(page_handle);
+    // 删除日志在删除之前写入，页面lsn记为该日志的lsn
+    if (context != nullptr && context->txn_ != nullptr) {
+        stamp_page_lsn(page_handle.page, context->txn_->get_prev_lsn());
     }
 
     // 标记页面为脏页并unpin
@@ -193,56 +262,33 @@ void RmFileHandle::delete_record(const Rid& rid, Context* context) {
     buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 
-void RmFileHandle::delete_record_for_recovery(const Rid &rid, Context *context){
-    if (rid.page_no == INVALID_PAGE_ID || rid.page_no <0){
-        throw PageNotExistError("tbname",rid.page_no);
-    }
-    PageId pid(fd_,rid.page_no);
-    Page* page;
-    RmPageHandle* page_handle;
-    try
-    {
-        page = buffer_pool_manager_->fetch_page(pid);
-        if (page == nullptr) {
-            throw std::runtime_error("Failed to fetch page from buffer pool.");
-        }
-        page_handle = new RmPageHandle(&file_hdr_,page);
-    }
-    catch(const std::exception& e)
-    {
-        PageId pid(fd_,-1);
-        page = buffer_pool_manager_->new_page(&pid,rid.page_no);
-
-        RmPageHandle new_page_handle(&file_hdr_, page);
-        RmPageHdr *page_hdr = new_page_handle.page_hdr;
-        page_hdr->next_free_page_no = RM_NO_PAGE;
-        page_hdr->num_records = 0;
-        std::memset(new_page_handle.bitmap, 0, file_hdr_.bitmap_size);
-
-        page_handle = new RmPageHandle(&file_hdr_,page);
+void RmFileHandle::delete_record_for_recovery(const Rid &rid, lsn_t lsn){
+    RmPageHandle page_handle = fetch_page_handle_for_recovery(rid.page_no);
+    if (skip_for_recovery(page_handle, lsn)) {
+        return;
     }
     // 2. 检查指定位置是否有记录
-    if (!Bitmap::is_set(page_handle->bitmap, rid.slot_no)) {
-        //throw std::runtime_error("The specified slot is already empty.");
+    if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
         std::cout<<"delete: The specified slot is already empty.["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
         return;
     }
-    std::cout<<"delete:["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
     // 3. 将bitmap中指定位置的bit清除，并更新页面头部的记录数
-    Bitmap::reset(page_handle->bitmap, rid.slot_no);
-    page_handle->page_hdr->num_records--;
-
-    char* slot = page_handle->get_slot(rid.slot_no);
-    memset(slot, 0, file_hdr_.record_size);
+    Bitmap::reset(page_handle.bitmap, rid.slot_no);
+    page_handle.page_hdr->num_records--;
 
-    // 4. 如果页面在删除记录后变得未满，调用release_page_handle()进行处理
-    if (page_handle->page_hdr->num_records < file_hdr_.num_records_per_page) {
-        release_page_handle(*page_handle);
+    if (file_hdr_.is_slotted()) {
+        remove_slotted_record(page_handle, rid.slot_no);
+    } else {
+        char* slot = page_handle.get_slot(rid.slot_no);
+        memset(slot, 0, file_hdr_.record_size);
     }
+    update_free_level(page_handle);
+    stamp_page_lsn(page_handle.page, lsn);
 
     // 标记页面为脏页并unpin
-    page_handle->page->set_dirty(true);
-    buffer_pool_manager_->unpin_page(page_handle->page->get_page_id(), true);
+    page_handle.page->set_dirty(true);
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 
 /**
@@ -265,56 +311,67 @@ void RmFileHandle::update_record(const Rid& rid, char* buf, Context* context) {
     }
     std::cout<<"update:["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
     // 3. 更新指定slot位置的数据
-    char* slot = page_handle.get_slot(rid.slot_no);
-    //memset(slot,0,file_hdr_.record_size);
-    memcpy(slot, buf, file_hdr_.record_size);
+    if (file_hdr_.is_slotted()) {
+        // 调用者通过can_update_in_place()确认过页面空间足够，放不下的记录由调用者删除后重新插入
+        if (!put_slotted_record(page_handle, rid.slot_no, buf)) {
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            throw InternalError("RmFileHandle::update_record: page is out of space");
+        }
+        // 变长记录的长度变化后页面的剩余空间随之变化
+        update_free_level(page_handle);
+    } else {
+        char* slot = page_handle.get_slot(rid.slot_no);
+        //memset(slot,0,file_hdr_.record_size);
+        memcpy(slot, buf, file_hdr_.record_size);
+    }
+    // 更新日志在更新之前写入，页面lsn记为该日志的lsn
+    if (context != nullptr && context->txn_ != nullptr) {
+        stamp_page_lsn(page_handle.page, context->txn_->get_prev_lsn());
+    }
     // 4. 标记页面为脏页
    page_handle.page->set_dirty(true);
    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 
-void RmFileHandle::update_record_for_recovery(const Rid &rid, char *buf, Context *context){
-    if (rid.page_no == INVALID_PAGE_ID || rid.page_no <0){
-        throw PageNotExistError("tbname",rid.page_no);
-    }
-    PageId pid(fd_,rid.page_no);
-    Page* page;
-    RmPageHandle* page_handle;
-    try
-    {
-        page = buffer_pool_manager_->fetch_page(pid);
-        if (page == nullptr) {
-            throw std::runtime_error("Failed to fetch page from buffer pool.");
-        }
-        page_handle = new RmPageHandle(&file_hdr_,page);
-    }
-    catch(const std::exception& e)
-    {
-        PageId pid(fd_,-1);
-        page = buffer_pool_manager_->new_page(&pid,rid.page_no);
-
-        RmPageHandle new_page_handle(&file_hdr_, page);
-        RmPageHdr *page_hdr = new_page_handle.page_hdr;
-        page_hdr->next_free_page_no = RM_NO_PAGE;
-        page_hdr->num_records = 0;
-        std::memset(new_page_handle.bitmap, 0, file_hdr_.bitmap_size);
+void RmFileHandle::update_record_for_recovery(const Rid &rid, char *buf, lsn_t lsn){
+    update_record_for_recovery(rid, [&](char *slot) { memcpy(slot, buf, file_hdr_.record_size); }, lsn);
+}
 
-        page_handle = new RmPageHandle(&file_hdr_,page);
+/**
+ * @description: 恢复时在原记录上就地修改，update日志只记录变化的字节区间，由modify把区间写入记录
+ * @param {Rid&} rid 记录位置
+ * @param {function<void(char *)>} &modify 修改记录的函数，参数为记录所在slot
+ * @param {lsn_t} lsn 日志的lsn，INVALID_LSN表示不检查也不修改页面lsn(undo)
+ */
+void RmFileHandle::update_record_for_recovery(const Rid &rid, const std::function<void(char *)> &modify, lsn_t lsn){
+    RmPageHandle page_handle = fetch_page_handle_for_recovery(rid.page_no);
+    if (skip_for_recovery(page_handle, lsn)) {
+        return;
     }
     // 2. 检查指定位置是否有记录
-    if (!Bitmap::is_set(page_handle->bitmap, rid.slot_no)) {
-        //throw std::runtime_error("The specified slot does not contain a record.");
+    if (!Bitmap::is_set(page_handle.bitmap, rid.slot_no)) {
         std::cout<<"update: The specified slot does not contain a record.["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
         return;
     }
-    std::cout<<"update:["<<rid.page_no<<","<<rid.slot_no<<"]"<<std::endl;
     // 3. 更新指定slot位置的数据
-    char* slot = page_handle->get_slot(rid.slot_no);
-    //memset(slot,0,file_hdr_.record_size);
-    memcpy(slot, buf, file_hdr_.record_size);
+    if (file_hdr_.is_slotted()) {
+        // 变长记录先解码成定长格式，修改之后重新编码写回
+        char buf[RM_MAX_RECORD_SIZE];
+        decode_record(page_handle.get_slot_data(rid.slot_no), buf);
+        modify(buf);
+        if (!put_slotted_record(page_handle, rid.slot_no, buf)) {
+            buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+            throw InternalError("RmFileHandle::update_record_for_recovery: page is out of space");
+        }
+        update_free_level(page_handle);
+    } else {
+        modify(page_handle.get_slot(rid.slot_no));
+    }
+    stamp_page_lsn(page_handle.page, lsn);
     // 4. 标记页面为脏页
-   page_handle->page->set_dirty(true);
-   buffer_pool_manager_->unpin_page(page_handle->page->get_page_id(), true);
+    page_handle.page->set_dirty(true);
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), true);
 }
 /**
  * 以下函数为辅助函数，仅提供参考，可以选择完成如下函数，也可以删除如下函数，在单元测试中不涉及如下函数接口的直接调用
@@ -322,9 +379,10 @@ void RmFileHandle::update_record_for_recovery(const Rid &rid, char *buf, Context
 /**
  * @description: 获取指定页面的页面句柄
  * @param {int} page_no 页面号
+ * @param {BufferAccessStrategy*} strategy 缓冲池访问策略，顺序扫描大表时使用
  * @return {RmPageHandle} 指定页面的句柄
  */
-RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
+RmPageHandle RmFileHandle::fetch_page_handle(int page_no, BufferAccessStrategy *strategy) const {
     // Todo:
     // 使用缓冲池获取指定页面，并生成page_handle返回给上层
     // if page_no is invalid, throw PageNotExistError exception
@@ -332,7 +390,7 @@ RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
         throw PageNotExistError("tbname",page_no);
     }
     PageId pid(fd_,page_no);
-    Page* page = buffer_pool_manager_->fetch_page(pid);
+    Page* page = buffer_pool_manager_->fetch_page(pid, strategy);
     if (page == nullptr) {
         throw std::runtime_error("Failed to fetch page from buffer pool.");
     }
@@ -340,15 +398,13 @@ RmPageHandle RmFileHandle::fetch_page_handle(int page_no) const {
 }
 
 /**
- * @description: 创建一个新的page handle
+ * @description: 扩展文件，创建一个新的page handle。新页面直接登记为被调用者认领
  * @return {RmPageHandle} 新的PageHandle
  */
 RmPageHandle RmFileHandle::create_new_page_handle() {
-    // Todo:
-    // 1.使用缓冲池来创建一个新page
-    // 2.更新page handle中的相关信息
-    // 3.更新file_hdr_
-    
+    // 多个插入者可能同时扩展文件，页号的分配和文件头的写回需要互斥
+    std::lock_guard<std::mutex> lock(extend_latch_);
+
     // 1. 使用缓冲池来创建一个新page
     PageId new_page_id(fd_,-1);
     int new_page_no = file_hdr_.num_pages;
@@ -360,58 +416,222 @@ RmPageHandle RmFileHandle::create_new_page_handle() {
     // 2. 初始化新页面的页头信息
     RmPageHandle new_page_handle(&file_hdr_, new_page);
     RmPageHdr *page_hdr = new_page_handle.page_hdr;
-    page_hdr->next_free_page_no = RM_NO_PAGE;
     page_hdr->num_records = 0;
     std::memset(new_page_handle.bitmap, 0, file_hdr_.bitmap_size);
+    if (file_hdr_.is_slotted()) {
+        new_page_handle.init_slotted();
+    }
 
-    // 4. 更新file_hdr_以反映新页面的创建
+    // 3. 更新file_hdr_以反映新页面的创建，新页面在空闲空间表中登记为已认领
     file_hdr_.num_pages++;
-    if (file_hdr_.first_free_page_no == RM_NO_PAGE) {
-        file_hdr_.first_free_page_no = new_page_id.page_no;
-    }
+    fsm_->claim_new(new_page_id.page_no);
 
-    // 5. 将文件头写回磁盘
+    // 4. 将文件头写回磁盘
     disk_manager_->write_page(fd_, RM_FILE_HDR_PAGE, reinterpret_cast<char *>(&file_hdr_), sizeof(file_hdr_));
     return new_page_handle;
 }
 
 /**
- * @brief 创建或获取一个空闲的page handle
+ * @brief 从空闲空间表中认领一个能插入记录的页面，没有时扩展文件
  *
  * @return RmPageHandle 返回生成的空闲page handle
- * @note pin the page, remember to unpin it outside!
+ * @note pin the page, remember to unpin it outside! 用完后调用release_page_handle()归还页面
  */
 RmPageHandle RmFileHandle::create_page_handle() {
-    // Todo:
-    // 1. 判断file_hdr_中是否还有空闲页
-    //     1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
-    //     1.2 有空闲页：直接获取第一个空闲页
-    // 2. 生成page handle并返回给上层
-
-    // 1. 判断file_hdr_中是否还有空闲页
-    if (file_hdr_.first_free_page_no == RM_NO_PAGE) {
-        // 1.1 没有空闲页：使用缓冲池来创建一个新page；可直接调用create_new_page_handle()
-        return create_new_page_handle();
-    } else {
-        // 1.2 有空闲页：直接获取第一个空闲页
-        RmPageHandle page_handle = fetch_page_handle(file_hdr_.first_free_page_no);
-        // 更新file_hdr_以反映被使用的空闲页
-        file_hdr_.first_free_page_no = page_handle.page_hdr->next_free_page_no;
-        return page_handle;
+    // 空闲空间表中的值只是提示(打开文件后未检查过的页面、其他事务修改过的页面)，认领后以页面头为准；
+    // 检查过的页面记下实际的剩余空间，连续检查RM_FSM_MAX_PROBES个页面都不能插入时直接扩展文件，避免一次插入读入整张表
+    for (int probes = 0; probes < RM_FSM_MAX_PROBES; ++probes) {
+        int page_no = fsm_->claim();
+        if (page_no == RM_NO_PAGE) {
+            break;
+        }
+        RmPageHandle page_handle = fetch_page_handle(page_no);
+        if (page_handle.has_room()) {
+            return page_handle;
+        }
+        release_page_handle(page_handle);
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
     }
+    return create_new_page_handle();
 }
 
 /**
- * @description: 当一个页面从没有空闲空间的状态变为有空闲空间状态时，更新文件头和页头中空闲页面相关的元数据
+ * @description: 归还create_page_handle()认领的页面，空闲空间表中记下页面当前的剩余空间
  */
 void RmFileHandle::release_page_handle(RmPageHandle&page_handle) {
-    // Todo:
-    // 当page从已满变成未满，考虑如何更新：
-    // 1. page_handle.page_hdr->next_free_page_no
-    // 2. file_hdr_.first_free_page_no
-
-    // 更新页头中的 next_free_page_no，使其指向之前被标记为第一个有空闲空间的页面
-    page_handle.page_hdr->next_free_page_no = file_hdr_.first_free_page_no;
-    // 更新文件头中的 first_free_page_no，使其指向当前页面
-    file_hdr_.first_free_page_no = page_handle.page->get_page_id().page_no;
+    fsm_->release(page_handle.page->get_page_id().page_no, page_handle.free_level());
+}
+
+/**
+ * @description: 删除或更新记录使页面的剩余空间变化后，更新空闲空间表，不改变页面的认领状态
+ */
+void RmFileHandle::update_free_level(RmPageHandle &page_handle) {
+    fsm_->set_level(page_handle.page->get_page_id().page_no, page_handle.free_level());
+}
+
+/**
+ * @description: 判断更新后的记录能否写回原来的位置，不能时调用者需要删除原记录并在其他页面重新插入
+ * @param {Rid&} rid 记录位置
+ * @param {char*} buf 新记录的数据(定长格式)
+ */
+bool RmFileHandle::can_update_in_place(const Rid &rid, const char *buf) const {
+    if (!file_hdr_.is_slotted()) {
+        return true;
+    }
+    char stored[RM_MAX_STORED_SIZE];
+    int size = encode_record(buf, stored);
+    RmPageHandle page_handle = fetch_page_handle(rid.page_no);
+    bool fit = page_handle.free_space() + page_handle.get_slot_entry(rid.slot_no)->len >= size;
+    buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+    return fit;
+}
+
+/**
+ * @description: 把定长格式的记录编码为slotted page中的存储格式：定长字段原样保存，
+ * 每个变长字段保存为2字节长度加实际内容，末尾的补0不保存
+ * @return {int} 编码后的长度
+ */
+int RmFileHandle::encode_record(const char *buf, char *dest) const {
+    char *p = dest;
+    int pos = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; ++i) {
+        const RmVarCol &col = file_hdr_.var_cols[i];
+        memcpy(p, buf + pos, col.offset - pos);
+        p += col.offset - pos;
+        uint16_t len = static_cast<uint16_t>(strnlen(buf + col.offset, col.len));
+        memcpy(p, &len, sizeof(len));
+        memcpy(p + sizeof(len), buf + col.offset, len);
+        p += sizeof(len) + len;
+        pos = col.offset + col.len;
+    }
+    memcpy(p, buf + pos, file_hdr_.record_size - pos);
+    p += file_hdr_.record_size - pos;
+    return static_cast<int>(p - dest);
+}
+
+/**
+ * @description: 把slotted page中存储的记录解码为定长格式，变长字段补0到最大长度
+ */
+void RmFileHandle::decode_record(const char *src, char *buf) const {
+    int pos = 0;
+    for (int i = 0; i < file_hdr_.num_var_cols; ++i) {
+        const RmVarCol &col = file_hdr_.var_cols[i];
+        memcpy(buf + pos, src, col.offset - pos);
+        src += col.offset - pos;
+        uint16_t len;
+        memcpy(&len, src, sizeof(len));
+        memcpy(buf + col.offset, src + sizeof(len), len);
+        memset(buf + col.offset + len, 0, col.len - len);
+        src += sizeof(len) + len;
+        pos = col.offset + col.len;
+    }
+    memcpy(buf + pos, src, file_hdr_.record_size - pos);
+}
+
+/**
+ * @description: 把定长格式的记录写入slotted page的slot_no，slot_no上已有记录时替换原记录，
+ * slot_no超出slot目录时扩展目录。新记录不长于原记录时原地覆盖，否则在空闲空间中重新分配
+ * @return {bool} 页面空间不足时返回false，页面不做任何修改
+ */
+bool RmFileHandle::put_slotted_record(RmPageHandle &page_handle, int slot_no, const char *buf) {
+    char stored[RM_MAX_STORED_SIZE];
+    int size = encode_record(buf, stored);
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    int old_len = 0;
+    if (slot_no < hdr->num_slots && Bitmap::is_set(page_handle.bitmap, slot_no)) {
+        old_len = page_handle.get_slot_entry(slot_no)->len;
+    }
+    int grow = slot_no < hdr->num_slots ? 0 : (slot_no + 1 - hdr->num_slots) * (int)sizeof(RmSlot);
+    if (page_handle.free_space() + old_len < size + grow) {
+        return false;
+    }
+    if (size <= old_len) {
+        RmSlot *entry = page_handle.get_slot_entry(slot_no);
+        memcpy(page_handle.get_slot_data(slot_no), stored, size);
+        entry->len = static_cast<uint16_t>(size);
+        hdr->live_bytes -= old_len - size;
+        return true;
+    }
+    if (grow > 0) {
+        page_handle.extend_slots(slot_no + 1);
+    }
+    // 原记录的空间先标记为空洞，整理页面时可以回收
+    RmSlot *entry = page_handle.get_slot_entry(slot_no);
+    hdr->live_bytes -= old_len;
+    entry->len = 0;
+    int offset = page_handle.alloc(size);
+    memcpy(page_handle.page->get_data() + offset, stored, size);
+    entry->offset = static_cast<uint16_t>(offset);
+    entry->len = static_cast<uint16_t>(size);
+    return true;
+}
+
+/**
+ * @description: 删除slotted page中slot_no上的记录，调用前bitmap中对应的位已经清除。
+ * 记录占用的空间在整理页面时回收，slot目录末尾空出的项直接收缩
+ */
+void RmFileHandle::remove_slotted_record(RmPageHandle &page_handle, int slot_no) {
+    RmSlottedPageHdr *hdr = page_handle.slotted_hdr;
+    RmSlot *entry = page_handle.get_slot_entry(slot_no);
+    hdr->live_bytes -= entry->len;
+    entry->offset = 0;
+    entry->len = 0;
+    while (hdr->num_slots > 0 && !Bitmap::is_set(page_handle.bitmap, hdr->num_slots - 1)) {
+        hdr->num_slots--;
+    }
+}
+
+/**
+ * @description: 初始化空的slotted page
+ */
+void RmPageHandle::init_slotted() {
+    slotted_hdr->num_slots = 0;
+    slotted_hdr->free_end = PAGE_SIZE;
+    slotted_hdr->live_bytes = 0;
+}
+
+/**
+ * @description: 把slot目录扩展到num_slots项，新增的项为空；调用者保证页面剩余空间足够
+ */
+void RmPageHandle::extend_slots(int num_slots) {
+    int grow = (num_slots - slotted_hdr->num_slots) * (int)sizeof(RmSlot);
+    if (slotted_hdr->free_end - slots_end() < grow) {
+        compact();
+    }
+    memset(page->get_data() + slots_end(), 0, grow);
+    slotted_hdr->num_slots = num_slots;
+}
+
+/**
+ * @description: 在记录数据区分配size字节，连续空闲空间不足时先整理页面；调用者保证页面剩余空间足够
+ * @return {int} 分配到的空间的页内偏移
+ */
+int RmPageHandle::alloc(int size) {
+    if (slotted_hdr->free_end - slots_end() < size) {
+        compact();
+    }
+    assert(slotted_hdr->free_end - slots_end() >= size);
+    slotted_hdr->free_end -= size;
+    slotted_hdr->live_bytes += size;
+    return slotted_hdr->free_end;
+}
+
+/**
+ * @description: 整理页面，把有效记录紧凑地移动到页尾，回收删除和更新留下的空洞，rid保持不变
+ */
+void RmPageHandle::compact() {
+    char buf[PAGE_SIZE];
+    char *data = page->get_data();
+    int pos = PAGE_SIZE;
+    for (int i = 0; i < slotted_hdr->num_slots; ++i) {
+        RmSlot *entry = get_slot_entry(i);
+        if (entry->len == 0 || !Bitmap::is_set(bitmap, i)) {
+            continue;
+        }
+        pos -= entry->len;
+        memcpy(buf + pos, data + entry->offset, entry->len);
+        entry->offset = static_cast<uint16_t>(pos);
+    }
+    memcpy(data + pos, buf + pos, PAGE_SIZE - pos);
+    slotted_hdr->free_end = pos;
 }
@@ -12,11 +12,15 @@ See the Mulan PSL v2 for more details. */
 
 #include <assert.h>
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "bitmap.h"
 #include "common/context.h"
 #include "rm_defs.h"
+#include "rm_free_space_map.h"
 
 class RmManager;
 
@@ -25,12 +29,19 @@ struct RmPageHandle {
     const RmFileHdr *file_hdr;  // 当前页面所在文件的文件头指针
     Page *page;                 // 页面的实际数据，包括页面存储的数据、元信息等
     RmPageHdr *page_hdr;        // page->data的第一部分，存储页面元信息，指针指向首地址，长度为sizeof(RmPageHdr)
+    RmSlottedPageHdr *slotted_hdr;  // slotted page的页头，紧跟在page_hdr之后；定长格式的页面为nullptr
     char *bitmap;               // page->data的第二部分，存储页面的bitmap，指针指向首地址，长度为file_hdr->bitmap_size
-    char *slots;                // page->data的第三部分，存储表的记录，指针指向首地址，每个slot的长度为file_hdr->record_size
+    char *slots;                // page->data的第三部分，定长格式存储表的记录，每个slot的长度为file_hdr->record_size；
+                                // slotted page存储slot目录
 
     RmPageHandle(const RmFileHdr *fhdr_, Page *page_) : file_hdr(fhdr_), page(page_) {
         page_hdr = reinterpret_cast<RmPageHdr *>(page->get_data() + page->OFFSET_PAGE_HDR);
         bitmap = page->get_data() + sizeof(RmPageHdr) + page->OFFSET_PAGE_HDR;
+        slotted_hdr = nullptr;
+        if (file_hdr->is_slotted()) {
+            slotted_hdr = reinterpret_cast<RmSlottedPageHdr *>(bitmap);
+            bitmap += sizeof(RmSlottedPageHdr);
+        }
         slots = bitmap + file_hdr->bitmap_size;
     }
 
@@ -38,6 +49,41 @@ struct RmPageHandle {
     char* get_slot(int slot_no) const {
         return slots + slot_no * file_hdr->record_size;  // slots的首地址 + slot个数 * 每个slot的大小(每个record的大小)
     }
+
+    /* 以下函数只用于slotted page(free_level()和has_room()除外) */
+
+    RmSlot *get_slot_entry(int slot_no) const { return reinterpret_cast<RmSlot *>(slots) + slot_no; }
+
+    // 返回slot_no对应记录在页面中的存储地址
+    char *get_slot_data(int slot_no) const { return page->get_data() + get_slot_entry(slot_no)->offset; }
+
+    // slot目录末尾的页内偏移
+    int slots_end() const {
+        return (int)(slots - page->get_data()) + slotted_hdr->num_slots * (int)sizeof(RmSlot);
+    }
+
+    // 整理页面之后可用的空闲空间
+    int free_space() const { return PAGE_SIZE - slots_end() - slotted_hdr->live_bytes; }
+
+    // 页面还能再插入几条最长的记录，记入空闲空间表
+    int free_level() const {
+        int free_slots = file_hdr->num_records_per_page - page_hdr->num_records;
+        if (slotted_hdr == nullptr) {
+            return free_slots;
+        }
+        return std::min(free_slots, free_space() / (file_hdr->max_stored_size() + (int)sizeof(RmSlot)));
+    }
+
+    // 页面是否还能再插入一条最长的记录
+    bool has_room() const { return free_level() > 0; }
+
+    void init_slotted();
+
+    void extend_slots(int num_slots);
+
+    int alloc(int size);
+
+    void compact();
 };
 
 /* 每个RmFileHandle对应一个表的数据文件，里面有多个page，每个page的数据封装在RmPageHandle中 */
@@ -50,6 +96,8 @@ class RmFileHandle {
     BufferPoolManager *buffer_pool_manager_;
     int fd_;        // 打开文件后产生的文件句柄
     RmFileHdr file_hdr_;    // 文件头，维护当前表文件的元数据
+    std::unique_ptr<RmFreeSpaceMap> fsm_;   // 每个页面的剩余空间，插入时据此认领页面，多个插入者各自使用不同的页面
+    std::mutex extend_latch_;               // 扩展文件时保护file_hdr_.num_pages和文件头的写回
 
    public:
     RmFileHandle(){}
@@ -59,8 +107,13 @@ class RmFileHandle {
         // 这里实际就是初始化file_hdr，只不过是从磁盘中读出进行初始化
         // init file_hdr_
         disk_manager_->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr_, sizeof(file_hdr_));
+        if (file_hdr_.magic != RM_FILE_MAGIC || file_hdr_.version != RM_FILE_VERSION) {
+            throw InternalError("RmFileHandle: unsupported table file format, version " + std::to_string(file_hdr_.version) +
+                                " (expected " + std::to_string(RM_FILE_VERSION) + ")");
+        }
         // disk_manager管理的fd对应的文件中，设置从file_hdr_.num_pages开始分配page_no
         disk_manager_->set_fd2pageno(fd, file_hdr_.num_pages);
+        fsm_ = std::make_unique<RmFreeSpaceMap>(RM_FIRST_RECORD_PAGE, file_hdr_.num_pages);
     }
 
     
@@ -71,31 +124,53 @@ class RmFileHandle {
     /* 判断指定位置上是否已经存在一条记录，通过Bitmap来判断 */
     bool is_record(const Rid &rid) const {
         RmPageHandle page_handle = fetch_page_handle(rid.page_no);
-        return Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        bool exist = Bitmap::is_set(page_handle.bitmap, rid.slot_no);  // page的slot_no位置上是否有record
+        buffer_pool_manager_->unpin_page(page_handle.page->get_page_id(), false);
+        return exist;
     }
 
     std::unique_ptr<RmRecord> get_record(const Rid &rid, Context *context) const;
 
-    Rid insert_record(char *buf, Context *context);
+    Rid insert_record(char *buf, Context *context, const std::function<lsn_t(const Rid &)> &log_insert = nullptr);
 
-    void insert_record(const Rid &rid, char *buf);
+    void insert_record(const Rid &rid, char *buf, Context *context = nullptr);
 
     void delete_record(const Rid &rid, Context *context);
 
     void update_record(const Rid &rid, char *buf, Context *context);
 
-    void insert_record_for_recovery(const Rid& rid, char* buf);
+    void insert_record_for_recovery(const Rid& rid, char* buf, lsn_t lsn = INVALID_LSN);
+
+    void delete_record_for_recovery(const Rid &rid, lsn_t lsn = INVALID_LSN);
+
+    void update_record_for_recovery(const Rid &rid, char *buf, lsn_t lsn = INVALID_LSN);
 
-    void delete_record_for_recovery(const Rid &rid, Context *context);
+    void update_record_for_recovery(const Rid &rid, const std::function<void(char *)> &modify, lsn_t lsn = INVALID_LSN);
 
-    void update_record_for_recovery(const Rid &rid, char *buf, Context *context);
+    bool can_update_in_place(const Rid &rid, const char *buf) const;
 
     RmPageHandle create_new_page_handle();
 
-    RmPageHandle fetch_page_handle(int page_no) const;
+    RmPageHandle fetch_page_handle(int page_no, BufferAccessStrategy *strategy = nullptr) const;
 
    private:
     RmPageHandle create_page_handle();
 
     void release_page_handle(RmPageHandle &page_handle);
+
+    void update_free_level(RmPageHandle &page_handle);
+
+    RmPageHandle fetch_page_handle_for_recovery(int page_no);
+
+    bool skip_for_recovery(RmPageHandle &page_handle, lsn_t lsn);
+
+    static void stamp_page_lsn(Page *page, lsn_t lsn);
+
+    int encode_record(const char *buf, char *dest) const;
+
+    void decode_record(const char *src, char *buf) const;
+
+    bool put_slotted_record(RmPageHandle &page_handle, int slot_no, const char *buf);
+
+    void remove_slotted_record(RmPageHandle &page_handle, int slot_no);
 };
\ No newline at end of file
@@ -0,0 +1,176 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "rm_free_space_map.h"
+
+#include <algorithm>
+#include <mutex>
+
+RmFreeSpaceMap::RmFreeSpaceMap(int first_page, int num_pages)
+    : first_page_(first_page), num_pages_(0), next_page_(first_page) {
+    grow(num_pages);
+    // 最后一个页面最可能还有空闲空间，打开文件后从它开始查找
+    next_page_.store(std::max(first_page_, num_pages - 1), std::memory_order_relaxed);
+}
+
+RmFreeSpaceMap::~RmFreeSpaceMap() {
+    for (auto &chunk : chunks_) {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @description: 新分配的组中记录页面都是未知的，文件头等非记录页面不可插入
+ */
+RmFreeSpaceMap::Chunk::Chunk(int chunk_start, int first_page) {
+    int unknown = 0;
+    for (int i = 0; i < RM_FSM_CHUNK_PAGES; ++i) {
+        uint8_t level = chunk_start + i < first_page ? 0 : RM_FSM_UNKNOWN;
+        levels[i].store(level, std::memory_order_relaxed);
+        unknown += level != 0;
+    }
+    candidates.store(unknown, std::memory_order_relaxed);
+}
+
+/**
+ * @description: 把空闲空间表扩展到num_pages个页面，只扩展组的目录，组在第一次访问时才分配。调用者持有latch_的排他锁
+ */
+void RmFreeSpaceMap::grow(int num_pages) {
+    while ((int)chunks_.size() * RM_FSM_CHUNK_PAGES < num_pages) {
+        chunks_.emplace_back(nullptr);
+    }
+    if (num_pages > num_pages_.load(std::memory_order_relaxed)) {
+        num_pages_.store(num_pages, std::memory_order_release);
+    }
+}
+
+/**
+ * @description: 返回page_no所在的组，组还没有分配时分配它，并发分配时只保留一个。调用者持有latch_
+ */
+RmFreeSpaceMap::Chunk &RmFreeSpaceMap::get_chunk(int page_no) {
+    std::atomic<Chunk *> &entry = chunks_[page_no / RM_FSM_CHUNK_PAGES];
+    Chunk *chunk = entry.load(std::memory_order_acquire);
+    if (chunk == nullptr) {
+        Chunk *fresh = new Chunk(page_no / RM_FSM_CHUNK_PAGES * RM_FSM_CHUNK_PAGES, first_page_);
+        if (entry.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+            chunk = fresh;
+        } else {
+            delete fresh;
+        }
+    }
+    return *chunk;
+}
+
+/**
+ * @description: 用next(旧值)原子地修改页面的字节，并维护所在组的可插入页面个数；页面超出范围时先扩展空闲空间表
+ */
+template <typename F>
+void RmFreeSpaceMap::store(int page_no, F &&next) {
+    if (page_no >= num_pages_.load(std::memory_order_acquire)) {
+        std::unique_lock lock(latch_);
+        grow(page_no + 1);
+    }
+    std::shared_lock lock(latch_);
+    Chunk &chunk = get_chunk(page_no);
+    std::atomic<uint8_t> &s = chunk.levels[page_no % RM_FSM_CHUNK_PAGES];
+    uint8_t old = s.load(std::memory_order_relaxed);
+    uint8_t desired;
+    do {
+        desired = next(old);
+    } while (!s.compare_exchange_weak(old, desired, std::memory_order_acq_rel));
+    int delta = (int)is_candidate(desired) - (int)is_candidate(old);
+    if (delta != 0) {
+        chunk.candidates.fetch_add(delta, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @description: 从上一次认领的页面开始循环查找一个还能插入且没有被认领的页面并认领它
+ * @return {int} 认领到的页面号，没有可插入的页面时返回-1，调用者需要扩展文件
+ * @note 认领到的页面必须通过release()归还
+ */
+int RmFreeSpaceMap::claim() {
+    std::shared_lock lock(latch_);
+    int num_pages = num_pages_.load(std::memory_order_acquire);
+    int total = num_pages - first_page_;
+    int page_no = next_page_.load(std::memory_order_relaxed);
+    if (page_no < first_page_ || page_no >= num_pages) {
+        page_no = first_page_;
+    }
+    for (int visited = 0; visited < total;) {
+        Chunk &chunk = get_chunk(page_no);
+        int chunk_end = std::min(num_pages, (page_no / RM_FSM_CHUNK_PAGES + 1) * RM_FSM_CHUNK_PAGES);
+        if (chunk.candidates.load(std::memory_order_relaxed) == 0) {
+            visited += chunk_end - page_no;
+            page_no = chunk_end;
+        } else {
+            for (; page_no < chunk_end && visited < total; ++page_no, ++visited) {
+                std::atomic<uint8_t> &s = chunk.levels[page_no % RM_FSM_CHUNK_PAGES];
+                uint8_t v = s.load(std::memory_order_relaxed);
+                if ((v & RM_FSM_CLAIMED) == 0 && v != 0 &&
+                    s.compare_exchange_strong(v, v | RM_FSM_CLAIMED, std::memory_order_acq_rel)) {
+                    next_page_.store(page_no, std::memory_order_relaxed);
+                    return page_no;
+                }
+            }
+        }
+        if (page_no >= num_pages) {
+            page_no = first_page_;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @description: 扩展文件得到的新页面直接登记为已认领，由创建它的插入者使用。
+ * 扩展和认领在排他锁内完成，其他插入者查找时不会先看到未被认领的新页面
+ */
+void RmFreeSpaceMap::claim_new(int page_no) {
+    std::unique_lock lock(latch_);
+    grow(page_no + 1);
+    Chunk &chunk = get_chunk(page_no);
+    uint8_t old = chunk.levels[page_no % RM_FSM_CHUNK_PAGES].exchange(RM_FSM_CLAIMED | RM_FSM_UNKNOWN,
+                                                                      std::memory_order_acq_rel);
+    if (!is_candidate(old)) {
+        chunk.candidates.fetch_add(1, std::memory_order_relaxed);
+    }
+    next_page_.store(page_no, std::memory_order_relaxed);
+}
+
+/**
+ * @description: 归还认领的页面，并记下页面当前还能插入的记录条数
+ */
+void RmFreeSpaceMap::release(int page_no, int level) {
+    uint8_t lv = to_level(level);
+    store(page_no, [lv](uint8_t) { return lv; });
+}
+
+/**
+ * @description: 删除或更新记录后修改页面的level，不改变页面的认领状态
+ */
+void RmFreeSpaceMap::set_level(int page_no, int level) {
+    uint8_t lv = to_level(level);
+    store(page_no, [lv](uint8_t old) { return static_cast<uint8_t>((old & RM_FSM_CLAIMED) | lv); });
+}
+
+int RmFreeSpaceMap::get_level(int page_no) const {
+    std::shared_lock lock(latch_);
+    if (page_no < first_page_) {
+        return 0;
+    }
+    if (page_no >= num_pages_.load(std::memory_order_acquire)) {
+        return RM_FSM_UNKNOWN;
+    }
+    Chunk *chunk = chunks_[page_no / RM_FSM_CHUNK_PAGES].load(std::memory_order_acquire);
+    if (chunk == nullptr) {
+        return RM_FSM_UNKNOWN;
+    }
+    return chunk->levels[page_no % RM_FSM_CHUNK_PAGES].load(std::memory_order_relaxed) & ~RM_FSM_CLAIMED;
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+
+/**
+ * @description: 表数据文件的空闲空间表(free space map)。每个页面用一个字节记录填充程度：
+ * 低7位是页面还能插入的记录条数(封顶RM_FSM_MAX_LEVEL)，RM_FSM_UNKNOWN表示打开文件后还没有检查过该页面；
+ * 最高位表示页面已被某个插入者认领，认领期间其他插入者不会选中它，多个线程可以同时向同一张表的不同页面插入。
+ * 空闲空间表只保存在内存中，打开文件时所有页面都是未知的，插入时按需检查页面头并记下结果，
+ * 因此崩溃后不需要恢复；记录的值只是提示，插入者认领页面之后总是以页面头为准。
+ * 页面按RM_FSM_CHUNK_PAGES分组，每组维护可插入页面(level不为0)的个数，查找时跳过没有可插入页面的组；
+ * 组在第一次被访问时才分配，没有分配的组中的页面都是未知的。
+ */
+class RmFreeSpaceMap {
+   public:
+    static constexpr uint8_t RM_FSM_CLAIMED = 0x80;
+    static constexpr uint8_t RM_FSM_UNKNOWN = 0x7f;
+    static constexpr uint8_t RM_FSM_MAX_LEVEL = 0x7e;
+    static constexpr int RM_FSM_CHUNK_PAGES = 4096;
+
+    /**
+     * @param {int} first_page 第一个记录页面的页号，之前的页面(文件头)不参与分配
+     * @param {int} num_pages 文件当前的页面个数，[first_page, num_pages)初始化为未知
+     */
+    RmFreeSpaceMap(int first_page, int num_pages);
+
+    ~RmFreeSpaceMap();
+
+    RmFreeSpaceMap(const RmFreeSpaceMap &) = delete;
+    RmFreeSpaceMap &operator=(const RmFreeSpaceMap &) = delete;
+
+    int claim();
+
+    void claim_new(int page_no);
+
+    void release(int page_no, int level);
+
+    void set_level(int page_no, int level);
+
+    int get_level(int page_no) const;
+
+   private:
+    struct Chunk {
+        std::atomic<uint8_t> levels[RM_FSM_CHUNK_PAGES];
+        std::atomic<int> candidates{0};     // 组内level不为0的页面个数(包括未知和已被认领的页面)
+
+        Chunk(int chunk_start, int first_page);
+    };
+
+    static bool is_candidate(uint8_t v) { return (v & ~RM_FSM_CLAIMED) != 0; }
+
+    static uint8_t to_level(int level) { return static_cast<uint8_t>(std::clamp(level, 0, (int)RM_FSM_MAX_LEVEL)); }
+
+    void grow(int num_pages);
+
+    Chunk &get_chunk(int page_no);
+
+    template <typename F>
+    void store(int page_no, F &&next);
+
+    int first_page_;
+    std::atomic<int> num_pages_;
+    std::atomic<int> next_page_;                    // 下一次查找的起点，认领成功后停在该页面上
+    mutable std::shared_mutex latch_;               // 保护chunks_的扩展，查找和修改level只需要共享锁
+    std::deque<std::atomic<Chunk *>> chunks_;       // 扩展时已有元素的地址不变，组通过CAS分配
+};
@@ -30,23 +30,45 @@ class RmManager {
      * @description: 创建表的数据文件并初始化相关信息
      * @param {string&} filename 要创建的文件名称
      * @param {int} record_size 表中记录的大小
+     * @param {vector<RmVarCol>&} var_cols 变长字段在记录中的位置，按offset升序排列；非空时文件使用slotted page格式
      */ 
-    void create_file(const std::string& filename, int record_size) {
+    void create_file(const std::string& filename, int record_size, const std::vector<RmVarCol>& var_cols = {}) {
         if (record_size < 1 || record_size > RM_MAX_RECORD_SIZE) {
             throw InvalidRecordSizeError(record_size);
         }
+        if (var_cols.size() > RM_MAX_VAR_COLS) {
+            throw InternalError("RmManager::create_file: too many VARCHAR columns");
+        }
         disk_manager_->create_file(filename);
-        int fd = disk_manager_->open_file(filename);
+        int fd = disk_manager_->open_file(filename, true);
 
         // 初始化file header
         RmFileHdr file_hdr{};
+        file_hdr.magic = RM_FILE_MAGIC;
+        file_hdr.version = RM_FILE_VERSION;
         file_hdr.record_size = record_size;
         file_hdr.num_pages = 1;
-        file_hdr.first_free_page_no = RM_NO_PAGE;
-        // We have: sizeof(hdr) + (n + 7) / 8 + n * record_size <= PAGE_SIZE
-        file_hdr.num_records_per_page =
-            (BITMAP_WIDTH * (PAGE_SIZE - 1 - (int)sizeof(RmFileHdr)) + 1) / (1 + record_size * BITMAP_WIDTH);
-        file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        file_hdr.num_var_cols = static_cast<int>(var_cols.size());
+        std::copy(var_cols.begin(), var_cols.end(), file_hdr.var_cols);
+        if (file_hdr.is_slotted()) {
+            // 每条记录至少占用：定长字段 + 每个变长字段的长度 + 一个slot目录项
+            // We have: hdr + (n + 7) / 8 + 3(对齐) + n * (min_size + sizeof(RmSlot)) <= PAGE_SIZE
+            int min_size = file_hdr.max_stored_size();
+            for (auto &col : var_cols) {
+                min_size -= col.len;
+            }
+            int hdr_size = RM_PAGE_HDR_SIZE + (int)sizeof(RmSlottedPageHdr) + 3;
+            file_hdr.num_records_per_page =
+                (BITMAP_WIDTH * (PAGE_SIZE - 1 - hdr_size) + 1) / (1 + (min_size + (int)sizeof(RmSlot)) * BITMAP_WIDTH);
+            // bitmap按4字节对齐，保证slot目录项对齐
+            file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+            file_hdr.bitmap_size = (file_hdr.bitmap_size + 3) / 4 * 4;
+        } else {
+            // We have: hdr + (n + 7) / 8 + n * record_size <= PAGE_SIZE
+            file_hdr.num_records_per_page =
+                (BITMAP_WIDTH * (PAGE_SIZE - 1 - RM_PAGE_HDR_SIZE) + 1) / (1 + record_size * BITMAP_WIDTH);
+            file_hdr.bitmap_size = (file_hdr.num_records_per_page + BITMAP_WIDTH - 1) / BITMAP_WIDTH;
+        }
 
         // 将file header写入磁盘文件（名为file name，文件描述符为fd）中的第0页
         // head page直接写入磁盘，没有经过缓冲区的NewPage，那么也就不需要FlushPage
@@ -69,8 +91,13 @@ class RmManager {
      * @return {unique_ptr<RmFileHandle>} 文件句柄的指针
      */
     std::unique_ptr<RmFileHandle> open_file(const std::string& filename) {
-        int fd = disk_manager_->open_file(filename);
-        return std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
+        int fd = disk_manager_->open_file(filename, true);
+        try {
+            return std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, fd);
+        } catch (RMDBError &) {
+            disk_manager_->close_file(fd);
+            throw;
+        }
     }
 
     /**
@@ -21,6 +21,7 @@ RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
     // 初始化 rid_ 为无效值，以便开始扫描
     rid_.page_no = RM_NO_PAGE;
     rid_.slot_no = -1;
+    strategy_ = file_handle_->buffer_pool_manager_->get_access_strategy(file_handle_->file_hdr_.num_pages);
 
     // 调用 next() 函数查找第一个有效记录
     next();
@@ -29,6 +30,8 @@ RmScan::RmScan(const RmFileHandle *file_handle) : file_handle_(file_handle) {
 /**
  * @brief 找到文件中下一个存放了记录的位置
  */
+RmScan::~RmScan() { release_page(); }
+
 void RmScan::next() {
     
     // Todo:
@@ -37,32 +40,33 @@ void RmScan::next() {
     const RmFileHdr &file_hdr = file_handle_->file_hdr_;
 
     // 开始搜索的页面和槽位
-    int start_page = rid_.page_no;
-    int start_slot = rid_.slot_no;
+    int page_no = rid_.page_no;
+    int slot_no = rid_.slot_no;
 
     // 如果当前rid_是无效的，初始化为第一个记录页面和槽位
-    if (start_page == RM_NO_PAGE) {
-        start_page = RM_FIRST_RECORD_PAGE;
-        start_slot = -1;
+    if (page_no == RM_NO_PAGE) {
+        page_no = RM_FIRST_RECORD_PAGE;
+        slot_no = -1;
     }
 
-    // 遍历页面
-    for (int page_no = start_page; page_no < file_hdr.num_pages; ++page_no) {
-        RmPageHandle page_handle = file_handle_->fetch_page_handle(page_no);
-
-        // 遍历槽位
-        int start_slot_no = (page_no == start_page) ? start_slot+1 : 0;
-        for (int slot_no = start_slot_no; slot_no < file_hdr.num_records_per_page; ++slot_no) {
-            // 检查是否存在记录
-            if (Bitmap::is_set(page_handle.bitmap, slot_no)) {
-                rid_.page_no = page_no;
-                rid_.slot_no = slot_no;
-                return;
-            }
+    // 遍历页面，当前页面已经被pin住时直接在页内继续查找
+    for (; page_no < file_hdr.num_pages; ++page_no, slot_no = -1) {
+        if (page_ == nullptr) {
+            prefetch(page_no);
+            page_ = file_handle_->fetch_page_handle(page_no, strategy_.get()).page;
+        }
+        RmPageHandle page_handle(&file_hdr, page_);
+
+        // 在bitmap中按字查找下一个存放了记录的槽位
+        int slot = Bitmap::next_bit(true, page_handle.bitmap, file_hdr.num_records_per_page, slot_no);
+        if (slot < file_hdr.num_records_per_page) {
+            rid_.page_no = page_no;
+            rid_.slot_no = slot;
+            return;
         }
 
-        // 释放页面
-        file_handle_->buffer_pool_manager_->unpin_page(PageId{file_handle_->fd_, page_no}, false);
+        // 本页面已经扫描完，释放页面
+        release_page();
     }
 
     // 如果没有找到有效记录，设置rid_为无效值
@@ -70,9 +74,6 @@ void RmScan::next() {
     rid_.slot_no = -1;
 }
 
-/**
- * @brief ​ 判断是否到达文件末尾
- */
 bool RmScan::is_end() const {
     // Todo: 修改返回值
    return (rid_.page_no == RM_NO_PAGE && rid_.slot_no == -1);
@@ -85,3 +86,35 @@ Rid RmScan::rid() const {
     return rid_;
 }
 
+/**
+ * @description: 返回当前记录的零拷贝视图，数据位于被pin住的页面中，扫描移动到下一个页面后失效。
+ * slotted page中的记录解码到扫描内部的缓冲区，视图在下一次next()之前有效
+ */
+RmRecordView RmScan::record() const {
+    const RmFileHdr &file_hdr = file_handle_->file_hdr_;
+    RmPageHandle page_handle(&file_hdr, page_);
+    if (file_hdr.is_slotted()) {
+        buf_.resize(file_hdr.record_size);
+        file_handle_->decode_record(page_handle.get_slot_data(rid_.slot_no), buf_.data());
+        return RmRecordView{buf_.data(), file_hdr.record_size};
+    }
+    return RmRecordView{page_handle.get_slot(rid_.slot_no), file_hdr.record_size};
+}
+
+void RmScan::release_page() {
+    if (page_ != nullptr) {
+        file_handle_->buffer_pool_manager_->unpin_page(page_->get_page_id(), false);
+        page_ = nullptr;
+    }
+}
+
+/**
+ * @brief 扫描到page_no时，对其后RM_SCAN_PREFETCH_PAGES个页面中尚未预读的页面发出预读请求
+ */
+void RmScan::prefetch(int page_no) {
+    int last = std::min(page_no + RM_SCAN_PREFETCH_PAGES, file_handle_->file_hdr_.num_pages - 1);
+    for (int p = std::max(prefetched_page_no_, page_no) + 1; p <= last; ++p) {
+        file_handle_->buffer_pool_manager_->prefetch(PageId{file_handle_->fd_, p}, strategy_);
+    }
+    prefetched_page_no_ = std::max(prefetched_page_no_, last);
+}
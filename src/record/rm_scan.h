@@ -10,21 +10,46 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "rm_defs.h"
 
 class RmFileHandle;
 
+/**
+ * 逐页扫描表中的记录：扫描停留在某个页面上时一直pin住该页面，页内通过bitmap定位下一条记录，
+ * 离开页面时才unpin，每个页面只fetch一次。record()返回当前记录的零拷贝视图，在扫描移动到下一个页面之前有效；
+ * slotted page中的变长记录需要解码，视图指向扫描内部的缓冲区，在下一次next()之前有效
+ */
 class RmScan : public RecScan {
     const RmFileHandle *file_handle_;
     Rid rid_;
+    Page *page_ = nullptr;                              // 当前被pin住的页面，扫描结束后为nullptr
+    std::shared_ptr<BufferAccessStrategy> strategy_;    // 大表顺序扫描时使用私有的环，避免冲掉缓冲池中的热点页面
+    int prefetched_page_no_ = RM_NO_PAGE;               // 已经发出预读请求的最大页号
+    mutable std::vector<char> buf_;                     // slotted page中的记录解码到这里，record()返回的视图指向它
 public:
     RmScan(const RmFileHandle *file_handle);
 
+    RmScan(const RmScan &) = delete;
+
+    RmScan &operator=(const RmScan &) = delete;
+
+    ~RmScan() override;
+
     void next() override;
 
     bool is_end() const override;
 
     Rid rid() const override;
 
+    RmRecordView record() const;
+
+private:
+    void prefetch(int page_no);
+
+    void release_page();
+
     
 };
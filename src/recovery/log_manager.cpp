@@ -12,63 +12,291 @@ See the Mulan PSL v2 for more details. */
 #include "log_manager.h"
 #include "transaction/transaction_manager.h"
 
+LogManager::LogManager(DiskManager* disk_manager, BufferPoolManager* buf_mgr) {
+    disk_manager_ = disk_manager;
+    buf_mgr_ = buf_mgr;
+    // 页面第一次被弄脏时，以当前最早的活跃事务的BEGIN lsn作为页面的recLSN
+    buf_mgr_->set_rec_lsn_provider([this] { return get_min_active_lsn(); });
+    // 脏页写回前把页面lsn处的日志记录刷盘。flush_to总是写到已发布日志的结束位置，以lsn + 1为目标即可覆盖整条记录；
+    // 不带lsn的页面(如文件头)读出的值可能超出日志末尾，最多刷到当前的全局lsn
+    buf_mgr_->set_log_flusher([this](lsn_t lsn) { flush_to(std::min(lsn + 1, global_lsn_.load())); });
+    log_writer_ = std::thread(&LogManager::log_writer, this);
+}
+
+LogManager::~LogManager() {
+    buf_mgr_->set_rec_lsn_provider(nullptr);
+    buf_mgr_->set_log_flusher(nullptr);
+    {
+        std::lock_guard<std::mutex> guard(commit_latch_);
+        writer_stop_ = true;
+    }
+    writer_cv_.notify_all();
+    log_writer_.join();
+}
+
+/**
+ * @description: 启动时恢复global_lsn_。日志文件头中的global_lsn只在检查点时更新，是日志结束位置的下界，
+ * 从它开始向后扫描日志尾部，直到文件结束或遇到崩溃时没有写完整的记录，并截掉不完整的部分
+ */
+void LogManager::recovery_log_info() {
+    HeaderRecord h_rec;
+    char buf[HEADER_RECORD_SIZE];
+    disk_manager_->read_log_header(buf, HEADER_RECORD_SIZE);
+    h_rec.deserialize(buf);
+    if (h_rec.log_type_ != LogType::HEADER) {
+        throw InternalError("log typw is not logheader");
+    }
+
+    lsn_t file_size = disk_manager_->get_log_size();
+    lsn_t lsn = h_rec.global_lsn_;
+    if (lsn < HEADER_RECORD_SIZE || lsn > file_size) {
+        lsn = HEADER_RECORD_SIZE;
+    }
+    char rec_hdr[LOG_HEADER_SIZE];
+    while (lsn + LOG_HEADER_SIZE <= file_size && disk_manager_->read_log(rec_hdr, LOG_HEADER_SIZE, lsn) == LOG_HEADER_SIZE) {
+        LogRecord rec;
+        rec.deserialize(rec_hdr);
+        // 没有写完整的记录: lsn与位置不符、类型非法或长度超出文件末尾
+        if (rec.lsn_ != lsn || rec.log_type_ < LogType::UPDATE || rec.log_type_ > LogType::INDEX ||
+            rec.log_tot_len_ < static_cast<uint32_t>(LOG_HEADER_SIZE) || lsn + static_cast<lsn_t>(rec.log_tot_len_) > file_size) {
+            break;
+        }
+        lsn += rec.log_tot_len_;
+    }
+    if (lsn < file_size) {
+        disk_manager_->truncate_log(lsn);
+    }
+    global_lsn_.store(lsn);
+    copied_lsn_.store(lsn);
+    flushed_to_disk_lsn.store(lsn);
+}
+
+/**
+ * @description: 把已经持久化的日志结束位置写入日志文件头，作为下次启动扫描日志尾部的起点。在检查点时调用
+ * @param {lsn_t} checkpoint_lsn 检查点记录的lsn
+ */
+void LogManager::write_log_header(lsn_t checkpoint_lsn) {
+    std::lock_guard<std::mutex> guard(flush_latch_);
+    char buf[HEADER_RECORD_SIZE];
+    disk_manager_->read_log_header(buf, HEADER_RECORD_SIZE);
+    HeaderRecord h_rec;
+    h_rec.deserialize(buf);
+    h_rec.global_lsn_ = flushed_to_disk_lsn.load();
+    h_rec.checkpoint_lsn_ = checkpoint_lsn;
+    h_rec.checkpoint_cnt_++;
+    h_rec.serialize(buf);
+    disk_manager_->write_log_header(buf, HEADER_RECORD_SIZE);
+}
+
 /**
- * @description: 添加日志记录到日志缓冲区中，并返回日志记录号
+ * @description: 添加日志记录到日志缓冲区中，并返回日志记录号。
+ * 日志缓冲区由LOG_BUFFER_NUM个LogBuffer组成环形空间，lsn即日志在文件中的偏移，lsn % (LOG_BUFFER_NUM * LOG_BUFFER_SIZE)为其在环中的位置。
+ * 写入者通过对global_lsn_的CAS预留空间，并行地把日志拷贝到缓冲区中，最后按lsn顺序发布(推进copied_lsn_)。
+ * 一个缓冲区写满后由log writer线程写回，写入者继续使用下一个缓冲区。
+ * 环中没有空间时先刷盘再预留，预留之后不会再失败，否则刷盘出错时预留的空间永远不会发布，之后的写入者和刷盘都会一直等待
  * @param {LogRecord*} log_record 要写入缓冲区的日志记录
  * @return {lsn_t} 返回该日志的日志记录号
  */
 lsn_t LogManager::add_log_to_buffer(LogRecord* log_record) {
-    std::unique_lock<std::mutex> lock(latch_);
-    // 为日志记录分配一个全局唯一的LSN
+    int log_size = log_record->log_tot_len_;
+    if (log_size > LOG_BUFFER_SIZE) {
+        throw InternalError("LogManager::add_log_to_buffer log record too large");
+    }
+    // 1. 为日志记录预留空间，分配一个全局唯一的LSN。环中的空间被尚未落盘的日志占用时，先把已经预留的日志刷盘；
+    //    flushed_to_disk_lsn只会增大，检查时有空间则预留成功后仍然有空间
     lsn_t lsn = global_lsn_.load();
-   
+    while (true) {
+        if (lsn + log_size - flushed_to_disk_lsn.load() > LOG_RING_SIZE) {
+            flush_to(lsn);
+            lsn = global_lsn_.load();
+        } else if (global_lsn_.compare_exchange_weak(lsn, lsn + log_size)) {
+            break;
+        }
+    }
     log_record->lsn_ = lsn;
-    // 序列化日志记录
-    int log_size = log_record->log_tot_len_;
-    char* log_data = new char[log_size];
-    log_record->serialize(log_data);
-    // 检查是否有足够的空间
-    if (log_buffer_.is_full(log_size)) {
-        flush_log_to_disk();
-    }
-    // 将日志记录添加到缓冲区
-    memcpy(log_buffer_.buffer_ + log_buffer_.offset_, log_data, log_size);
-    log_buffer_.offset_ += log_size;
-    
-    log_record->prev_lsn_ = prev_lsn_; 
-    global_lsn_.fetch_add(log_size);
-    prev_lsn_ = lsn;
-
-    //持久化global_lsn到 log file header中
-    int hdr_sz = LOG_HEADER_SIZE+sizeof(lsn_t)*2+sizeof(size_t);
-    char buf[hdr_sz];
-    disk_manager_->read_log_header(buf,hdr_sz);
-    HeaderRecord h_rec;
-    h_rec.deserialize(buf);
-    if(h_rec.log_type_ != LogType::HEADER){
-        throw InternalError("log typw is not logheader");
+
+    // 2. 序列化到缓冲区中，跨越两个缓冲区的记录先序列化到临时空间再分两段拷贝
+    int ring_offset = lsn % LOG_RING_SIZE;
+    LogBuffer &log_buffer = log_buffers_[ring_offset / LOG_BUFFER_SIZE];
+    int buffer_offset = ring_offset % LOG_BUFFER_SIZE;
+    if (buffer_offset + log_size <= LOG_BUFFER_SIZE) {
+        log_record->serialize(log_buffer.buffer_ + buffer_offset);
+    } else {
+        std::vector<char> log_data(log_size);
+        log_record->serialize(log_data.data());
+        int first = LOG_BUFFER_SIZE - buffer_offset;
+        memcpy(log_buffer.buffer_ + buffer_offset, log_data.data(), first);
+        LogBuffer &next_buffer = log_buffers_[(ring_offset / LOG_BUFFER_SIZE + 1) % LOG_BUFFER_NUM];
+        memcpy(next_buffer.buffer_, log_data.data() + first, log_size - first);
     }
-    h_rec.global_lsn_ = global_lsn_.load();
-    h_rec.serialize(buf);
-    disk_manager_->write_log_header(buf,hdr_sz);
+    log_record->prev_lsn_ = prev_lsn_.exchange(lsn);
+    track_active_txn(log_record);
 
-    delete[] log_data;
+    // 3. 按lsn顺序发布，之前的日志都拷贝完成后才能推进copied_lsn_
+    while (copied_lsn_.load(std::memory_order_acquire) != lsn) {
+        std::this_thread::yield();
+    }
+    copied_lsn_.store(lsn + log_size, std::memory_order_release);
+
+    // 4. 写满了一个缓冲区，通知log writer线程写回
+    if (lsn / LOG_BUFFER_SIZE != (lsn + log_size) / LOG_BUFFER_SIZE) {
+        {
+            std::lock_guard<std::mutex> guard(commit_latch_);
+            buffer_full_ = true;
+        }
+        writer_cv_.notify_one();
+    }
     return lsn;
 }
 
 /**
- * @description: 把日志缓冲区的内容刷到磁盘中，由于目前只设置了一个缓冲区，因此需要阻塞其他日志操作
+ * @description: 把日志缓冲区中已经写入的日志刷到磁盘中，不阻塞其他线程追加日志
 */
 void LogManager::flush_log_to_disk() {
-    std::unique_lock<std::mutex> lock(latch_);
-    if (log_buffer_.offset_ > 0) {
-        disk_manager_->write_log(log_buffer_.buffer_, log_buffer_.offset_);
-        // 更新已持久化的LSN
-        flushed_to_disk_lsn = global_lsn_.load();
-        // 重置缓冲区
-        log_buffer_.offset_ = 0;
-        memset(log_buffer_.buffer_, 0, sizeof(log_buffer_.buffer_));
+    flush_to(global_lsn_.load());
+}
+
+/**
+ * @description: 把至少到target_lsn为止的日志写入磁盘并刷盘。等待target_lsn之前预留的日志拷贝完成，
+ * 并顺带写回此时已经发布的所有日志
+ * @param {lsn_t} target_lsn 需要落盘的日志结束位置，必须是日志记录的边界
+ */
+void LogManager::flush_to(lsn_t target_lsn) {
+    if (flushed_to_disk_lsn.load() >= target_lsn) {
+        return;
+    }
+    // 在flush_latch_之外等待: 之前预留的写入者可能正在等待环中的空间，需要先由它们自己刷盘
+    while (copied_lsn_.load(std::memory_order_acquire) < target_lsn) {
+        std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> guard(flush_latch_);
+    lsn_t start_lsn = flushed_to_disk_lsn.load();
+    if (start_lsn >= target_lsn) {
+        return;
+    }
+    lsn_t end_lsn = copied_lsn_.load(std::memory_order_acquire);
+    // 待写回的日志在环中最多分布在LOG_BUFFER_NUM + 1段连续空间中
+    for (lsn_t pos = start_lsn; pos < end_lsn;) {
+        int ring_offset = pos % LOG_RING_SIZE;
+        int buffer_offset = ring_offset % LOG_BUFFER_SIZE;
+        int len = std::min(end_lsn - pos, LOG_BUFFER_SIZE - buffer_offset);
+        disk_manager_->write_log(log_buffers_[ring_offset / LOG_BUFFER_SIZE].buffer_ + buffer_offset, len, pos);
+        pos += len;
+    }
+    disk_manager_->sync_log();
+    // 更新已持久化的LSN，之后环中这部分空间可以被覆盖
+    flushed_to_disk_lsn.store(end_lsn);
+}
+
+/**
+ * @description: 组提交。提交线程登记后在flushed_cv_上等待，由log writer线程把同一批次的日志一次写入并刷盘
+ * @param {lsn_t} end_lsn 提交日志的结束位置，该位置之前的日志落盘后返回
+ */
+void LogManager::group_commit(lsn_t end_lsn) {
+    std::unique_lock<std::mutex> lock(commit_latch_);
+    while (flushed_to_disk_lsn.load() < end_lsn) {
+        waiting_commits_++;
+        writer_cv_.notify_one();
+        flushed_cv_.wait(lock);
     }
 }
 
+/**
+ * @description: 异步提交，不等待日志落盘直接返回。log writer保证end_lsn之前的日志在ASYNC_COMMIT_MAX_DELAY内落盘，
+ * 崩溃时最多丢失这段时间内提交的事务
+ * @param {lsn_t} end_lsn 提交日志的结束位置
+ */
+void LogManager::async_commit(lsn_t end_lsn) {
+    std::lock_guard<std::mutex> guard(commit_latch_);
+    if (flushed_to_disk_lsn.load() >= end_lsn || async_pending_) {
+        return;
+    }
+    async_pending_ = true;
+    async_deadline_ = std::chrono::steady_clock::now() + ASYNC_COMMIT_MAX_DELAY;
+    writer_cv_.notify_one();
+}
+
+/**
+ * @description: log writer线程主循环。有提交在等待时，最多再等待GROUP_COMMIT_MAX_WAIT或攒够GROUP_COMMIT_MAX_BATCH个提交，
+ * 然后刷一次日志并唤醒本批次的所有提交线程。只有异步提交时，等到最早的异步提交到期再刷盘
+ */
+void LogManager::log_writer() {
+    std::unique_lock<std::mutex> lock(commit_latch_);
+    while (true) {
+        writer_cv_.wait(lock, [this] { return writer_stop_ || waiting_commits_ > 0 || async_pending_ || buffer_full_; });
+        if (writer_stop_ && waiting_commits_ == 0 && !async_pending_) {
+            return;
+        }
+        // 缓冲区写满时立即写回，否则等待更多的提交加入本批次
+        if (!buffer_full_ && !writer_stop_) {
+            if (waiting_commits_ > 0) {
+                writer_cv_.wait_for(lock, GROUP_COMMIT_MAX_WAIT,
+                                    [this] { return writer_stop_ || buffer_full_ || waiting_commits_ >= GROUP_COMMIT_MAX_BATCH; });
+            } else {
+                writer_cv_.wait_until(lock, async_deadline_,
+                                      [this] { return writer_stop_ || buffer_full_ || waiting_commits_ > 0; });
+            }
+        }
+        waiting_commits_ = 0;
+        async_pending_ = false;
+        buffer_full_ = false;
+        lock.unlock();
+        try {
+            flush_log_to_disk();
+        } catch (RMDBError &e) {
+            // 刷盘失败时提交线程被唤醒后会重新登记，下一批次重试
+            std::cerr << e.what() << std::endl;
+        }
+        lock.lock();
+        flushed_cv_.notify_all();
+    }
+}
 
+/**
+ * @description: 根据BEGIN/COMMIT/ABORT日志维护活跃事务表
+ */
+void LogManager::track_active_txn(LogRecord* log_record) {
+    if (log_record->log_type_ != LogType::BEGIN && log_record->log_type_ != LogType::COMMIT &&
+        log_record->log_type_ != LogType::ABORT) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(txn_latch_);
+    if (log_record->log_type_ == LogType::BEGIN) {
+        active_txns_[log_record->log_tid_] = log_record->lsn_;
+        active_begin_lsns_.insert(log_record->lsn_);
+        return;
+    }
+    auto it = active_txns_.find(log_record->log_tid_);
+    if (it != active_txns_.end()) {
+        active_begin_lsns_.erase(it->second);
+        active_txns_.erase(it);
+    }
+}
+
+/**
+ * @description: 返回最早的活跃事务的BEGIN日志lsn，没有活跃事务时返回当前的全局lsn。
+ * 在此lsn之前写入的日志对应的修改都已经反映在页面上，因此可以作为新脏页的recLSN(偏保守)
+ */
+lsn_t LogManager::get_min_active_lsn() {
+    std::lock_guard<std::mutex> guard(txn_latch_);
+    if (active_begin_lsns_.empty()) {
+        return global_lsn_.load();
+    }
+    return *active_begin_lsns_.begin();
+}
+
+/**
+ * @description: 获取活跃事务表的快照。先等待已经预留的日志全部发布(发布前已经更新活跃事务表)，保证快照与返回的lsn一致:
+ * BEGIN日志lsn小于返回值的事务，要么在快照中，要么已经结束
+ * @param {vector<pair<txn_id_t, lsn_t>>&} txns 输出<事务id, BEGIN日志的lsn>
+ * @return {lsn_t} 快照时的全局lsn
+ */
+lsn_t LogManager::snapshot_active_txns(std::vector<std::pair<txn_id_t, lsn_t>> &txns) {
+    lsn_t lsn = global_lsn_.load();
+    while (copied_lsn_.load(std::memory_order_acquire) < lsn) {
+        std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> guard(txn_latch_);
+    txns.assign(active_txns_.begin(), active_txns_.end());
+    return lsn;
+}
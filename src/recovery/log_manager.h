@@ -10,7 +10,13 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <algorithm>
+#include <condition_variable>
+#include <map>
 #include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include "log_defs.h"
@@ -27,6 +33,7 @@ enum LogType: int {
     ABORT,
     CHECKPOINT,
     HEADER,
+    INDEX,
 };
 
 
@@ -37,8 +44,9 @@ static std::string LogTypeStr[] = {
     "BEGIN",
     "COMMIT",
     "ABORT",
-    "CHECKPOINT"
-    "HEADER"
+    "CHECKPOINT",
+    "HEADER",
+    "INDEX"
 };
 
 class LogRecord {
@@ -126,30 +134,131 @@ public:
     size_t checkpoint_cnt_;
 };
 
+// 日志文件头(HeaderRecord)的大小，第一条日志记录从该位置开始
+static constexpr int HEADER_RECORD_SIZE = LOG_HEADER_SIZE + sizeof(lsn_t) * 2 + sizeof(size_t);
+
+/**
+ * @description: 检查点日志记录。模糊检查点在记录中保存检查点开始时的日志位置begin_lsn_、
+ * 活跃事务表(事务id, 第一条日志的lsn)以及脏页表(表名, 页号, recLSN)。
+ * 静态检查点不携带负载，log_tot_len_等于LOG_HEADER_SIZE
+ */
 class CheckPointRecord: public LogRecord {
 public:
+    struct DirtyPage {
+        std::string table_name_;
+        page_id_t page_no_;
+        lsn_t rec_lsn_;
+    };
+
     CheckPointRecord(){
         log_type_ = LogType::CHECKPOINT;
         lsn_ = INVALID_LSN;
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
+        begin_lsn_ = INVALID_LSN;
     }
-    
-    // 序列化Begin日志记录到dest中
+
+    // 模糊检查点，begin_lsn为开始收集脏页表之前的全局lsn
+    explicit CheckPointRecord(lsn_t begin_lsn): CheckPointRecord() {
+        begin_lsn_ = begin_lsn;
+        log_tot_len_ += sizeof(lsn_t) + sizeof(size_t) * 2;
+    }
+
+    void add_active_txn(txn_id_t txn_id, lsn_t first_lsn) {
+        active_txns_.emplace_back(txn_id, first_lsn);
+        log_tot_len_ += sizeof(txn_id_t) + sizeof(lsn_t);
+    }
+
+    void add_dirty_page(const std::string &table_name, page_id_t page_no, lsn_t rec_lsn) {
+        dirty_pages_.push_back(DirtyPage{table_name, page_no, rec_lsn});
+        log_tot_len_ += sizeof(size_t) + table_name.size() + sizeof(page_id_t) + sizeof(lsn_t);
+    }
+
+    bool is_fuzzy() const { return begin_lsn_ != INVALID_LSN; }
+
+    // 序列化检查点日志记录到dest中
     void serialize(char* dest) override {
         LogRecord::serialize(dest);
+        if (!is_fuzzy()) return;
+        int offset = OFFSET_LOG_DATA;
+        memcpy(dest + offset, &begin_lsn_, sizeof(lsn_t));
+        offset += sizeof(lsn_t);
+        size_t txn_cnt = active_txns_.size();
+        memcpy(dest + offset, &txn_cnt, sizeof(size_t));
+        offset += sizeof(size_t);
+        for (auto &txn : active_txns_) {
+            memcpy(dest + offset, &txn.first, sizeof(txn_id_t));
+            offset += sizeof(txn_id_t);
+            memcpy(dest + offset, &txn.second, sizeof(lsn_t));
+            offset += sizeof(lsn_t);
+        }
+        size_t page_cnt = dirty_pages_.size();
+        memcpy(dest + offset, &page_cnt, sizeof(size_t));
+        offset += sizeof(size_t);
+        for (auto &page : dirty_pages_) {
+            size_t name_size = page.table_name_.size();
+            memcpy(dest + offset, &name_size, sizeof(size_t));
+            offset += sizeof(size_t);
+            memcpy(dest + offset, page.table_name_.c_str(), name_size);
+            offset += name_size;
+            memcpy(dest + offset, &page.page_no_, sizeof(page_id_t));
+            offset += sizeof(page_id_t);
+            memcpy(dest + offset, &page.rec_lsn_, sizeof(lsn_t));
+            offset += sizeof(lsn_t);
+        }
     }
 
-    // 从src中反序列化出一条Begin日志记录
+    // 从src中反序列化出一条检查点日志记录
     void deserialize(const char* src) override {
-        LogRecord::deserialize(src);   
+        LogRecord::deserialize(src);
+        active_txns_.clear();
+        dirty_pages_.clear();
+        begin_lsn_ = INVALID_LSN;
+        if (log_tot_len_ <= LOG_HEADER_SIZE) return;
+        int offset = OFFSET_LOG_DATA;
+        memcpy(&begin_lsn_, src + offset, sizeof(lsn_t));
+        offset += sizeof(lsn_t);
+        size_t txn_cnt;
+        memcpy(&txn_cnt, src + offset, sizeof(size_t));
+        offset += sizeof(size_t);
+        for (size_t i = 0; i < txn_cnt; ++i) {
+            txn_id_t txn_id;
+            lsn_t first_lsn;
+            memcpy(&txn_id, src + offset, sizeof(txn_id_t));
+            offset += sizeof(txn_id_t);
+            memcpy(&first_lsn, src + offset, sizeof(lsn_t));
+            offset += sizeof(lsn_t);
+            active_txns_.emplace_back(txn_id, first_lsn);
+        }
+        size_t page_cnt;
+        memcpy(&page_cnt, src + offset, sizeof(size_t));
+        offset += sizeof(size_t);
+        for (size_t i = 0; i < page_cnt; ++i) {
+            DirtyPage page;
+            size_t name_size;
+            memcpy(&name_size, src + offset, sizeof(size_t));
+            offset += sizeof(size_t);
+            page.table_name_.assign(src + offset, name_size);
+            offset += name_size;
+            memcpy(&page.page_no_, src + offset, sizeof(page_id_t));
+            offset += sizeof(page_id_t);
+            memcpy(&page.rec_lsn_, src + offset, sizeof(lsn_t));
+            offset += sizeof(lsn_t);
+            dirty_pages_.push_back(std::move(page));
+        }
     }
 
     virtual void format_print() override {
         std::cout << "log type in son_function: " << LogTypeStr[log_type_] << "\n";
         LogRecord::format_print();
+        printf("begin_lsn: %d\n", begin_lsn_);
+        printf("active txns: %zu, dirty pages: %zu\n", active_txns_.size(), dirty_pages_.size());
     }
+
+    lsn_t begin_lsn_;                                       // 检查点开始时的全局lsn
+    std::vector<std::pair<txn_id_t, lsn_t>> active_txns_;  // 活跃事务表
+    std::vector<DirtyPage> dirty_pages_;                    // 脏页表
 };
 
 
@@ -248,6 +357,13 @@ public:
     }
 };
 
+// 数据修改日志中记录镜像的紧凑格式: 4字节长度 + 数据，不记录RmRecord::allocated_
+inline int serialize_image(char *dest, const RmRecord &rec) {
+    memcpy(dest, &rec.size, sizeof(int));
+    memcpy(dest + sizeof(int), rec.data, rec.size);
+    return sizeof(int) + rec.size;
+}
+
 class InsertLogRecord: public LogRecord {
 public:
     InsertLogRecord() {
@@ -256,59 +372,50 @@ public:
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
+        table_id_ = -1;
     }
 
-    InsertLogRecord(txn_id_t txn_id, RmRecord& insert_value, Rid& rid, std::string table_name) 
+    InsertLogRecord(txn_id_t txn_id, RmRecord& insert_value, Rid& rid, int table_id) 
         : InsertLogRecord() {
         log_tid_ = txn_id;
         insert_value_ = insert_value;
         rid_ = rid;
-        log_tot_len_ +=  insert_value.getSize();
-        log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.size();
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        table_id_ = table_id;
+        log_tot_len_ += sizeof(int) + sizeof(Rid) + sizeof(int) + insert_value_.size;
     }
 
-    // 把insert日志记录序列化到dest中
+    // 把insert日志记录序列化到dest中: table_id | rid | 插入的记录
     void serialize(char* dest) override {
         LogRecord::serialize(dest);
         int offset = OFFSET_LOG_DATA;
-        offset += insert_value_.serialize(dest+offset);
+        memcpy(dest + offset, &table_id_, sizeof(int));
+        offset += sizeof(int);
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
+        serialize_image(dest + offset, insert_value_);
     }
 
     // 从src中反序列化出一条Insert日志记录
     void deserialize(const char* src) override {
         LogRecord::deserialize(src);  
         int offset = OFFSET_LOG_DATA;
-        offset += insert_value_.desrialize(src+OFFSET_LOG_DATA);
+        table_id_ = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
         rid_ = *reinterpret_cast<const Rid*>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t*>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_] ;
-        memcpy(table_name_, src + offset, table_name_size_);
+        insert_value_.Deserialize(src + offset);
     }
     void format_print() override {
         printf("insert record\n");
         LogRecord::format_print();
         printf("insert_value: %s\n", insert_value_.data);
         printf("insert rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table id: %d\n", table_id_);
     }
 
     RmRecord insert_value_;     // 插入的记录
     Rid rid_;                   // 记录插入的位置
-    char* table_name_;          // 插入记录的表名称
-    size_t table_name_size_;    // 表名称的大小
-    //std::unordered_set<Page*> page_set_;    // 插入记录时修改的页面
+    int table_id_;              // 插入记录的表编号(TabMeta::id)
 };
 
 /**
@@ -322,50 +429,38 @@ DeleteLogRecord() {
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
+        table_id_ = -1;
     }
 
-    DeleteLogRecord(txn_id_t txn_id, RmRecord& delete_value, Rid& rid, std::string table_name) 
+    DeleteLogRecord(txn_id_t txn_id, RmRecord& delete_value, Rid& rid, int table_id) 
         : DeleteLogRecord() {
         log_tid_ = txn_id;
         delete_value_ = delete_value;
         rid_ = rid;
-        log_tot_len_ += delete_value_.getSize();
-        log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.size();
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        table_id_ = table_id;
+        log_tot_len_ += sizeof(int) + sizeof(Rid) + sizeof(int) + delete_value_.size;
     }
 
-    // 把delete日志记录序列化到dest中
+    // 把delete日志记录序列化到dest中: table_id | rid | 删除的记录
     void serialize(char* dest) override {
         LogRecord::serialize(dest);
         int offset = OFFSET_LOG_DATA;
-        // memcpy(dest + offset, &delete_value_.size, sizeof(int));
-        // offset += sizeof(int);
-        // memcpy(dest + offset, delete_value_.data, delete_value_.size);
-        // offset += delete_value_.size;
-        offset += delete_value_.serialize(dest+offset);
+        memcpy(dest + offset, &table_id_, sizeof(int));
+        offset += sizeof(int);
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
+        serialize_image(dest + offset, delete_value_);
     }
 
     // 从src中反序列化出一条Delete日志记录
     void deserialize(const char* src) override {
         LogRecord::deserialize(src);  
-        //delete_value_.Deserialize(src + OFFSET_LOG_DATA);
         int offset = OFFSET_LOG_DATA;
-        offset +=delete_value_.desrialize(src+offset);
+        table_id_ = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
         rid_ = *reinterpret_cast<const Rid*>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t*>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, src + offset, table_name_size_);
+        delete_value_.Deserialize(src + offset);
     }
 
     void format_print() override {
@@ -373,102 +468,274 @@ DeleteLogRecord() {
         LogRecord::format_print();
         printf("delete_value: %s\n", delete_value_.data);
         printf("delete rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table id: %d\n", table_id_);
     }
 
     RmRecord delete_value_;     // 删除的记录
     Rid rid_;                   // 记录删除的位置
-    char* table_name_;          // 删除记录的表名称
-    size_t table_name_size_;    // 表名称的大小
-
+    int table_id_;              // 删除记录的表编号(TabMeta::id)
 };
 
 /**
  * TODO: update操作的日志记录
+ * 只记录发生变化的字节区间(delta)，每个区间记录偏移、长度、更新前和更新后的字节。
+ * 间隔小于UPDATE_DELTA_MERGE_GAP的区间合并为一个，避免区间头的开销超过节省的字节
 */
 class UpdateLogRecord: public LogRecord {
 public:
+    struct Range {
+        uint16_t offset_;       // 区间在记录中的偏移
+        uint16_t len_;          // 区间长度
+    };
+
       UpdateLogRecord() {
         log_type_ = LogType::UPDATE;
         lsn_ = INVALID_LSN;
         log_tot_len_ = LOG_HEADER_SIZE;
         log_tid_ = INVALID_TXN_ID;
         prev_lsn_ = INVALID_LSN;
-        table_name_ = nullptr;
+        table_id_ = -1;
     }
 
-    UpdateLogRecord(txn_id_t txn_id, RmRecord& old_value, RmRecord& new_value, Rid& rid, std::string table_name) 
+    UpdateLogRecord(txn_id_t txn_id, RmRecord& old_value, RmRecord& new_value, Rid& rid, int table_id) 
         : UpdateLogRecord() {
         log_tid_ = txn_id;
-        old_value_ = old_value;
-        new_value_ = new_value;
         rid_ = rid;
-        //log_tot_len_ += sizeof(int) * 2;
-        log_tot_len_+= old_value_.getSize() + new_value_.getSize();
-        //log_tot_len_ += old_value_.size + new_value_.size;
-        log_tot_len_ += sizeof(Rid);
-        table_name_size_ = table_name.size();
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, table_name.c_str(), table_name_size_);
-        log_tot_len_ += sizeof(size_t) + table_name_size_;
+        table_id_ = table_id;
+        diff(old_value.data, new_value.data, std::min(old_value.size, new_value.size), ranges_, &old_bytes_, new_bytes_);
+        log_tot_len_ += sizeof(int) + sizeof(Rid) + sizeof(uint16_t) + ranges_.size() * sizeof(Range) + old_bytes_.size() * 2;
+    }
+
+    /**
+     * @description: 找出old_data和new_data前size个字节中不同的字节区间，追加到ranges中
+     * @param {string*} old_bytes 追加各区间更新前的字节，为nullptr时不记录(只用于redo的日志)
+     * @param {string&} new_bytes 追加各区间更新后的字节
+     */
+    static void diff(const char *old_data, const char *new_data, int size, std::vector<Range> &ranges,
+                     std::string *old_bytes, std::string &new_bytes) {
+        for (int i = 0; i < size;) {
+            if (old_data[i] == new_data[i]) {
+                i++;
+                continue;
+            }
+            int end = i + 1;
+            for (int same = 0; end < size && same < UPDATE_DELTA_MERGE_GAP; end++) {
+                same = old_data[end] == new_data[end] ? same + 1 : 0;
+            }
+            // 去掉区间末尾相同的字节
+            while (old_data[end - 1] == new_data[end - 1]) end--;
+            ranges.push_back({static_cast<uint16_t>(i), static_cast<uint16_t>(end - i)});
+            if (old_bytes != nullptr) old_bytes->append(old_data + i, end - i);
+            new_bytes.append(new_data + i, end - i);
+            i = end;
+        }
     }
 
-    // 把update日志记录序列化到dest中
+    // 把update日志记录序列化到dest中: table_id | rid | 区间个数 | 区间 | 更新前的字节 | 更新后的字节
     void serialize(char* dest) override {
         LogRecord::serialize(dest);
         int offset = OFFSET_LOG_DATA;
-        // memcpy(dest + offset, &old_value_.size, sizeof(int));
-        // offset += sizeof(int);
-        // memcpy(dest + offset, old_value_.data, old_value_.size);
-        // offset += old_value_.size;
-        // memcpy(dest + offset, &new_value_.size, sizeof(int));
-        // offset += sizeof(int);
-        // memcpy(dest + offset, new_value_.data, new_value_.size);
-        // offset += new_value_.size;
-        offset += old_value_.serialize(dest+offset);
-        offset += new_value_.serialize(dest+offset);
+        memcpy(dest + offset, &table_id_, sizeof(int));
+        offset += sizeof(int);
         memcpy(dest + offset, &rid_, sizeof(Rid));
         offset += sizeof(Rid);
-        memcpy(dest + offset, &table_name_size_, sizeof(size_t));
-        offset += sizeof(size_t);
-        memcpy(dest + offset, table_name_, table_name_size_);
+        uint16_t range_num = ranges_.size();
+        memcpy(dest + offset, &range_num, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        memcpy(dest + offset, ranges_.data(), range_num * sizeof(Range));
+        offset += range_num * sizeof(Range);
+        memcpy(dest + offset, old_bytes_.data(), old_bytes_.size());
+        offset += old_bytes_.size();
+        memcpy(dest + offset, new_bytes_.data(), new_bytes_.size());
     }
 
     // 从src中反序列化出一条Update日志记录
     void deserialize(const char* src) override {
         LogRecord::deserialize(src);  
-        //old_value_.Deserialize(src + OFFSET_LOG_DATA);
-        //int offset = OFFSET_LOG_DATA + old_value_.size + sizeof(int);
-        //new_value_.Deserialize(src + offset);
-        //offset += new_value_.size + sizeof(int);
         int offset = OFFSET_LOG_DATA;
-        offset += old_value_.desrialize(src+offset);
-        offset += new_value_.desrialize(src+offset);
+        table_id_ = *reinterpret_cast<const int*>(src + offset);
+        offset += sizeof(int);
         rid_ = *reinterpret_cast<const Rid*>(src + offset);
         offset += sizeof(Rid);
-        table_name_size_ = *reinterpret_cast<const size_t*>(src + offset);
-        offset += sizeof(size_t);
-        table_name_ = new char[table_name_size_];
-        memcpy(table_name_, src + offset, table_name_size_);
+        uint16_t range_num = *reinterpret_cast<const uint16_t*>(src + offset);
+        offset += sizeof(uint16_t);
+        ranges_.resize(range_num);
+        memcpy(ranges_.data(), src + offset, range_num * sizeof(Range));
+        offset += range_num * sizeof(Range);
+        size_t bytes = 0;
+        for (auto &range : ranges_) bytes += range.len_;
+        old_bytes_.assign(src + offset, bytes);
+        new_bytes_.assign(src + offset + bytes, bytes);
     }
 
+    // 把更新后的字节写入记录，用于redo
+    void apply_new(char *rec) const { apply(rec, new_bytes_); }
+
+    // 把更新前的字节写回记录，用于undo
+    void apply_old(char *rec) const { apply(rec, old_bytes_); }
+
     void format_print() override {
         printf("update record\n");
         LogRecord::format_print();
-        printf("old_value: %s\n", old_value_.data);
-        printf("new_value: %s\n", new_value_.data);
+        printf("update ranges: %zu, bytes: %zu\n", ranges_.size(), new_bytes_.size());
         printf("update rid: %d, %d\n", rid_.page_no, rid_.slot_no);
-        printf("table name: %s\n", table_name_);
+        printf("table id: %d\n", table_id_);
     }
 
-    RmRecord old_value_;        // 更新前的记录
-    RmRecord new_value_;        // 更新后的记录
     Rid rid_;                   // 记录更新的位置
-    char* table_name_;          // 更新记录的表名称
-    size_t table_name_size_;    // 表名称的大小
-
+    int table_id_;              // 更新记录的表编号(TabMeta::id)
+    std::vector<Range> ranges_; // 发生变化的字节区间
+    std::string old_bytes_;     // 各区间更新前的字节，按区间顺序拼接
+    std::string new_bytes_;     // 各区间更新后的字节，按区间顺序拼接
+
+private:
+    void apply(char *rec, const std::string &bytes) const {
+        size_t pos = 0;
+        for (auto &range : ranges_) {
+            memcpy(rec + range.offset_, bytes.data() + pos, range.len_);
+            pos += range.len_;
+        }
+    }
 };
 
+/**
+ * @description: 索引修改日志。一次插入/删除(包括其中的分裂、合并和重分配)修改的所有索引页面记在同一条日志中，
+ * 每个页面只记录发生变化的字节区间和变化后的字节；文件头发生变化时附带整个文件头。
+ * 索引日志只用于redo，不回滚，未提交事务留下的索引项在恢复结束时按记录修复。
+ * create_为true的日志由建立索引写入，扫描到它之前的同名索引文件的日志都不再重做
+ */
+class IndexLogRecord: public LogRecord {
+public:
+    struct PageDelta {
+        page_id_t page_no_;
+        std::vector<UpdateLogRecord::Range> ranges_;   // 发生变化的字节区间
+        std::string bytes_;                             // 各区间修改后的字节，按区间顺序拼接
+    };
+
+    IndexLogRecord() {
+        log_type_ = LogType::INDEX;
+        lsn_ = INVALID_LSN;
+        log_tot_len_ = LOG_HEADER_SIZE;
+        log_tid_ = INVALID_TXN_ID;
+        prev_lsn_ = INVALID_LSN;
+        create_ = false;
+    }
+
+    IndexLogRecord(txn_id_t txn_id, const std::string &index_name, bool create = false) : IndexLogRecord() {
+        log_tid_ = txn_id;
+        index_name_ = index_name;
+        create_ = create;
+        log_tot_len_ += sizeof(size_t) + index_name_.size() + sizeof(bool) + sizeof(int) + sizeof(uint16_t);
+    }
+
+    // 记录页面从old_data到new_data的变化，页面没有变化时不记录
+    void add_page(page_id_t page_no, const char *old_data, const char *new_data) {
+        PageDelta page{page_no, {}, {}};
+        UpdateLogRecord::diff(old_data, new_data, PAGE_SIZE, page.ranges_, nullptr, page.bytes_);
+        if (page.ranges_.empty()) return;
+        log_tot_len_ += sizeof(page_id_t) + sizeof(uint16_t) + page.ranges_.size() * sizeof(UpdateLogRecord::Range) +
+                        page.bytes_.size();
+        pages_.push_back(std::move(page));
+    }
+
+    // 记录修改后的文件头
+    void set_file_hdr(const std::string &file_hdr) {
+        log_tot_len_ += file_hdr.size() - file_hdr_.size();
+        file_hdr_ = file_hdr;
+    }
+
+    // 把index日志记录序列化到dest中: 索引文件名 | create | 文件头 | 页面个数 | 每个页面的(页号, 区间个数, 区间, 修改后的字节)
+    void serialize(char* dest) override {
+        LogRecord::serialize(dest);
+        int offset = OFFSET_LOG_DATA;
+        size_t name_size = index_name_.size();
+        memcpy(dest + offset, &name_size, sizeof(size_t));
+        offset += sizeof(size_t);
+        memcpy(dest + offset, index_name_.data(), name_size);
+        offset += name_size;
+        memcpy(dest + offset, &create_, sizeof(bool));
+        offset += sizeof(bool);
+        int hdr_len = file_hdr_.size();
+        memcpy(dest + offset, &hdr_len, sizeof(int));
+        offset += sizeof(int);
+        memcpy(dest + offset, file_hdr_.data(), hdr_len);
+        offset += hdr_len;
+        uint16_t page_num = pages_.size();
+        memcpy(dest + offset, &page_num, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        for (auto &page : pages_) {
+            memcpy(dest + offset, &page.page_no_, sizeof(page_id_t));
+            offset += sizeof(page_id_t);
+            uint16_t range_num = page.ranges_.size();
+            memcpy(dest + offset, &range_num, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+            memcpy(dest + offset, page.ranges_.data(), range_num * sizeof(UpdateLogRecord::Range));
+            offset += range_num * sizeof(UpdateLogRecord::Range);
+            memcpy(dest + offset, page.bytes_.data(), page.bytes_.size());
+            offset += page.bytes_.size();
+        }
+    }
+
+    // 从src中反序列化出一条Index日志记录
+    void deserialize(const char* src) override {
+        LogRecord::deserialize(src);
+        int offset = OFFSET_LOG_DATA;
+        size_t name_size;
+        memcpy(&name_size, src + offset, sizeof(size_t));
+        offset += sizeof(size_t);
+        index_name_.assign(src + offset, name_size);
+        offset += name_size;
+        memcpy(&create_, src + offset, sizeof(bool));
+        offset += sizeof(bool);
+        int hdr_len;
+        memcpy(&hdr_len, src + offset, sizeof(int));
+        offset += sizeof(int);
+        file_hdr_.assign(src + offset, hdr_len);
+        offset += hdr_len;
+        uint16_t page_num;
+        memcpy(&page_num, src + offset, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        pages_.resize(page_num);
+        for (auto &page : pages_) {
+            memcpy(&page.page_no_, src + offset, sizeof(page_id_t));
+            offset += sizeof(page_id_t);
+            uint16_t range_num;
+            memcpy(&range_num, src + offset, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+            page.ranges_.resize(range_num);
+            memcpy(page.ranges_.data(), src + offset, range_num * sizeof(UpdateLogRecord::Range));
+            offset += range_num * sizeof(UpdateLogRecord::Range);
+            size_t bytes = 0;
+            for (auto &range : page.ranges_) bytes += range.len_;
+            page.bytes_.assign(src + offset, bytes);
+            offset += bytes;
+        }
+    }
+
+    // 把日志中page_no页面的修改写入页面数据，用于redo
+    void apply(page_id_t page_no, char *data) const {
+        for (auto &page : pages_) {
+            if (page.page_no_ != page_no) continue;
+            size_t pos = 0;
+            for (auto &range : page.ranges_) {
+                memcpy(data + range.offset_, page.bytes_.data() + pos, range.len_);
+                pos += range.len_;
+            }
+        }
+    }
+
+    void format_print() override {
+        printf("index record\n");
+        LogRecord::format_print();
+        printf("index: %s, create: %d, header bytes: %zu, pages: %zu\n", index_name_.c_str(), create_,
+               file_hdr_.size(), pages_.size());
+    }
+
+    std::string index_name_;            // 索引文件名
+    bool create_;                       // 是否为建立索引时写入的日志
+    std::string file_hdr_;              // 修改后序列化的文件头，文件头没有变化时为空
+    std::vector<PageDelta> pages_;      // 修改过的页面
+};
 
 
 /* 日志缓冲区，只有一个buffer，因此需要阻塞地去把日志写入缓冲区中 */
@@ -500,40 +767,57 @@ public:
 /* 日志管理器，负责把日志写入日志缓冲区，以及把日志缓冲区中的内容写入磁盘中 */
 class LogManager {
 public:
-    LogManager(DiskManager* disk_manager,BufferPoolManager* buf_mgr) { 
-        disk_manager_ = disk_manager;
-        buf_mgr_ = buf_mgr;
-    }
+    LogManager(DiskManager* disk_manager,BufferPoolManager* buf_mgr);
 
-    void recovery_log_info(){
-        //恢复global_lsn_
-        int hdr_sz = LOG_HEADER_SIZE+sizeof(lsn_t)*2+sizeof(size_t);
-        char buf[hdr_sz];
-        disk_manager_->read_log_header(buf,hdr_sz);
-        HeaderRecord h_rec;
-        h_rec.deserialize(buf);
+    ~LogManager();
 
-        if(h_rec.log_type_ != LogType::HEADER){
-            throw InternalError("log typw is not logheader");
-        }
-        global_lsn_.store(h_rec.global_lsn_);
-    }
+    void recovery_log_info();
+    void write_log_header(lsn_t checkpoint_lsn);
     
     lsn_t add_log_to_buffer(LogRecord* log_record);
     void flush_log_to_disk();
+    void group_commit(lsn_t end_lsn);
+    void async_commit(lsn_t end_lsn);
+
+    lsn_t get_global_lsn() { return global_lsn_.load(); }
+    lsn_t get_min_active_lsn();
+    lsn_t snapshot_active_txns(std::vector<std::pair<txn_id_t, lsn_t>> &txns);
 
     BufferPoolManager* get_bp(){return buf_mgr_;}
     DiskManager* get_dm(){return disk_manager_;}
-private:    
-    std::atomic<lsn_t> global_lsn_{0};  // 全局lsn，递增，用于为每条记录分发lsn
+private:
+    void flush_to(lsn_t target_lsn);
+    void track_active_txn(LogRecord* log_record);
+    void log_writer();
+
+    static constexpr int LOG_RING_SIZE = LOG_BUFFER_NUM * LOG_BUFFER_SIZE;
+
+    std::atomic<lsn_t> global_lsn_{0};  // 全局lsn，递增，写入者通过CAS为每条记录预留空间并分发lsn
+    std::atomic<lsn_t> copied_lsn_{0};  // 已经拷贝到缓冲区并发布的日志的结束位置，按lsn顺序推进(flushed_to_disk_lsn<=copied_lsn_<=global_lsn_)
              
-    lsn_t flushed_to_disk_lsn;          // 记录已经持久化到磁盘中的最后一条日志的日志号(flushed_to_disk_lsn<=global_lsn_)
+    std::atomic<lsn_t> flushed_to_disk_lsn{0};  // 已经持久化到磁盘中的日志的结束位置(flushed_to_disk_lsn<=global_lsn_)
     
-    std::mutex latch_;                  // 用于对log_buffer_的互斥访问
-    LogBuffer log_buffer_;              // 日志缓冲区
+    std::mutex flush_latch_;                        // 同一时刻只有一个线程写回日志
+    LogBuffer log_buffers_[LOG_BUFFER_NUM];         // 日志缓冲区，组成按lsn寻址的环形空间
     DiskManager* disk_manager_;
     
-    lsn_t prev_lsn_ = 0;
+    std::atomic<lsn_t> prev_lsn_{0};
+
+    // 活跃事务表: 事务id -> 该事务BEGIN日志的lsn，用于脏页的recLSN和模糊检查点
+    std::mutex txn_latch_;                      // 保护active_txns_和active_begin_lsns_
+    std::map<txn_id_t, lsn_t> active_txns_;
+    std::set<lsn_t> active_begin_lsns_;         // 活跃事务BEGIN日志的lsn，有序，首元素即最小值
+
+    // 组提交: 提交线程登记后等待，log writer线程攒够一批(或等待超时)后统一刷盘
+    std::thread log_writer_;
+    std::mutex commit_latch_;                   // 保护waiting_commits_、async_pending_、buffer_full_和writer_stop_
+    std::condition_variable writer_cv_;         // 通知log writer有新的提交在等待
+    std::condition_variable flushed_cv_;        // 通知提交线程一批日志已经落盘
+    size_t waiting_commits_ = 0;                // 等待本批次刷盘的提交个数
+    bool async_pending_ = false;                // 有异步提交的日志还没有落盘
+    std::chrono::steady_clock::time_point async_deadline_;  // 最早的未落盘异步提交必须刷盘的时间
+    bool buffer_full_ = false;                  // 有缓冲区已经写满，需要立即写回
+    bool writer_stop_ = false;
 
     //TransactionManager* txn_mgr_;
     BufferPoolManager* buf_mgr_;
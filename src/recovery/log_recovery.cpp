@@ -9,51 +9,51 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "log_recovery.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 #include "record/rm_file_handle.h"
+#include "record_printer.h"
+#include "system/sm_manager.h"
+
+// 返回从start到现在经过的毫秒数
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
 /**
  * @description: analyze阶段，需要获得脏页表（DPT）和未完成的事务列表（ATT）
  */
 void RecoveryManager::analyze() { 
+    auto start = std::chrono::steady_clock::now();
     //读取最新检查点位置
     char buf[sizeof(lsn_t)];
     disk_manager_->read_start_file(buf,sizeof(lsn_t),0);
     lsn_t c_lsn;
    
     memcpy(&c_lsn,buf,sizeof(lsn_t));
-    if(c_lsn == -1){//checkpoint不存在，从头开始读取logfile
-        c_lsn = 0;
+    if(c_lsn == -1){//checkpoint不存在，从日志文件头之后的第一条日志开始读取
+        c_lsn = HEADER_RECORD_SIZE;
+        redo_lsn_ = c_lsn;
     }else{
-        //检查当前位置是否为checkpoint_record.
-        int sz  = disk_manager_->read_log(buffer_.buffer_,LOG_HEADER_SIZE,c_lsn);
-        if(sz == -1)
-            throw InternalError("read log error");
-        LogRecord cp_record;
-        cp_record.deserialize(buffer_.buffer_);
-        if(cp_record.log_type_ != LogType::CHECKPOINT){
-            throw InternalError("checkpoint record type error");
-        }
-        buffer_.clear();
-        c_lsn += LOG_HEADER_SIZE;
-    }
-    
-    char l_buf[sizeof(uint32_t)];
-    if(-1 ==disk_manager_->read_log(l_buf,sizeof(uint32_t),c_lsn+OFFSET_LOG_TOT_LEN)){
-        //当前日志为空
-        return;
+        c_lsn = read_checkpoint(c_lsn);
     }
     
-    uint32_t rec_tot_len;
-    memcpy(&rec_tot_len,&l_buf,sizeof(uint32_t));
-
-    //从checkpoint之后开始读取log文件
-    while(-1 != disk_manager_->read_log(buffer_.buffer_,rec_tot_len,c_lsn)){
+    //从checkpoint(模糊检查点为脏页表和活跃事务表中最早的lsn)开始顺序读取log文件，每次读入一整块日志
+    const char *rec_buf;
+    while((rec_buf = read_record(c_lsn)) != nullptr){
         LogRecord rec;
-        rec.deserialize(buffer_.buffer_);
+        rec.deserialize(rec_buf);
+        stats_.records_scanned++;
 
         UpdateLogRecord ur;
         InsertLogRecord ir;
         DeleteLogRecord dr;
+        IndexLogRecord xr;
 
         switch(rec.log_type_){
                 case LogType::BEGIN:
@@ -62,147 +62,579 @@ void RecoveryManager::analyze() {
                 case LogType::COMMIT:
                 case LogType::ABORT:
                         att_.erase(rec.log_tid_);
-                        if(rec.log_type_ == LogType::COMMIT){
-                            //事务已经提交，将涉及的页面从undo_list中删除
-                            for(auto &dp :undo_list_){
-                                auto& logs = dp.second.undo_logs_;
-                                for (auto it = logs.begin(); it != logs.end(); ) {
-                                    if (it->second == rec.log_tid_) {
-                                        it = logs.erase(it);
-                                    } else {
-                                        ++it;
-                                    }
-                                }
-                            }
-                        }
+                        //事务已经提交，或者已经回滚完成(回滚的补偿操作也写了日志，重做时一并重做)，不需要回滚
+                        txn_logs_.erase(rec.log_tid_);
                         break;
                 case LogType::UPDATE:
-                        ur.deserialize(buffer_.buffer_);
+                        ur.deserialize(rec_buf);
                         //将数据修改操作记录
-                        if(att_.count(rec.log_tid_)){
-                                std::string name = std::string(ur.table_name_,ur.table_name_size_);
-                                int fd = disk_manager_->get_file_fd(name);
-                                PageId pid(fd,ur.rid_.page_no);
-                                redo_list_[pid].redo_logs_.push_back(std::make_pair(ur.lsn_,ur.log_tid_));
-                                undo_list_[pid].undo_logs_.push_back(std::make_pair(ur.lsn_,ur.log_tid_));  
-                                tb_set_.insert(fd);
-                        }
+                        add_data_log(ur.lsn_, ur.log_tot_len_, ur.log_tid_, ur.table_id_, ur.rid_);
                         break;
                 case LogType::INSERT:
-                        ir.deserialize(buffer_.buffer_);
-                        if(att_.count(rec.log_tid_)){
-                                std::string name = std::string(ir.table_name_,ir.table_name_size_);
-                                int fd = disk_manager_->get_file_fd(name);
-                                PageId pid(fd,ir.rid_.page_no);
-                                redo_list_[pid].redo_logs_.push_back(std::make_pair(ir.lsn_,ir.log_tid_));
-                                undo_list_[pid].undo_logs_.push_back(std::make_pair(ir.lsn_,ir.log_tid_));
-                                tb_set_.insert(fd);
-                        }
+                        ir.deserialize(rec_buf);
+                        add_data_log(ir.lsn_, ir.log_tot_len_, ir.log_tid_, ir.table_id_, ir.rid_);
                         break;
                 case LogType::DELETE:
-                        dr.deserialize(buffer_.buffer_);
-                        if(att_.count(rec.log_tid_)){
-                                std::string name = std::string(dr.table_name_,dr.table_name_size_);
-                                int fd = disk_manager_->get_file_fd(name);
-                                PageId pid(fd,dr.rid_.page_no);
-                                redo_list_[pid].redo_logs_.push_back(std::make_pair(dr.lsn_,dr.log_tid_));
-                                undo_list_[pid].undo_logs_.push_back(std::make_pair(dr.lsn_,dr.log_tid_));
-                                tb_set_.insert(fd);
-                        }
+                        dr.deserialize(rec_buf);
+                        add_data_log(dr.lsn_, dr.log_tot_len_, dr.log_tid_, dr.table_id_, dr.rid_);
+                        break;
+                case LogType::INDEX:
+                        xr.deserialize(rec_buf);
+                        add_index_log(xr);
                         break;
+                case LogType::CHECKPOINT:
                 case LogType::HEADER:
                         break;
                 default:
                         throw InternalError("error log_record type");
         }
-        buffer_.clear();
         c_lsn+=rec.log_tot_len_;
+    }
+    //索引被删除后又重新建立时，建立之前的日志属于旧的索引文件，不再重做
+    redo_logs_.erase(std::remove_if(redo_logs_.begin(), redo_logs_.end(), [&](const std::pair<lsn_t, PageId> &log) {
+        auto it = index_create_lsn_.find(log.second.fd);
+        return it != index_create_lsn_.end() && log.first < it->second;
+    }), redo_logs_.end());
+    //未提交事务的修改按页面分组，每个页面内按lsn逆序回滚
+    std::unordered_set<lsn_t> undo_lsns;
+    for(auto &txn : txn_logs_){
+        for(auto &log : txn.second){
+            undo_list_[std::get<2>(log)].undo_logs_.push_back(std::make_pair(std::get<0>(log), std::get<1>(log)));
+            undo_lsns.insert(std::get<0>(log));
+        }
+    }
+    //已提交事务的索引修改都在提交之前写了日志，redo之后与数据一致，只有被回滚的记录需要修复索引。
+    //重启后事务ID从0重新分配，因此按日志而不是按事务ID判断记录是否被回滚
+    for(auto &table : index_rids_){
+        for(auto it = table.second.begin(); it != table.second.end();){
+            auto &lsns = it->second.lsns_;
+            bool undone = std::any_of(lsns.begin(), lsns.end(), [&](lsn_t lsn) { return undo_lsns.count(lsn) > 0; });
+            it = undone ? std::next(it) : table.second.erase(it);
+        }
+    }
+    for(auto &up : undo_list_){
+        std::sort(up.second.undo_logs_.begin(), up.second.undo_logs_.end());
+    }
 
-        //读取下一条log_record的长度
-        if(-1 == disk_manager_->read_log(l_buf,sizeof(uint32_t),c_lsn+OFFSET_LOG_TOT_LEN)){
-            break;
-        };
-        memcpy(&rec_tot_len,&l_buf,sizeof(uint32_t));
+    std::unordered_set<PageId, PageIdHash> pages;
+    for(auto &log : redo_logs_){
+        pages.insert(log.second);
+    }
+    for(auto &up : undo_list_){
+        pages.insert(up.first);
     }
+    stats_.pages_touched = pages.size();
+    stats_.redo_records = redo_logs_.size();
+    stats_.undo_txns = txn_logs_.size();
+    stats_.analyze_ms = elapsed_ms(start);
 }
 
 /**
- * @description: 重做所有未落盘的操作
+ * @description: 返回日志窗口中lsn处的完整日志记录，记录不完全在窗口中时返回nullptr
  */
-void RecoveryManager::redo() {
-    for(const auto& dp : redo_list_){
-        auto& redo_lsns = dp.second.redo_logs_;
-        
-        auto rm_file_hdr = new RmFileHandle(disk_manager_,buffer_pool_manager_,dp.first.fd);
-        //顺序执行日志修改每个数据页
-        for(auto& redo_lsn : redo_lsns){
-            lsn_t lsn = redo_lsn.first;
-            char l_buf[LOG_HEADER_SIZE];
-            disk_manager_->read_log(l_buf,LOG_HEADER_SIZE,lsn);
-            LogRecord rec;
-            rec.deserialize(l_buf);
-            
-            char record_buf[rec.log_tot_len_];
-            disk_manager_->read_log(record_buf,rec.log_tot_len_,lsn);
+const char *RecoveryManager::record_in_window(lsn_t lsn) {
+    lsn_t window_end = window_start_ + window_size_;
+    if(lsn < window_start_ || lsn + LOG_HEADER_SIZE > window_end){
+        return nullptr;
+    }
+    const char *rec = buffer_.buffer_ + (lsn - window_start_);
+    uint32_t rec_tot_len = *reinterpret_cast<const uint32_t *>(rec + OFFSET_LOG_TOT_LEN);
+    if(rec_tot_len < static_cast<uint32_t>(LOG_HEADER_SIZE) || lsn + static_cast<lsn_t>(rec_tot_len) > window_end){
+        return nullptr;
+    }
+    return rec;
+}
 
-            if(rec.log_type_ == LogType::INSERT){
-                InsertLogRecord ir;
-                ir.deserialize(record_buf);
-                std::cout<<"redo insert ["<<ir.rid_.page_no<<","<<ir.rid_.slot_no<<"],"<<std::string(ir.insert_value_.data,ir.insert_value_.size)<<std::endl;
-                rm_file_hdr->insert_record_for_recovery(ir.rid_,ir.insert_value_.data);
+/**
+ * @description: 顺序读取日志记录。记录不在日志窗口中时，从lsn开始把一整块日志读入buffer_，代替逐条读取日志头和日志体
+ * @return {const char*} 指向buffer_中的日志记录，窗口移动后失效；到达日志末尾时返回nullptr
+ * @param {lsn_t} lsn 日志记录的lsn
+ */
+const char *RecoveryManager::read_record(lsn_t lsn) {
+    const char *rec = record_in_window(lsn);
+    if(rec != nullptr){
+        return rec;
+    }
+    int size = disk_manager_->read_log(buffer_.buffer_, LOG_BUFFER_SIZE, lsn);
+    if(size <= 0){
+        return nullptr;
+    }
+    stats_.bytes_read += size;
+    window_start_ = lsn;
+    window_size_ = size;
+    return record_in_window(lsn);
+}
 
-            }else if(rec.log_type_ == LogType::UPDATE){
-                UpdateLogRecord ur;
-                ur.deserialize(record_buf);
-                std::cout<<"redo update ["<<ur.rid_.page_no<<","<<ur.rid_.slot_no<<"],"<<std::string(ur.new_value_.data,ur.new_value_.size)<<std::endl;
-                rm_file_hdr->update_record_for_recovery(ur.rid_,ur.new_value_.data,nullptr);
+/**
+ * @description: 读取检查点记录，恢复检查点时的脏页表和活跃事务表
+ * @return {lsn_t} analyze开始扫描日志的位置
+ * @param {lsn_t} c_lsn 检查点记录的lsn
+ */
+lsn_t RecoveryManager::read_checkpoint(lsn_t c_lsn) {
+    //检查当前位置是否为checkpoint_record.
+    int sz  = disk_manager_->read_log(buffer_.buffer_,LOG_HEADER_SIZE,c_lsn);
+    if(sz == -1)
+        throw InternalError("read log error");
+    LogRecord cp_header;
+    cp_header.deserialize(buffer_.buffer_);
+    if(cp_header.log_type_ != LogType::CHECKPOINT){
+        throw InternalError("checkpoint record type error");
+    }
+    if(-1 == disk_manager_->read_log(buffer_.buffer_,cp_header.log_tot_len_,c_lsn))
+        throw InternalError("read log error");
+    stats_.bytes_read += cp_header.log_tot_len_;
+    CheckPointRecord cp_record;
+    cp_record.deserialize(buffer_.buffer_);
+    buffer_.clear();
 
-            }else if(rec.log_type_ == LogType::DELETE){
-                DeleteLogRecord dr;
-                dr.deserialize(record_buf);
-                std::cout<<"redo delete ["<<dr.rid_.page_no<<","<<dr.rid_.slot_no<<"],"<<std::string(dr.delete_value_.data,dr.delete_value_.size)<<std::endl;
-                rm_file_hdr->delete_record_for_recovery(dr.rid_,nullptr);
+    lsn_t scan_lsn = c_lsn + cp_record.log_tot_len_;
+    if(!cp_record.is_fuzzy()){
+        //静态检查点之前的修改已经全部落盘
+        redo_lsn_ = scan_lsn;
+        return scan_lsn;
+    }
+    redo_lsn_ = cp_record.begin_lsn_;
+    scan_lsn = std::min(scan_lsn, redo_lsn_);
+    for(auto &txn : cp_record.active_txns_){
+        ckpt_att_.insert(txn.first);
+        scan_lsn = std::min(scan_lsn, txn.second);
+    }
+    for(auto &page : cp_record.dirty_pages_){
+        if(page.rec_lsn_ == INVALID_LSN) continue;
+        auto key = std::make_pair(page.table_name_, page.page_no_);
+        auto it = redo_start_.find(key);
+        if(it == redo_start_.end() || page.rec_lsn_ < it->second){
+            redo_start_[key] = page.rec_lsn_;
+        }
+        scan_lsn = std::min(scan_lsn, page.rec_lsn_);
+    }
+    return scan_lsn;
+}
+
+/**
+ * @description: 判断一条数据修改日志是否需要重做。
+ *  redo_lsn_之后的日志全部重做；之前的日志只有页面在脏页表中且不早于其recLSN时才重做。
+ *  检查点时仍活跃的事务可能先写日志、在脏页表收集之后才修改页面，因此它们的日志也要重做，
+ *  并且该页面之后的日志都要按顺序重做，保证页面上的修改顺序不变
+ */
+bool RecoveryManager::need_redo(lsn_t lsn, txn_id_t txn_id, const std::string &tab_name, page_id_t page_no) {
+    if(lsn >= redo_lsn_) return true;
+    auto key = std::make_pair(tab_name, page_no);
+    auto it = redo_start_.find(key);
+    if(it != redo_start_.end() && lsn >= it->second) return true;
+    if(ckpt_att_.count(txn_id)){
+        redo_start_[key] = lsn;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @description: 记录一条数据修改日志，加入页面的redo/undo列表。事务在提交之前都视为未完成
+ * @param {uint32_t} log_len 日志记录的长度
+ * @param {int} table_id 日志中记录的表编号(TabMeta::id)
+ * @param {Rid&} rid 修改的记录位置
+ */
+void RecoveryManager::add_data_log(lsn_t lsn, uint32_t log_len, txn_id_t txn_id, int table_id, const Rid &rid) {
+    //日志中只记录表编号，表已经被删除时不需要redo/undo
+    const TabMeta *tab = sm_manager_->db_.get_table(table_id);
+    if(tab == nullptr){
+        return;
+    }
+    const std::string &tab_name = tab->name;
+    int fd = disk_manager_->get_file_fd(tab_name);
+    PageId pid(fd, rid.page_no);
+    att_.insert(txn_id);
+    if(need_redo(lsn, txn_id, tab_name, rid.page_no)){
+        redo_logs_.push_back(std::make_pair(lsn, pid));
+    }
+    txn_logs_[txn_id].emplace_back(lsn, log_len, pid);
+    //回滚不修改索引，被回滚的记录在恢复结束后逐条修复索引，为此记下扫描范围内修改记录的所有日志
+    if(!tab->indexes.empty()){
+        auto &versions = index_rids_[fd][std::make_pair(rid.page_no, rid.slot_no)];
+        versions.lsns_.push_back(lsn);
+    }
+}
+
+/**
+ * @description: 记录一条索引日志，日志中修改的每个页面分别加入redo列表。索引日志不回滚
+ * @param {IndexLogRecord&} log 索引日志
+ */
+void RecoveryManager::add_index_log(const IndexLogRecord &log) {
+    //索引已经被删除时不需要redo
+    auto ih = sm_manager_->ihs_.find(log.index_name_);
+    if(ih == sm_manager_->ihs_.end()){
+        return;
+    }
+    int fd = ih->second->get_ix_file_fd();
+    if(log.create_){
+        index_create_lsn_[fd] = log.lsn_;
+    }
+    if(!log.file_hdr_.empty()){
+        index_hdrs_[fd] = log.file_hdr_;
+    }
+    for(auto &page : log.pages_){
+        if(need_redo(log.lsn_, log.log_tid_, log.index_name_, page.page_no_)){
+            redo_logs_.push_back(std::make_pair(log.lsn_, PageId(fd, page.page_no_)));
+        }
+    }
+}
+
+/**
+ * @description: 索引页面在日志之后才写回，要重做的页面可能还不在索引文件中。
+ *  把索引文件扩展到要重做的最大页面(中间的空洞读出为全0，与新分配的页面相同)，之后分配的页号从它后面开始
+ */
+void RecoveryManager::prepare_index_redo() {
+    std::unordered_set<int> index_fds;
+    for(auto &ih : sm_manager_->ihs_){
+        index_fds.insert(ih.second->get_ix_file_fd());
+    }
+    std::unordered_map<int, page_id_t> max_page_no;
+    for(auto &log : redo_logs_){
+        if(index_fds.count(log.second.fd)){
+            auto &max_no = max_page_no.emplace(log.second.fd, 0).first->second;
+            max_no = std::max(max_no, log.second.page_no);
+        }
+    }
+    std::vector<char> zero_page(PAGE_SIZE, 0);
+    for(auto &[fd, page_no] : max_page_no){
+        int file_pages = disk_manager_->get_file_size(disk_manager_->get_file_name(fd)) / PAGE_SIZE;
+        if(page_no >= file_pages){
+            disk_manager_->write_page(fd, page_no, zero_page.data(), PAGE_SIZE);
+        }
+        disk_manager_->set_fd2pageno(fd, std::max(disk_manager_->get_fd2pageno(fd), page_no + 1));
+    }
+}
+
+/**
+ * @description: 在一个redo线程中按顺序重做分配给它的日志。同一页面的日志只会分配给同一个线程，页面上的修改顺序不变；
+ *  每个线程使用自己的RmFileHandle，线程之间不共享文件头
+ * @param {vector<pair<const char *, PageId>>} &records 日志记录(指向日志窗口)和修改的页面
+ * @param {unordered_map<int, unique_ptr<RmFileHandle>>} &file_handles 该线程已经打开的表文件句柄
+ */
+static void redo_records(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager,
+                         const std::vector<std::pair<const char *, PageId>> &records,
+                         std::unordered_map<int, std::unique_ptr<RmFileHandle>> &file_handles) {
+    for(auto &entry : records){
+        LogRecord rec;
+        rec.deserialize(entry.first);
+        //页面lsn不早于日志lsn时，修改已经在页面上，跳过
+        if(rec.log_type_ == LogType::INDEX){
+            IndexLogRecord xr;
+            xr.deserialize(entry.first);
+            Page *page = buffer_pool_manager->fetch_page(entry.second);
+            bool redo = page->get_page_lsn() < xr.lsn_;
+            if(redo){
+                xr.apply(entry.second.page_no, page->get_data());
+                page->set_page_lsn(xr.lsn_);
             }
+            buffer_pool_manager->unpin_page(entry.second, redo);
+            continue;
+        }
+        auto &rm_file_hdr = file_handles[entry.second.fd];
+        if(rm_file_hdr == nullptr){
+            rm_file_hdr = std::make_unique<RmFileHandle>(disk_manager, buffer_pool_manager, entry.second.fd);
+        }
+        if(rec.log_type_ == LogType::INSERT){
+            InsertLogRecord ir;
+            ir.deserialize(entry.first);
+            rm_file_hdr->insert_record_for_recovery(ir.rid_, ir.insert_value_.data, ir.lsn_);
+        }else if(rec.log_type_ == LogType::UPDATE){
+            UpdateLogRecord ur;
+            ur.deserialize(entry.first);
+            rm_file_hdr->update_record_for_recovery(ur.rid_, [&](char *slot) { ur.apply_new(slot); }, ur.lsn_);
+        }else if(rec.log_type_ == LogType::DELETE){
+            DeleteLogRecord dr;
+            dr.deserialize(entry.first);
+            rm_file_hdr->delete_record_for_recovery(dr.rid_, dr.lsn_);
+        }
+    }
+}
+
+/**
+ * @description: 重做所有未落盘的操作。
+ *  顺序地把日志一块一块读入日志窗口，窗口中需要重做的日志按PageId分配给RECOVERY_REDO_THREAD_NUM个线程并行重做，
+ *  一个窗口重做完之后再读入下一个窗口。重做完成后记录被回滚的记录的各个版本，用于修复索引
+ */
+void RecoveryManager::redo() {
+    auto start = std::chrono::steady_clock::now();
+    size_t thread_num = std::max<size_t>(RECOVERY_REDO_THREAD_NUM, 1);
+    std::vector<std::vector<std::pair<const char *, PageId>>> partitions(thread_num);
+    std::vector<std::unordered_map<int, std::unique_ptr<RmFileHandle>>> file_handles(thread_num);
+    PageIdHash hasher;
+    prepare_index_redo();
+
+    size_t i = 0;
+    while(i < redo_logs_.size()){
+        const char *rec = read_record(redo_logs_[i].first);
+        if(rec == nullptr){
+            throw InternalError("read log error");
+        }
+        //把当前窗口中需要重做的日志按页面分组
+        do{
+            const PageId &pid = redo_logs_[i].second;
+            partitions[hasher(pid) % thread_num].push_back(std::make_pair(rec, pid));
+            i++;
+        }while(i < redo_logs_.size() && (rec = record_in_window(redo_logs_[i].first)) != nullptr);
+
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(thread_num);
+        for(size_t t = 0; t < thread_num; t++){
+            if(partitions[t].empty()) continue;
+            threads.emplace_back([&, t]{
+                try {
+                    redo_records(disk_manager_, buffer_pool_manager_, partitions[t], file_handles[t]);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for(auto &thread : threads){
+            thread.join();
+        }
+        for(auto &error : errors){
+            if(error) std::rethrow_exception(error);
         }
+        for(auto &partition : partitions){
+            partition.clear();
+        }
+    }
+    //索引文件头取扫描范围内最新的一份，与重做之后的索引页面一致
+    for(auto &[fd, hdr] : index_hdrs_){
+        sm_manager_->ihs_.at(disk_manager_->get_file_name(fd))->set_file_hdr(hdr);
     }
+    collect_record_versions();
+    stats_.redo_ms = elapsed_ms(start);
 }
 
 /**
- * @description: 回滚未完成的事务
+ * @description: 回滚未完成的事务。与redo一样每张表只打开一个RmFileHandle，每条日志按analyze时记下的长度一次读入
  */
 void RecoveryManager::undo() {
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<int, std::unique_ptr<RmFileHandle>> file_handles;
+    std::vector<char> record_buf;
     for(const auto& up : undo_list_ ){
         auto& undo_lsns = up.second.undo_logs_;
-        auto rm_file_hdr = new RmFileHandle(disk_manager_,buffer_pool_manager_,up.first.fd);
+        auto &rm_file_hdr = file_handles[up.first.fd];
+        if(rm_file_hdr == nullptr){
+            rm_file_hdr = std::make_unique<RmFileHandle>(disk_manager_, buffer_pool_manager_, up.first.fd);
+        }
         //逆序执行日志回滚每个数据页
         for(auto undo_lsn = undo_lsns.rbegin(); undo_lsn != undo_lsns.rend(); ++undo_lsn){
             lsn_t lsn = undo_lsn->first;
-            char l_buf[LOG_HEADER_SIZE];
-            disk_manager_->read_log(l_buf,LOG_HEADER_SIZE,lsn);
+            int log_len = static_cast<int>(undo_lsn->second);
+            record_buf.resize(log_len);
+            if(disk_manager_->read_log(record_buf.data(), log_len, lsn) != log_len){
+                throw InternalError("read log error");
+            }
             LogRecord rec;
-            rec.deserialize(l_buf);
-            
-            char record_buf[rec.log_tot_len_];
-            disk_manager_->read_log(record_buf,rec.log_tot_len_,lsn);
+            rec.deserialize(record_buf.data());
+            stats_.bytes_read += log_len;
+            stats_.undo_records++;
 
             if(rec.log_type_ == LogType::INSERT){
                 InsertLogRecord ir;
-                ir.deserialize(record_buf);
-                std::cout<<"undo insert rollback ["<<ir.rid_.page_no<<","<<ir.rid_.slot_no<<"],"<<std::string(ir.insert_value_.data,ir.insert_value_.size)<<std::endl;
-                rm_file_hdr->delete_record_for_recovery(ir.rid_,nullptr);
+                ir.deserialize(record_buf.data());
+                rm_file_hdr->delete_record_for_recovery(ir.rid_);
 
             }else if(rec.log_type_ == LogType::UPDATE){
                 UpdateLogRecord ur;
-                ur.deserialize(record_buf);
-                std::cout<<"undo update rollback ["<<ur.rid_.page_no<<","<<ur.rid_.slot_no<<"],"<<std::string(ur.old_value_.data,ur.old_value_.size)<<std::endl;
-                rm_file_hdr->update_record_for_recovery(ur.rid_,ur.old_value_.data,nullptr);
+                ur.deserialize(record_buf.data());
+                rm_file_hdr->update_record_for_recovery(ur.rid_,[&](char *slot) { ur.apply_old(slot); });
 
             }else if(rec.log_type_ == LogType::DELETE){
                 DeleteLogRecord dr;
-                dr.deserialize(record_buf);
-                std::cout<<"undo delete rollback ["<<dr.rid_.page_no<<","<<dr.rid_.slot_no<<"],"<<std::string(dr.delete_value_.data,dr.delete_value_.size)<<std::endl;
+                dr.deserialize(record_buf.data());
                 rm_file_hdr->insert_record_for_recovery(dr.rid_,dr.delete_value_.data);
             }
         }
     }
+    stats_.undo_ms = elapsed_ms(start);
+}
+
+
+/**
+ * @description: redo之后页面上是每条被修改记录的最新版本，沿日志倒推出该记录在扫描范围内出现过的所有版本。
+ *  被回滚的事务修改记录时留下的索引项可能是其中任意一个版本的，修复索引时需要删除这些版本留下的旧索引项
+ */
+void RecoveryManager::collect_record_versions() {
+    for(auto &table : index_rids_){
+        RmFileHandle rm_file_hdr(disk_manager_, buffer_pool_manager_, table.first);
+        for(auto &entry : table.second){
+            Rid rid{entry.first.first, entry.first.second};
+            auto &versions = entry.second;
+            std::unique_ptr<RmRecord> cur = rm_file_hdr.is_record(rid) ? rm_file_hdr.get_record(rid, nullptr) : nullptr;
+            for(auto lsn = versions.lsns_.rbegin(); lsn != versions.lsns_.rend(); ++lsn){
+                if(cur != nullptr){
+                    versions.images_.emplace_back(cur->data, cur->size);
+                }
+                char l_buf[LOG_HEADER_SIZE];
+                disk_manager_->read_log(l_buf, LOG_HEADER_SIZE, *lsn);
+                LogRecord rec;
+                rec.deserialize(l_buf);
+                std::vector<char> record_buf(rec.log_tot_len_);
+                disk_manager_->read_log(record_buf.data(), rec.log_tot_len_, *lsn);
+                stats_.bytes_read += LOG_HEADER_SIZE + rec.log_tot_len_;
+
+                //由该日志之后的版本得到之前的版本
+                if(rec.log_type_ == LogType::INSERT){
+                    cur = nullptr;
+                }else if(rec.log_type_ == LogType::DELETE){
+                    DeleteLogRecord dr;
+                    dr.deserialize(record_buf.data());
+                    cur = std::make_unique<RmRecord>(dr.delete_value_);
+                }else if(rec.log_type_ == LogType::UPDATE && cur != nullptr){
+                    UpdateLogRecord ur;
+                    ur.deserialize(record_buf.data());
+                    ur.apply_old(cur->data);
+                }
+            }
+            if(cur != nullptr){
+                versions.images_.emplace_back(cur->data, cur->size);
+            }
+        }
+    }
+}
+
+/**
+ * @description: 在undo之后修复索引。索引的修改都写了INDEX日志，redo之后的B+树是崩溃前最后一次索引操作完成后的状态，
+ *  与已提交事务的数据一致；undo只回滚数据，因此只修复被回滚的记录的索引项，代价与回滚的记录数成正比而与表的大小无关。
+ *  修复某个索引失败时(例如日志损坏导致B+树不一致)，删除并重建该索引
+ */
+void RecoveryManager::recover_indexes() {
+    auto start = std::chrono::steady_clock::now();
+    for(auto &table : index_rids_){
+        stats_.index_records += table.second.size();
+        std::string tab_name = disk_manager_->get_file_name(table.first);
+        TabMeta tab = sm_manager_->db_.get_table(tab_name);
+        RmFileHandle rm_file_hdr(disk_manager_, buffer_pool_manager_, table.first);
+        for(auto &index : tab.indexes){
+            try {
+                repair_index(&rm_file_hdr, index, table.second);
+            } catch (RMDBError &e) {
+                std::cerr << "repair index on " << tab_name << " failed: " << e.what() << ", rebuild it" << std::endl;
+                std::vector<std::string> col_names;
+                for(auto &col : index.cols) col_names.push_back(col.name);
+                sm_manager_->drop_index(tab_name, col_names, nullptr);
+                sm_manager_->create_index(tab_name, col_names, nullptr, index.key_type);
+                stats_.indexes_rebuilt++;
+            }
+        }
+    }
+    index_rids_.clear();
+    stats_.index_ms = elapsed_ms(start);
+}
+
+/**
+ * @description: 修复一个索引中被修改过的记录的索引项。先删除所有旧版本留下的、仍指向该记录的索引项，
+ *  再为当前存在的记录补上缺失的索引项。索引的删除和插入都先查询，重复执行结果不变
+ * @param {RmFileHandle*} fh 表文件句柄
+ * @param {IndexMeta&} index 索引元数据
+ * @param {map<pair<page_id_t, int>, RecordVersions>} &records 被修改过的记录
+ */
+void RecoveryManager::repair_index(RmFileHandle *fh, const IndexMeta &index,
+                                   std::map<std::pair<page_id_t, int>, RecordVersions> &records) {
+    auto ih = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(index.tab_name, index.cols)).get();
+    auto make_key = [&](const char *data) {
+        std::string key;
+        for(auto &col : index.cols){
+            key.append(data + col.offset, col.len);
+        }
+        return key;
+    };
+
+    std::vector<std::pair<std::string, Rid>> current;  // 当前存在的记录的索引项
+    for(auto &entry : records){
+        Rid rid{entry.first.first, entry.first.second};
+        std::string cur_key;
+        bool exist = fh->is_record(rid);
+        if(exist){
+            cur_key = make_key(fh->get_record(rid, nullptr)->data);
+            current.emplace_back(cur_key, rid);
+        }
+        std::set<std::string> old_keys;
+        for(auto &image : entry.second.images_){
+            std::string key = make_key(image.data());
+            if(!exist || key != cur_key) old_keys.insert(key);
+        }
+        for(auto &key : old_keys){
+            std::vector<Rid> result;
+            if(ih->get_value(key.data(), &result, nullptr) && !result.empty() && result[0] == rid){
+                ih->delete_entry(key.data(), nullptr);
+            }
+        }
+    }
+    for(auto &entry : current){
+        std::vector<Rid> result;
+        if(!ih->get_value(entry.first.data(), &result, nullptr)){
+            ih->insert_entry(entry.first.data(), entry.second, nullptr);
+        }
+    }
+}
+
+std::vector<std::pair<std::string, std::string>> RecoveryStats::to_rows() const {
+    auto ms = [](double v) {
+        std::stringstream ss;
+        ss.setf(std::ios::fixed);
+        ss.precision(3);
+        ss << v;
+        return ss.str();
+    };
+    return {
+        {"records_scanned", std::to_string(records_scanned)},
+        {"bytes_read", std::to_string(bytes_read)},
+        {"redo_records", std::to_string(redo_records)},
+        {"undo_records", std::to_string(undo_records)},
+        {"undo_txns", std::to_string(undo_txns)},
+        {"pages_touched", std::to_string(pages_touched)},
+        {"index_records", std::to_string(index_records)},
+        {"indexes_rebuilt", std::to_string(indexes_rebuilt)},
+        {"analyze_ms", ms(analyze_ms)},
+        {"redo_ms", ms(redo_ms)},
+        {"undo_ms", ms(undo_ms)},
+        {"index_ms", ms(index_ms)},
+        {"total_ms", ms(analyze_ms + redo_ms + undo_ms + index_ms)},
+    };
+}
+
+/**
+ * @description: 恢复报告，启动时输出一行，代替逐条日志的输出
+ */
+std::string RecoveryManager::report() const {
+    std::string res = "recovery:";
+    for(auto &row : stats_.to_rows()){
+        res += " " + row.first + "=" + row.second;
+    }
+    return res;
+}
+
+/**
+ * @description: SHOW RECOVERY STATS，输出最近一次启动恢复的统计信息，格式与show tables一致
+ * @param {Context*} context
+ */
+void RecoveryManager::show_stats(Context *context) {
+    std::string db_name = sm_manager_->db_.get_db_name();
+    if (chdir(db_name.c_str()) < 0) {  // 进入数据库目录
+        throw UnixError();
+    }
+
+    std::fstream outfile;
+    outfile.open("output.txt", std::ios::out | std::ios::app);
+    outfile << "| Stat | Value |\n";
+
+    RecordPrinter printer(2);
+    printer.print_separator(context);
+    printer.print_record({"Stat", "Value"}, context);
+    printer.print_separator(context);
+    for(auto &row : stats_.to_rows()){
+        printer.print_record({row.first, row.second}, context);
+        outfile << "| " << row.first << " | " << row.second << " |\n";
+    }
+    printer.print_separator(context);
+    outfile.close();
+
+    if (chdir("..") < 0) {
+        throw UnixError();
+    }
 }
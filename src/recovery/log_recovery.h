@@ -11,48 +11,101 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <map>
+#include <set>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 #include "storage/disk_manager.h"
 #include "storage/buffer_pool_manager.h"
 #include "log_manager.h"
 
+class SmManager;
+class Context;
+class RmFileHandle;
+struct IndexMeta;
 
 
-class RedoLogsInPage {
-public:
-    RedoLogsInPage() {} //table_file_hdr_ = nullptr; }
-    //RmFileHandle* table_file_hdr_;
-    std::vector<std::pair<lsn_t,txn_id_t>> redo_logs_;   // 在该page上需要redo的操作的lsn
+
+/* 恢复过程的统计信息，启动时输出一次，也可以通过SHOW RECOVERY STATS查看 */
+struct RecoveryStats {
+    size_t records_scanned = 0;     // analyze扫描的日志记录数
+    size_t bytes_read = 0;          // 从日志文件读取的字节数，包括redo/undo重复读取的部分
+    size_t redo_records = 0;        // 交给redo的日志记录数，页面lsn不早于日志lsn的记录在重做时跳过
+    size_t undo_records = 0;        // 回滚的日志记录数
+    size_t undo_txns = 0;           // 回滚的事务数
+    size_t pages_touched = 0;       // redo和undo涉及的数据页面数
+    size_t index_records = 0;       // 修复索引时检查的记录数
+    size_t indexes_rebuilt = 0;     // 修复失败后重建的索引个数
+    double analyze_ms = 0;
+    double redo_ms = 0;
+    double undo_ms = 0;
+    double index_ms = 0;            // recover_indexes()的耗时
+
+    std::vector<std::pair<std::string, std::string>> to_rows() const;
 };
 
 class UndoLogsInPage {
 public:
     UndoLogsInPage() {}//table_file_hdr_ = nullptr; }
     //RmFileHandle* table_file_hdr_;
-    std::vector<std::pair<lsn_t,txn_id_t>> undo_logs_;  
+    std::vector<std::pair<lsn_t,uint32_t>> undo_logs_;  // <lsn, 日志记录的长度>，回滚时一次读入整条记录
 };
 
 
 class RecoveryManager {
 public:
-    RecoveryManager(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager) {
+    RecoveryManager(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager, SmManager* sm_manager) {
         disk_manager_ = disk_manager;
         buffer_pool_manager_ = buffer_pool_manager;
-       
+        sm_manager_ = sm_manager;
     }
     void analyze();
     void redo();
     void undo();
+    void recover_indexes();
+
+    const RecoveryStats &get_stats() const { return stats_; }
+    std::string report() const;
+    void show_stats(Context *context);
 
-    std::set<int>& get_tb_set(){return tb_set_;}
 private:
-    LogBuffer buffer_;                                              // 读入日志
+    // 日志修改过的一条记录: 修改它的日志，以及redo之后从最新版本倒推出的所有版本
+    struct RecordVersions {
+        std::vector<lsn_t> lsns_;               // 按lsn升序
+        std::vector<std::string> images_;       // 记录在日志期间出现过的各个版本(不含不存在的状态)
+    };
+
+    lsn_t read_checkpoint(lsn_t c_lsn);
+    bool need_redo(lsn_t lsn, txn_id_t txn_id, const std::string &tab_name, page_id_t page_no);
+    void add_data_log(lsn_t lsn, uint32_t log_len, txn_id_t txn_id, int table_id, const Rid &rid);
+    void add_index_log(const IndexLogRecord &log);
+    void prepare_index_redo();
+    void collect_record_versions();
+    void repair_index(RmFileHandle *fh, const IndexMeta &index, std::map<std::pair<page_id_t, int>, RecordVersions> &records);
+    const char *record_in_window(lsn_t lsn);
+    const char *read_record(lsn_t lsn);
+
+    LogBuffer buffer_;                                              // 读入日志，顺序扫描时作为日志窗口
+    lsn_t window_start_ = 0;                                        // buffer_中日志窗口的起始lsn
+    int window_size_ = 0;                                           // buffer_中日志窗口的大小
     DiskManager* disk_manager_;                                     // 用来读写文件
     BufferPoolManager* buffer_pool_manager_;                        // 对页面进行读写
+    SmManager* sm_manager_;                                         // 由日志中的表编号查找表名
+    RecoveryStats stats_;
 
-    std::map<PageId,RedoLogsInPage>redo_list_;
+    std::vector<std::pair<lsn_t,PageId>>redo_logs_;                // 需要重做的日志<lsn, 修改的页面>，按lsn升序
+    std::unordered_map<txn_id_t,std::vector<std::tuple<lsn_t,uint32_t,PageId>>>txn_logs_;   // 未提交事务的数据修改日志<lsn, 长度, 修改的页面>
     std::map<PageId,UndoLogsInPage>undo_list_;
     std::unordered_set<txn_id_t>att_;
-    std::set<int>tb_set_;
+    std::map<int, std::map<std::pair<page_id_t, int>, RecordVersions>> index_rids_;  // 有索引的表中被回滚的记录: 表fd -> <页号, slot号> -> 版本
+
+    // 索引日志: 建立索引的日志之前的同名索引日志不重做，扫描范围内最新的文件头在redo之后替换内存中的文件头
+    std::unordered_map<int, lsn_t> index_create_lsn_;              // 索引文件fd -> 扫描到的最后一条建立索引日志的lsn
+    std::unordered_map<int, std::string> index_hdrs_;               // 索引文件fd -> 扫描范围内最新的文件头
+
+    // 检查点信息: redo_lsn_之后的日志全部重做，之前的日志只重做脏页表中recLSN之后的部分
+    lsn_t redo_lsn_ = 0;
+    std::unordered_set<txn_id_t> ckpt_att_;                             // 检查点记录中的活跃事务
+    std::map<std::pair<std::string, page_id_t>, lsn_t> redo_start_;     // <表名, 页号> -> 该页面开始重做的lsn，由脏页表初始化
 };
\ No newline at end of file
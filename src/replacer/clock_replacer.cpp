@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "clock_replacer.h"
+
+ClockReplacer::ClockReplacer(size_t num_pages) : in_replacer_(num_pages, 0), ref_bit_(num_pages, 0) {}
+
+/**
+ * @description: 转动时钟指针，跳过访问位为1的frame(并清零)，淘汰第一个访问位为0的frame
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool ClockReplacer::victim(frame_id_t *frame_id) {
+    if (size_ == 0) {
+        return false;
+    }
+    // 最多转两圈: 第一圈清空访问位，第二圈一定能找到victim
+    size_t num_frames = in_replacer_.size();
+    for (size_t i = 0; i < 2 * num_frames; i++) {
+        size_t cur = hand_;
+        hand_ = (hand_ + 1) % num_frames;
+        if (!in_replacer_[cur]) {
+            continue;
+        }
+        if (ref_bit_[cur]) {
+            ref_bit_[cur] = 0;
+            continue;
+        }
+        in_replacer_[cur] = 0;
+        size_--;
+        *frame_id = static_cast<frame_id_t>(cur);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void ClockReplacer::pin(frame_id_t frame_id) {
+    if (in_replacer_[frame_id]) {
+        in_replacer_[frame_id] = 0;
+        size_--;
+    }
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰，同时设置访问位
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void ClockReplacer::unpin(frame_id_t frame_id) {
+    if (!in_replacer_[frame_id]) {
+        in_replacer_[frame_id] = 1;
+        size_++;
+    }
+    ref_bit_[frame_id] = 1;
+}
+
+/**
+ * @description: 记录一次访问，即设置访问位
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void ClockReplacer::touch(frame_id_t frame_id) { ref_bit_[frame_id] = 1; }
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t ClockReplacer::Size() { return size_; }
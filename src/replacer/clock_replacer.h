@@ -0,0 +1,48 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+ClockReplacer实现了CLOCK(second chance)替换策略，状态保存在以frame_id为下标的数组中，unpin不需要申请内存。
+replacer由BufferPoolManager在分区latch_内调用，自身不再加锁。
+*/
+class ClockReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的ClockReplacer
+     * @param {size_t} num_pages ClockReplacer最多需要存储的page数量，frame_id取值范围为[0, num_pages)
+     */
+    explicit ClockReplacer(size_t num_pages);
+
+    ~ClockReplacer() override = default;
+
+    bool victim(frame_id_t *frame_id) override;
+
+    void pin(frame_id_t frame_id) override;
+
+    void unpin(frame_id_t frame_id) override;
+
+    void touch(frame_id_t frame_id) override;
+
+    size_t Size() override;
+
+   private:
+    std::vector<uint8_t> in_replacer_;  // frame是否可以被淘汰(已unpin)
+    std::vector<uint8_t> ref_bit_;      // 访问位，时钟指针扫过时清零，为0时才被淘汰
+    size_t hand_ = 0;                   // 时钟指针
+    size_t size_ = 0;                   // 可以被淘汰的frame个数
+};
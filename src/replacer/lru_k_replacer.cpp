@@ -0,0 +1,117 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "lru_k_replacer.h"
+
+#include <algorithm>
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k)
+    : k_(std::max<size_t>(k, 1)), history_(num_pages * k_, 0), count_(num_pages, 0), evictable_(num_pages, 0) {}
+
+/**
+ * @description: 记录一次访问，与上一次访问间隔不超过REPLACER_CORRELATED_PERIOD时视为同一次访问
+ * @param {frame_id_t} frame_id 被访问的frame
+ */
+void LRUKReplacer::record_access(frame_id_t frame_id) {
+    uint64_t now = ++current_ts_;
+    uint64_t *hist = &history_[static_cast<size_t>(frame_id) * k_];
+    if (count_[frame_id] > 0 && now - hist[0] <= REPLACER_CORRELATED_PERIOD) {
+        hist[0] = now;
+        return;
+    }
+    for (size_t i = k_ - 1; i > 0; i--) {
+        hist[i] = hist[i - 1];
+    }
+    hist[0] = now;
+    if (count_[frame_id] < k_) {
+        count_[frame_id]++;
+    }
+}
+
+/**
+ * @description: 淘汰backward k-distance最大的frame: 访问不足K次的frame优先，同一类中比较最早记录的访问时间。
+ * 访问历史保留到remove()为止，被放回的victim不会被当作新的frame
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool LRUKReplacer::victim(frame_id_t *frame_id) {
+    if (size_ == 0) {
+        return false;
+    }
+    size_t num_frames = evictable_.size();
+    size_t best = num_frames;
+    bool best_full = true;
+    uint64_t best_ts = UINT64_MAX;
+    for (size_t f = 0; f < num_frames; f++) {
+        if (!evictable_[f]) {
+            continue;
+        }
+        bool full = count_[f] >= k_;
+        uint64_t ts = count_[f] == 0 ? 0 : history_[f * k_ + count_[f] - 1];
+        if (best == num_frames || (!full && best_full) || (full == best_full && ts < best_ts)) {
+            best = f;
+            best_full = full;
+            best_ts = ts;
+        }
+    }
+    evictable_[best] = 0;
+    size_--;
+    *frame_id = static_cast<frame_id_t>(best);
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰，并记录一次访问
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void LRUKReplacer::pin(frame_id_t frame_id) {
+    if (evictable_[frame_id]) {
+        evictable_[frame_id] = 0;
+        size_--;
+    }
+    record_access(frame_id);
+}
+
+/**
+ * @description: 取消固定一个frame，代表该页面可以被淘汰
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void LRUKReplacer::unpin(frame_id_t frame_id) {
+    if (count_[frame_id] == 0) {
+        record_access(frame_id);
+    }
+    if (!evictable_[frame_id]) {
+        evictable_[frame_id] = 1;
+        size_++;
+    }
+}
+
+/**
+ * @description: 记录一次访问，不改变frame是否可以被淘汰
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void LRUKReplacer::touch(frame_id_t frame_id) { record_access(frame_id); }
+
+/**
+ * @description: 将frame移出replacer并清空其访问历史(页面被删除或帧被复用)
+ * @param {frame_id_t} frame_id 需要移除的frame的id
+ */
+void LRUKReplacer::remove(frame_id_t frame_id) {
+    if (evictable_[frame_id]) {
+        evictable_[frame_id] = 0;
+        size_--;
+    }
+    count_[frame_id] = 0;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t LRUKReplacer::Size() { return size_; }
@@ -0,0 +1,57 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+LRUKReplacer实现了LRU-K替换策略: 淘汰倒数第K次访问时间最早的frame，访问不足K次的frame(如顺序扫描只读一次的页面)优先被淘汰，
+从而避免顺序扫描把热点页面挤出缓冲池。每个frame最近K次访问的逻辑时间戳保存在以frame_id为下标的数组中。
+间隔小于REPLACER_CORRELATED_PERIOD的连续访问(如RmScan对同一页面的反复fetch)只算一次访问。
+replacer由BufferPoolManager在分区latch_内调用，自身不再加锁。
+*/
+class LRUKReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的LRUKReplacer
+     * @param {size_t} num_pages LRUKReplacer最多需要存储的page数量，frame_id取值范围为[0, num_pages)
+     * @param {size_t} k 计算backward k-distance时使用的K值
+     */
+    explicit LRUKReplacer(size_t num_pages, size_t k = LRUK_REPLACER_K);
+
+    ~LRUKReplacer() override = default;
+
+    bool victim(frame_id_t *frame_id) override;
+
+    void pin(frame_id_t frame_id) override;
+
+    void unpin(frame_id_t frame_id) override;
+
+    void touch(frame_id_t frame_id) override;
+
+    void remove(frame_id_t frame_id) override;
+
+    size_t Size() override;
+
+   private:
+    void record_access(frame_id_t frame_id);
+
+    size_t k_;
+    std::vector<uint64_t> history_;     // num_pages * k_，history_[f * k_ + i]为frame f倒数第i+1次访问的时间戳
+    std::vector<uint32_t> count_;       // frame已记录的访问次数，不超过k_
+    std::vector<uint8_t> evictable_;    // frame是否可以被淘汰(已unpin)
+    uint64_t current_ts_ = 0;           // 逻辑时钟，每次访问加一
+    size_t size_ = 0;                   // 可以被淘汰的frame个数
+};
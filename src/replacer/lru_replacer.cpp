@@ -66,6 +66,18 @@ void LRUReplacer::unpin(frame_id_t frame_id) {
     }
 }
 
+/**
+ * @description: 记录一次访问，可以被淘汰的frame移到链表首部
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void LRUReplacer::touch(frame_id_t frame_id) {
+    std::lock_guard<std::mutex> guard(latch_);
+    auto it = LRUhash_.find(frame_id);
+    if (it != LRUhash_.end()) {
+        LRUlist_.splice(LRUlist_.begin(), LRUlist_, it->second);
+    }
+}
+
 /**
  * @description: 获取当前replacer中可以被淘汰的页面数量
  */
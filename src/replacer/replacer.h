@@ -22,6 +22,8 @@ class Replacer {
 
     /**
      * Remove the victim frame as defined by the replacement policy.
+     * The access history of the victim is kept until remove() is called, so a victim that is put back with unpin()
+     * (e.g. because it turned out to be in use) is not treated as a new frame.
      * @param[out] frame_id id of frame that was removed, nullptr if no victim was found
      * @return true if a victim frame was found, false otherwise
      */
@@ -39,6 +41,19 @@ class Replacer {
      */
     virtual void unpin(frame_id_t frame_id) = 0;
 
+    /**
+     * Records an access to a frame without changing whether it can be victimized,
+     * e.g. a hit that the buffer pool observed without telling the replacer.
+     * @param frame_id the id of the frame that was accessed
+     */
+    virtual void touch(frame_id_t frame_id) = 0;
+
+    /**
+     * Removes a frame from the replacer and forgets its access history, e.g. when its page is deleted.
+     * @param frame_id the id of the frame to remove
+     */
+    virtual void remove(frame_id_t frame_id) { pin(frame_id); }
+
     /** @return the number of elements in the replacer that can be victimized */
     virtual size_t Size() = 0;
 };
@@ -0,0 +1,54 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "common/config.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
+#include "replacer/lru_replacer.h"
+#include "replacer/replacer.h"
+#include "replacer/two_queue_replacer.h"
+
+/**
+ * @description: 获取启动时选择的置换策略，环境变量RMDB_REPLACER优先于config.h中的REPLACER_TYPE
+ * @return {string} 置换策略名称
+ */
+inline std::string get_replacer_type() {
+    const char *env = std::getenv("RMDB_REPLACER");
+    return env != nullptr ? std::string(env) : REPLACER_TYPE;
+}
+
+/**
+ * @description: 根据名称创建置换策略，名称不区分大小写，未知名称退化为LRU
+ * @param {string&} type 置换策略名称: LRU / CLOCK / LRU-K(LRUK) / 2Q
+ * @param {size_t} num_pages replacer最多需要存储的page数量
+ */
+inline std::unique_ptr<Replacer> create_replacer(const std::string &type, size_t num_pages) {
+    std::string name;
+    for (char c : type) {
+        name.push_back(static_cast<char>(toupper(static_cast<unsigned char>(c))));
+    }
+    if (name == "CLOCK") {
+        return std::make_unique<ClockReplacer>(num_pages);
+    } else if (name == "LRU-K" || name == "LRUK") {
+        return std::make_unique<LRUKReplacer>(num_pages);
+    } else if (name == "2Q") {
+        return std::make_unique<TwoQueueReplacer>(num_pages);
+    } else if (name != "LRU") {
+        std::cerr << "unknown replacer type: " << type << ", use LRU instead" << std::endl;
+    }
+    return std::make_unique<LRUReplacer>(num_pages);
+}
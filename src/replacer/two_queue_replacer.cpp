@@ -0,0 +1,150 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "two_queue_replacer.h"
+
+#include <algorithm>
+
+TwoQueueReplacer::TwoQueueReplacer(size_t num_pages)
+    : queue_(num_pages, QUEUE_NONE),
+      evictable_(num_pages, 0),
+      load_ts_(num_pages, 0),
+      prev_(num_pages, INVALID_FRAME_ID),
+      next_(num_pages, INVALID_FRAME_ID),
+      kin_(std::max<size_t>(1, num_pages * TWOQ_KIN_PERCENT / 100)) {}
+
+void TwoQueueReplacer::push_front(uint8_t queue, frame_id_t frame_id) {
+    prev_[frame_id] = INVALID_FRAME_ID;
+    next_[frame_id] = head_[queue];
+    if (head_[queue] != INVALID_FRAME_ID) {
+        prev_[head_[queue]] = frame_id;
+    } else {
+        tail_[queue] = frame_id;
+    }
+    head_[queue] = frame_id;
+}
+
+void TwoQueueReplacer::unlink(frame_id_t frame_id) {
+    uint8_t queue = queue_[frame_id];
+    if (prev_[frame_id] != INVALID_FRAME_ID) {
+        next_[prev_[frame_id]] = next_[frame_id];
+    } else {
+        head_[queue] = next_[frame_id];
+    }
+    if (next_[frame_id] != INVALID_FRAME_ID) {
+        prev_[next_[frame_id]] = prev_[frame_id];
+    } else {
+        tail_[queue] = prev_[frame_id];
+    }
+    prev_[frame_id] = next_[frame_id] = INVALID_FRAME_ID;
+}
+
+/**
+ * @description: 记录一次访问: 新页面进入A1，在A1中停留超过REPLACER_CORRELATED_PERIOD后再次访问则提升到Am。
+ * 调用时frame不在链表中
+ * @param {frame_id_t} frame_id 被访问的frame
+ */
+void TwoQueueReplacer::record_access(frame_id_t frame_id) {
+    uint64_t now = ++current_ts_;
+    if (queue_[frame_id] == QUEUE_NONE) {
+        queue_[frame_id] = QUEUE_A1;
+        load_ts_[frame_id] = now;
+        a1_count_++;
+    } else if (queue_[frame_id] == QUEUE_A1 && now - load_ts_[frame_id] > REPLACER_CORRELATED_PERIOD) {
+        queue_[frame_id] = QUEUE_AM;
+        a1_count_--;
+    }
+}
+
+/**
+ * @description: A1超过目标容量或Am为空时淘汰A1中最早的frame，否则淘汰Am中最近最少使用的frame。
+ * frame所属的队列保留到remove()为止，被放回的victim回到原来的队列
+ * @param {frame_id_t*} frame_id 被移除的frame的id
+ * @return {bool} 如果成功淘汰了一个页面则返回true，否则返回false
+ */
+bool TwoQueueReplacer::victim(frame_id_t *frame_id) {
+    if (size_ == 0) {
+        return false;
+    }
+    uint8_t queue = QUEUE_AM;
+    if (tail_[QUEUE_A1] != INVALID_FRAME_ID && (a1_count_ > kin_ || tail_[QUEUE_AM] == INVALID_FRAME_ID)) {
+        queue = QUEUE_A1;
+    }
+    frame_id_t victim = tail_[queue];
+    unlink(victim);
+    evictable_[victim] = 0;
+    size_--;
+    *frame_id = victim;
+    return true;
+}
+
+/**
+ * @description: 固定指定的frame，即该页面无法被淘汰，并记录一次访问
+ * @param {frame_id_t} 需要固定的frame的id
+ */
+void TwoQueueReplacer::pin(frame_id_t frame_id) {
+    if (evictable_[frame_id]) {
+        unlink(frame_id);
+        evictable_[frame_id] = 0;
+        size_--;
+    }
+    record_access(frame_id);
+}
+
+/**
+ * @description: 取消固定一个frame，将其放入所属队列的头部
+ * @param {frame_id_t} frame_id 取消固定的frame的id
+ */
+void TwoQueueReplacer::unpin(frame_id_t frame_id) {
+    if (evictable_[frame_id]) {
+        return;
+    }
+    if (queue_[frame_id] == QUEUE_NONE) {
+        record_access(frame_id);
+    }
+    evictable_[frame_id] = 1;
+    size_++;
+    push_front(queue_[frame_id], frame_id);
+}
+
+/**
+ * @description: 记录一次访问，可以被淘汰的frame移到所属队列(可能已经提升到Am)的头部
+ * @param {frame_id_t} frame_id 被访问的frame的id
+ */
+void TwoQueueReplacer::touch(frame_id_t frame_id) {
+    if (!evictable_[frame_id]) {
+        record_access(frame_id);
+        return;
+    }
+    unlink(frame_id);
+    record_access(frame_id);
+    push_front(queue_[frame_id], frame_id);
+}
+
+/**
+ * @description: 将frame移出replacer并清空其所属队列(页面被删除或帧被复用)
+ * @param {frame_id_t} frame_id 需要移除的frame的id
+ */
+void TwoQueueReplacer::remove(frame_id_t frame_id) {
+    if (evictable_[frame_id]) {
+        unlink(frame_id);
+        evictable_[frame_id] = 0;
+        size_--;
+    }
+    if (queue_[frame_id] == QUEUE_A1) {
+        a1_count_--;
+    }
+    queue_[frame_id] = QUEUE_NONE;
+}
+
+/**
+ * @description: 获取当前replacer中可以被淘汰的页面数量
+ */
+size_t TwoQueueReplacer::Size() { return size_; }
@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+#include "replacer/replacer.h"
+
+/*
+TwoQueueReplacer实现了简化的2Q替换策略:
+ - 新载入的页面进入A1队列(FIFO)，只被访问过一次的页面(如顺序扫描的页面)在A1中被优先淘汰；
+ - 载入超过REPLACER_CORRELATED_PERIOD之后再次被访问的页面提升到Am队列(LRU)；
+ - A1中的frame个数超过kin_(容量的TWOQ_KIN_PERCENT%)时从A1淘汰，否则从Am淘汰。
+两个队列都是以frame_id为下标的数组实现的双向链表，只包含可以被淘汰的frame。
+replacer由BufferPoolManager在分区latch_内调用，自身不再加锁。
+*/
+class TwoQueueReplacer : public Replacer {
+   public:
+    /**
+     * @description: 创建一个新的TwoQueueReplacer
+     * @param {size_t} num_pages TwoQueueReplacer最多需要存储的page数量，frame_id取值范围为[0, num_pages)
+     */
+    explicit TwoQueueReplacer(size_t num_pages);
+
+    ~TwoQueueReplacer() override = default;
+
+    bool victim(frame_id_t *frame_id) override;
+
+    void pin(frame_id_t frame_id) override;
+
+    void unpin(frame_id_t frame_id) override;
+
+    void touch(frame_id_t frame_id) override;
+
+    void remove(frame_id_t frame_id) override;
+
+    size_t Size() override;
+
+   private:
+    enum QueueType : uint8_t { QUEUE_NONE = 0, QUEUE_A1 = 1, QUEUE_AM = 2 };
+
+    void record_access(frame_id_t frame_id);
+
+    void push_front(uint8_t queue, frame_id_t frame_id);
+
+    void unlink(frame_id_t frame_id);
+
+    std::vector<uint8_t> queue_;        // frame所属的队列(与是否可淘汰无关)
+    std::vector<uint8_t> evictable_;    // frame是否可以被淘汰(已unpin)，可淘汰的frame才在链表中
+    std::vector<uint64_t> load_ts_;     // frame进入A1时的逻辑时间戳
+    std::vector<frame_id_t> prev_;      // 链表前驱，INVALID_FRAME_ID表示无
+    std::vector<frame_id_t> next_;      // 链表后继，INVALID_FRAME_ID表示无
+    frame_id_t head_[3] = {INVALID_FRAME_ID, INVALID_FRAME_ID, INVALID_FRAME_ID};  // 各队列的头部(最近加入)
+    frame_id_t tail_[3] = {INVALID_FRAME_ID, INVALID_FRAME_ID, INVALID_FRAME_ID};  // 各队列的尾部(最先被淘汰)
+    size_t a1_count_ = 0;               // 属于A1的frame个数(包括被pin住的)
+    size_t kin_;                        // A1的目标容量
+    uint64_t current_ts_ = 0;           // 逻辑时钟，每次访问加一
+    size_t size_ = 0;                   // 可以被淘汰的frame个数
+};
@@ -45,7 +45,7 @@ auto planner = std::make_unique<Planner>(sm_manager.get());
 auto optimizer = std::make_unique<Optimizer>(sm_manager.get(), planner.get());
 auto ql_manager = std::make_unique<QlManager>(sm_manager.get(), txn_manager.get(),planner.get());
 auto log_manager = std::make_unique<LogManager>(disk_manager.get(),buffer_pool_manager.get());
-auto recovery = std::make_unique<RecoveryManager>(disk_manager.get(), buffer_pool_manager.get());
+auto recovery = std::make_unique<RecoveryManager>(disk_manager.get(), buffer_pool_manager.get(), sm_manager.get());
 auto portal = std::make_unique<Portal>(sm_manager.get());
 auto analyze = std::make_unique<Analyze>(sm_manager.get());
 pthread_mutex_t *buffer_mutex;
@@ -288,22 +288,6 @@ void start_server() {
     std::cout << "Server shuts down." << std::endl;
 }
 
-/*重建索引*/
-void rebuild_index(DiskManager* disk_manager_,SmManager* sm_manager_,std::set<int>tb_set_) {
-    for(auto s : tb_set_){
-        std::string name = disk_manager_->get_file_name(s);
-        auto tab_meta = sm_manager_->db_.get_table(name);
-        
-        for(auto idx : tab_meta.indexes){
-            sm_manager_->drop_index(name,tab_meta.cols,nullptr);
-            std::vector<std::string>cols;
-            for(auto c : tab_meta.cols) cols.push_back(c.name);
-            sm_manager_->create_index(name,cols,nullptr);
-        }
-    }
-
-}
-
 int main(int argc, char **argv) {
     if (argc != 2) {
         // 需要指定数据库名称
@@ -332,6 +316,7 @@ int main(int argc, char **argv) {
             sm_manager->create_db(db_name);
         }
         // Open database
+        sm_manager->set_log_manager(log_manager.get());
         sm_manager->open_db(db_name);
         log_manager->recovery_log_info();
 
@@ -342,14 +327,18 @@ int main(int argc, char **argv) {
 
         recovery->analyze();
         recovery->redo();
-        std::cout<<"finish redo"<<std::endl; 
         recovery->undo();
-        std::cout<<"finish undo"<<std::endl; 
 
         if (chdir("..") < 0) {
             throw UnixError();
         }
-        rebuild_index(disk_manager.get(),sm_manager.get(),recovery->get_tb_set());
+        // 修复被回滚的记录的索引项，修复失败时重建索引，重建索引时需要在根目录下
+        recovery->recover_indexes();
+        std::cout << recovery->report() << std::endl;
+        ql_manager->set_recovery_manager(recovery.get());
+        // 恢复时弄脏的页面没有对应的活跃事务，登记的recLSN不准确，在接受连接前全部写回
+        buffer_pool_manager->flush_all_pages();
+        sm_manager->flush_index_headers();
 
         // 开启服务端，开始接受客户端连接
         start_server();
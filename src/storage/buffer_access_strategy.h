@@ -0,0 +1,49 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "common/config.h"
+#include "page.h"
+
+/**
+ * @description: 缓冲池访问策略(ring buffer)。大表的顺序扫描在缺页时循环复用一小组私有的帧，
+ * 而不是通过replacer淘汰缓冲池中的热点页面(如B+树的内部节点)。
+ * 每个分区各有一个环，环中记录了帧及其被载入的页面，只有当该帧没有被pin且仍然存放着该页面时才会被复用。
+ * 访问策略由单个扫描独占，环的状态在对应分区的latch_内修改。
+ */
+class BufferAccessStrategy {
+    friend class BufferPoolManager;
+
+   public:
+    /**
+     * @param {size_t} num_partitions 缓冲池的分区个数
+     * @param {size_t} ring_size 环的总帧数，平均分给各个分区
+     */
+    BufferAccessStrategy(size_t num_partitions, size_t ring_size)
+        : ring_size_(std::max<size_t>(1, ring_size / num_partitions)), rings_(num_partitions) {}
+
+   private:
+    struct RingSlot {
+        frame_id_t frame_id;
+        PageId page_id;     // 载入该帧时的页面，用于判断帧是否已被其他页面占用
+    };
+
+    struct Ring {
+        std::vector<RingSlot> slots_;
+        size_t next_ = 0;   // 下一个被复用的位置
+    };
+
+    size_t ring_size_;          // 每个分区的环大小
+    std::vector<Ring> rings_;   // 每个分区一个环
+};
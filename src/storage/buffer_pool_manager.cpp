@@ -11,28 +11,42 @@ See the Mulan PSL v2 for more details. */
 #include "buffer_pool_manager.h"
 #include <algorithm>
 #include <chrono>
+#include <exception>
+#include <map>
 
 /**
- * @description: 从free_list或replacer中得到可淘汰帧页的 *frame_id
+ * @description: 从分区的free_list或replacer中得到可淘汰帧页的 *frame_id，调用者需持有分区的latch_
  * @return {bool} true: 可替换帧查找成功 , false: 可替换帧查找失败
- * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id
+ * @param {Partition&} part 页面所在的分区
+ * @param {frame_id_t*} frame_id 帧页id指针,返回成功找到的可替换帧id(全局帧号)
  */
-bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
-    // Todo:
-    // 1 使用BufferPoolManager::free_list_判断缓冲池是否已满需要淘汰页面
+bool BufferPoolManager::find_victim_page(Partition &part, frame_id_t* frame_id) {
+    // 1 使用free_list_判断分区是否已满需要淘汰页面
     // 1.1 未满获得frame
-    // 1.2 已满使用lru_replacer中的方法选择淘汰页面
-    //std::lock_guard<std::mutex> guard(latch_);
-    // 1. 检查 free_list_ 是否为空
-    if (!free_list_.empty()) {
-        // 1.1 未满获得 frame
-        *frame_id = free_list_.front();
-        free_list_.pop_front();
+    // 1.2 已满使用replacer中的方法选择淘汰页面
+    if (!part.free_list_.empty()) {
+        *frame_id = part.free_list_.front();
+        part.free_list_.pop_front();
+        lock_frame(&pages_[*frame_id], 0);
         return true;
     }
 
-    // 1.2 已满使用 lru_replacer 中的方法选择淘汰页面
-    if (replacer_->victim(frame_id)) {
+    // 帧在存放页面期间一直留在replacer中，pin住的帧由这里跳过: 无锁命中路径不通知replacer，只设置访问位。
+    // 被选中的帧若设置了访问位或仍被pin住，就放回replacer(victim保留了访问历史)，访问位通过touch补记为一次访问；
+    // 真正复用的帧才通过remove清空访问历史
+    frame_id_t local_id;
+    for (size_t attempts = 2 * part.size_; attempts > 0 && part.replacer_->victim(&local_id); --attempts) {
+        Page *page = &pages_[part.base_ + local_id];
+        bool referenced = page->ref_.exchange(false, std::memory_order_relaxed);
+        if (referenced || !try_lock_frame(page)) {
+            part.replacer_->unpin(local_id);
+            if (referenced) {
+                part.replacer_->touch(local_id);
+            }
+            continue;
+        }
+        part.replacer_->remove(local_id);
+        *frame_id = part.base_ + local_id;
         return true;
     }
     // 没有可替换的帧
@@ -40,94 +54,309 @@ bool BufferPoolManager::find_victim_page(frame_id_t* frame_id) {
 }
 
 /**
- * @description: 更新页面数据, 如果为脏页则需写入磁盘，再更新为新页面，更新page元数据(data, is_dirty, page_id)和page table
- * @param {Page*} page 写回页指针
- * @param {PageId} new_page_id 新的page_id
- * @param {frame_id_t} new_frame_id 新的帧frame_id
+ * @description: 尝试锁定一个没有被pin的帧(pin_count_从0变为-1)，锁定后无锁路径无法再pin该帧
+ * @return {bool} 帧被pin住时返回false
  */
-void BufferPoolManager::update_page(Page *page, PageId new_page_id, frame_id_t new_frame_id) {
-    // Todo:
-    // 1 如果是脏页，写回磁盘，并且把dirty置为false
-    // 2 更新page table
-    // 3 重置page的data，更新page id
-    std::lock_guard<std::mutex> guard(latch_);
-    if (page->is_dirty()){
-        //write dirty page back to disk
-        //del_from_flush_list(page);
-        disk_manager_->write_page(page->id_.fd,page->id_.page_no,page->data_,PAGE_SIZE);
-    }
-    page_table_.erase(page->id_);
-    page_table_[new_page_id] = new_frame_id;
-    page->id_ = new_page_id;
-    page->is_dirty_ = false;
-
-    disk_manager_->read_page(new_page_id.fd,new_page_id.page_no,page->data_ ,PAGE_SIZE);
+bool BufferPoolManager::try_lock_frame(Page *page) {
+    int expected = 0;
+    return page->pin_count_.compare_exchange_strong(expected, -1, std::memory_order_acq_rel);
 }
 
 /**
-    @description: 将脏页从flush_list中删除（脏页需要flush到磁盘前调用）
-**/
-// bool BufferPoolManager::del_from_flush_list(Page* page){
-//     frame_id_t frame_id = page_table_[page->id_];
-//     auto iter = std::find(flush_list_.begin(),flush_list_.end(),frame_id);
-//     if(iter == flush_list_.end())
-//         throw InternalError("dirty page not in flush page!");
-//     flush_list_.erase(iter);
-//     return true;
-// }
+ * @description: 锁定pin_count_已知为pin_count的帧。无锁路径可能短暂地pin住帧再撤销，此时自旋等待撤销完成
+ */
+void BufferPoolManager::lock_frame(Page *page, int pin_count) {
+    int expected = pin_count;
+    while (!page->pin_count_.compare_exchange_weak(expected, -1, std::memory_order_acq_rel)) {
+        expected = pin_count;
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @description: 设置帧存放的页面，同时更新tag_与提示表。调用者需持有分区的latch_并已锁定该帧
+ */
+void BufferPoolManager::set_page_id(Page *page, frame_id_t frame_id, PageId page_id) {
+    page->id_ = page_id;
+    uint64_t tag = page_tag(page_id);
+    page->tag_.store(tag, std::memory_order_release);
+    page_hint_[hint_slot(tag)].store(frame_id, std::memory_order_release);
+}
+
+/**
+ * @description: 通过提示表查找页面所在的帧，不加锁，结果可能在返回后立即过期
+ * @return {Page*} 帧的tag_与目标页面一致时返回该帧，否则返回nullptr
+ */
+Page *BufferPoolManager::lookup_hint(PageId page_id) {
+    uint64_t tag = page_tag(page_id);
+    frame_id_t frame_id = page_hint_[hint_slot(tag)].load(std::memory_order_acquire);
+    if (frame_id == INVALID_FRAME_ID) {
+        return nullptr;
+    }
+    Page *page = &pages_[frame_id];
+    return page->tag_.load(std::memory_order_acquire) == tag ? page : nullptr;
+}
+
+/**
+ * @description: 命中的无锁快速路径: 先原子地pin住提示表给出的帧，再校验帧仍然存放着目标页面且不在读入中。
+ *              帧只有在pin_count_为0时才能被锁定并重新分配，因此pin成功后校验通过即可安全返回
+ * @return {Page*} 成功pin住目标页面时返回该页面，否则返回nullptr(走加锁的慢速路径)
+ */
+Page *BufferPoolManager::try_fast_pin(PageId page_id) {
+    Page *page = lookup_hint(page_id);
+    if (page == nullptr) {
+        return nullptr;
+    }
+    int pin_count = page->pin_count_.load(std::memory_order_relaxed);
+    do {
+        if (pin_count < 0) {
+            return nullptr;
+        }
+    } while (!page->pin_count_.compare_exchange_weak(pin_count, pin_count + 1, std::memory_order_acq_rel));
+    if (page->tag_.load(std::memory_order_acquire) != page_tag(page_id) ||
+        page->io_in_progress_.load(std::memory_order_acquire)) {
+        page->pin_count_.fetch_sub(1, std::memory_order_release);
+        return nullptr;
+    }
+    page->ref_.store(true, std::memory_order_relaxed);
+    return page;
+}
+
+/**
+ * @description: 获取访问策略中当前分区环上下一个可以复用的帧，调用者需持有分区的latch_
+ * @return {bool} 环已满且下一个位置的帧没有被pin、仍存放着环载入的页面时返回true
+ * @param {Partition&} part 页面所在的分区
+ * @param {BufferAccessStrategy*} strategy 访问策略
+ * @param {frame_id_t*} frame_id 返回可以复用的帧id(全局帧号)
+ */
+bool BufferPoolManager::find_ring_frame(Partition &part, BufferAccessStrategy *strategy, frame_id_t *frame_id) {
+    auto &ring = strategy->rings_[part.idx_];
+    if (ring.slots_.size() < strategy->ring_size_) {
+        return false;
+    }
+    auto &slot = ring.slots_[ring.next_];
+    Page *page = &pages_[slot.frame_id];
+    // 帧被其他线程pin住或已经被淘汰给了其他页面时不能复用，改为从replacer中淘汰，并替换环上的这个位置
+    if (!(page->id_ == slot.page_id) || !try_lock_frame(page)) {
+        return false;
+    }
+    part.replacer_->remove(slot.frame_id - part.base_);
+    *frame_id = slot.frame_id;
+    return true;
+}
+
+/**
+ * @description: 将访问策略载入的帧记录到当前分区的环上，环满时覆盖下一个位置(即find_ring_frame检查过的位置)
+ */
+void BufferPoolManager::add_to_ring(Partition &part, BufferAccessStrategy *strategy, frame_id_t frame_id, PageId page_id) {
+    auto &ring = strategy->rings_[part.idx_];
+    if (ring.slots_.size() < strategy->ring_size_) {
+        ring.slots_.push_back({frame_id, page_id});
+        return;
+    }
+    ring.slots_[ring.next_] = {frame_id, page_id};
+    ring.next_ = (ring.next_ + 1) % ring.slots_.size();
+}
+
+/**
+ * @description: 为顺序扫描创建访问策略，扫描的页面数不超过缓冲池的1/4时不需要访问策略
+ * @return {unique_ptr<BufferAccessStrategy>} 访问策略，小表返回nullptr
+ * @param {size_t} num_pages 扫描的页面个数
+ */
+std::shared_ptr<BufferAccessStrategy> BufferPoolManager::get_access_strategy(size_t num_pages) {
+    if (num_pages <= pool_size_ / 4) {
+        return nullptr;
+    }
+    return std::make_shared<BufferAccessStrategy>(partitions_.size(), BUFFER_ACCESS_RING_SIZE);
+}
+
+/**
+ * @description: 为所有帧申请一块连续的页面内存。开启BUFFER_POOL_HUGE_PAGES时先尝试MAP_HUGETLB(需要系统预留大页)，
+ * 失败后使用普通匿名映射并通过madvise申请透明大页。mmap得到的内存已经清零且按页对齐，满足O_DIRECT的要求
+ */
+void BufferPoolManager::allocate_frames() {
+    size_t bytes = pool_size_ * PAGE_SIZE;
+    void *ptr = MAP_FAILED;
+    if (BUFFER_POOL_HUGE_PAGES && bytes >= HUGE_PAGE_SIZE) {
+        frames_size_ = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        ptr = mmap(nullptr, frames_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if (ptr == MAP_FAILED) {
+        frames_size_ = bytes;
+        ptr = mmap(nullptr, frames_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw InternalError("BufferPoolManager::allocate_frames mmap Error");
+        }
+        if (BUFFER_POOL_HUGE_PAGES && bytes >= HUGE_PAGE_SIZE) {
+            madvise(ptr, frames_size_, MADV_HUGEPAGE);  // 只是建议，内核不支持时忽略
+        }
+    }
+    frames_ = static_cast<char *>(ptr);
+}
+
+/**
+ * @description: 异步预读一个页面。页面已在缓冲池中或预读队列已满时直接忽略，预读只是提示，不保证完成
+ * @param {PageId} page_id 需要预读的页面
+ * @param {shared_ptr<BufferAccessStrategy>} strategy 扫描使用的访问策略，预读的页面同样放入策略的环中
+ */
+void BufferPoolManager::prefetch(PageId page_id, std::shared_ptr<BufferAccessStrategy> strategy) {
+    if (prefetch_threads_.empty()) {
+        return;
+    }
+    {
+        Partition &part = partition_of(page_id);
+        std::lock_guard<std::mutex> guard(part.latch_);
+        if (part.page_table_.count(page_id)) {
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(prefetch_latch_);
+        if (prefetch_queue_.size() >= PREFETCH_QUEUE_SIZE) {
+            return;
+        }
+        prefetch_queue_.emplace_back(page_id, std::move(strategy));
+    }
+    prefetch_cv_.notify_one();
+}
+
+/**
+ * @description: 预读线程主循环: 通过fetch_page把页面读入缓冲池(读取期间帧处于io_in_progress_状态，
+ * 前台线程访问该页面时会等待读取完成而不是重复读取)，然后立即unpin
+ */
+void BufferPoolManager::prefetch_worker() {
+    while (true) {
+        std::pair<PageId, std::shared_ptr<BufferAccessStrategy>> request;
+        {
+            std::unique_lock<std::mutex> lock(prefetch_latch_);
+            prefetch_cv_.wait(lock, [this] { return prefetch_stop_ || !prefetch_queue_.empty(); });
+            if (prefetch_stop_) {
+                return;
+            }
+            request = std::move(prefetch_queue_.front());
+            prefetch_queue_.pop_front();
+        }
+        try {
+            Page *page = fetch_page(request.first, request.second.get());
+            if (page != nullptr) {
+                unpin_page(request.first, false);
+            }
+        } catch (RMDBError &e) {
+            // 页面可能已经不存在(如文件被截断或删除)，预读失败不影响正常访问
+        }
+    }
+}
+
+/**
+ * @description: 淘汰帧中原有的页面: 脏页的日志落盘后交给disk_manager_写回，并从页表中删除。调用者需持有分区的latch_，
+ *              脏页必须在释放latch_之前写回(或进入写回队列)，否则其他线程可能从磁盘读到旧数据
+ * @param {Partition&} part 帧所在的分区
+ * @param {Page*} page 被淘汰的帧
+ */
+void BufferPoolManager::evict_page(Partition &part, Page *page) {
+    if (page->is_dirty_) {
+        flush_log_for(page->get_page_lsn());
+        disk_manager_->write_page_async(page->id_.fd, page->id_.page_no, page->data_);
+        page->clear_dirty();
+    }
+    if (page->id_.page_no != INVALID_PAGE_ID) {
+        part.page_table_.erase(page->id_);
+    }
+}
+
+/**
+ * @description: 等待帧的磁盘读入完成，等待期间释放分区的latch_
+ */
+void BufferPoolManager::wait_for_io(Partition &part, std::unique_lock<std::mutex> &lock, Page *page) {
+    part.io_cv_.wait(lock, [page] { return !page->io_in_progress_; });
+}
 
 /**
  * @description: 从buffer pool获取需要的页。
  *              如果页表中存在page_id（说明该page在缓冲池中），并且pin_count++。
  *              如果页表不存在page_id（说明该page在磁盘中），则找缓冲池victim page，将其替换为磁盘中读取的page，pin_count置1。
+ *              磁盘读取在分区latch_之外进行，读取期间帧被标记为io_in_progress_，其他请求该页面的线程等待读取完成。
+ *              指定访问策略时，缺页优先复用策略环上的帧，不淘汰缓冲池中的其他页面。
  * @return {Page*} 若获得了需要的页则将其返回，否则返回nullptr
  * @param {PageId} page_id 需要获取的页的PageId
+ * @param {BufferAccessStrategy*} strategy 访问策略，为nullptr时使用正常的置换策略
  */
-Page* BufferPoolManager::fetch_page(PageId page_id) {
-    //Todo:
-    // 1.     从page_table_中搜寻目标页
-    // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页。
+Page* BufferPoolManager::fetch_page(PageId page_id, BufferAccessStrategy *strategy) {
+    // 1.     从分区的page_table_中搜寻目标页
+    // 1.1    若目标页有被page_table_记录，则将其所在frame固定(pin)，并返回目标页；若该帧正在读入，则等待后重新查找
     // 1.2    否则，尝试调用find_victim_page获得一个可用的frame，若失败则返回nullptr
-    // 2.     若获得的可用frame存储的为dirty page，则须调用updata_page将page写回到磁盘
-    // 3.     调用disk_manager_的read_page读取目标页到frame
-    // 4.     固定目标页，更新pin_count_
-    // 5.     返回目标页
-    std::lock_guard<std::mutex> guard(latch_);
-    // 1. 从 page_table_ 中搜寻目标页
-
-    auto it = page_table_.find(page_id);
-    if (it != page_table_.end()) {
-        // 1.1 若目标页有被 page_table_ 记录，则将其所在 frame 固定(pin)，并返回目标页。
-        frame_id_t frame_id = it->second;
-        replacer_->pin(frame_id);
-        Page *page = &pages_[frame_id];
-        page->pin_count_++;
-        return page;
-    } else {
-        // 1.2 否则，尝试调用 find_victim_page 获得一个可用的 frame，若失败则返回 nullptr
-        frame_id_t frame_id;
-        if (!find_victim_page(&frame_id)) {
-            return nullptr;
+    // 2.     若获得的可用frame存储的为dirty page，则须将page写回到磁盘
+    // 3.     先在页表中登记目标页并标记io_in_progress_，释放latch_后调用disk_manager_的read_page读取目标页到frame
+    // 4.     返回目标页
+    // 0.     命中时不加锁直接pin住页面
+    Page *hit = try_fast_pin(page_id);
+    if (hit != nullptr) {
+        return hit;
+    }
+
+    Partition &part = partition_of(page_id);
+    std::unique_lock<std::mutex> lock(part.latch_);
+
+    while (true) {
+        auto it = part.page_table_.find(page_id);
+        if (it == part.page_table_.end()) {
+            break;
         }
+        frame_id_t frame_id = it->second;
         Page *page = &pages_[frame_id];
-        // 2. 若获得的可用 frame 存储的为 dirty page，则调用 updata_page 将 page 写回到磁盘
-        if (page->is_dirty_) {
-            //del_from_flush_list(page);
-            disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
+        if (page->io_in_progress_) {
+            // 读入失败时帧会被移出页表，因此等待结束后需要重新查找
+            wait_for_io(part, lock, page);
+            continue;
         }
-        page_table_.erase(page->id_);
-        // 3. 调用 disk_manager_ 的 read_page 读取目标页到 frame
-        disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-        
-        // 4. 固定目标页，更新 pin_count_
-        replacer_->pin(frame_id);
-        page->id_ = page_id;
-        page->is_dirty_ = false;
-        page->pin_count_ = 1;
-        page_table_[page_id] = frame_id;
-
+        page->pin_count_.fetch_add(1, std::memory_order_acq_rel);
+        part.replacer_->touch(frame_id - part.base_);
         return page;
     }
+
+    // 1.2 优先复用访问策略环上的帧，否则尝试调用 find_victim_page 获得一个可用的 frame，若失败则返回 nullptr
+    frame_id_t frame_id;
+    bool from_ring = strategy != nullptr && find_ring_frame(part, strategy, &frame_id);
+    if (!from_ring && !find_victim_page(part, &frame_id)) {
+        return nullptr;
+    }
+    if (strategy != nullptr) {
+        add_to_ring(part, strategy, frame_id, page_id);
+    }
+    Page *page = &pages_[frame_id];
+    // 2. 若获得的可用 frame 存储的为 dirty page，则交给后台线程写回，不阻塞当前线程
+    evict_page(part, page);
+
+    // 3. 固定目标页，登记到页表中，然后在latch_之外读取磁盘。帧存放页面期间一直留在replacer中
+    page->clear_dirty();
+    page->ref_ = false;
+    page->io_in_progress_ = true;
+    set_page_id(page, frame_id, page_id);
+    part.page_table_[page_id] = frame_id;
+    page->pin_count_.store(1, std::memory_order_release);
+    part.replacer_->unpin(frame_id - part.base_);
+    lock.unlock();
+
+    try {
+        disk_manager_->read_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
+    } catch (...) {
+        lock.lock();
+        lock_frame(page, 1);
+        part.page_table_.erase(page_id);
+        page->id_.page_no = INVALID_PAGE_ID;
+        page->tag_ = UINT64_MAX;
+        page->io_in_progress_ = false;
+        page->pin_count_.store(0, std::memory_order_release);
+        part.replacer_->remove(frame_id - part.base_);
+        part.free_list_.push_back(frame_id);
+        part.io_cv_.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    page->io_in_progress_ = false;
+    part.io_cv_.notify_all();
+    return page;
 }
 
 /**
@@ -137,77 +366,62 @@ Page* BufferPoolManager::fetch_page(PageId page_id) {
  * @param {bool} is_dirty 若目标page应该被标记为dirty则为true，否则为false
  */
 bool BufferPoolManager::unpin_page(PageId page_id, bool is_dirty) {
-    // Todo:
-    // 0. lock latch
-    // 1. 尝试在page_table_中搜寻page_id对应的页P
+    // 1. 尝试在page_table_中搜寻page_id对应的页P，先查提示表，未命中时加锁查找页表
     // 1.1 P在页表中不存在 return false
-    // 1.2 P在页表中存在，获取其pin_count_
-    // 2.1 若pin_count_已经等于0，则返回false
-    // 2.2 若pin_count_大于0，则pin_count_自减一
-    // 2.2.1 若自减后等于0，则调用replacer_的Unpin
-    // 3 根据参数is_dirty，更改P的is_dirty_
-    std::lock_guard<std::mutex> guard(latch_);
-
-    // 1. 尝试在page_table_中搜寻page_id对应的页P
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()) {
-        return false;
-    }
-    frame_id_t frame_id = it->second;
-    Page *page = &pages_[frame_id];
     // 2.1 若pin_count_已经等于0，则返回false
-    if (page->pin_count_ <= 0) {
-        std::cout<<"pin_count_:"<<page->pin_count_<<std::endl;
-        return false;
-    }
-    // 2.2 若pin_count_大于0，则pin_count_自减一
-    page->pin_count_--;
-    // 2.2.1 若自减后等于0，则调用replacer_的Unpin
-    if (page->pin_count_ == 0) {
-        replacer_->unpin(frame_id);
+    // 2.2 若pin_count_大于0，则pin_count_原子地自减一。帧一直留在replacer中，不需要通知replacer
+    // 3 根据参数is_dirty，更改P的is_dirty_(在自减之前设置，保证淘汰时能看到脏标记)
+    // 调用者持有pin时帧不会被重新分配，因此无锁路径找到的帧在自减之前一直有效
+    Page *page = lookup_hint(page_id);
+    if (page == nullptr) {
+        Partition &part = partition_of(page_id);
+        std::lock_guard<std::mutex> guard(part.latch_);
+        auto it = part.page_table_.find(page_id);
+        if (it == part.page_table_.end()) {
+            return false;
+        }
+        page = &pages_[it->second];
     }
 
     // 3. 根据参数is_dirty，更改is_dirty_
     if (is_dirty) {
         page->is_dirty_ = true;
-        //将脏页加入到flush_list (在flush_list不一定在lru_list中，原因在于只有在没有线程使用
-        //page时才能够加入lru_list)
-        //auto iter = std::find(flush_list_.begin(),flush_list_.end(),frame_id);
-        //如果脏页已经存在于flush_list中，不需要重复插入
-        // if(iter == flush_list_.end())
-        //      flush_list_.push_front(frame_id);
     }
+    // 上层也可能先通过Page::set_dirty标记脏页，统一在unpin时登记recLSN
+    if (page->is_dirty_.load(std::memory_order_relaxed)) {
+        note_rec_lsn(page);
+    }
+    // 2. pin_count_自减一
+    int pin_count = page->pin_count_.load(std::memory_order_relaxed);
+    do {
+        // 2.1 若pin_count_已经等于0，则返回false
+        if (pin_count <= 0) {
+            std::cout<<"pin_count_:"<<pin_count<<std::endl;
+            return false;
+        }
+    } while (!page->pin_count_.compare_exchange_weak(pin_count, pin_count - 1, std::memory_order_acq_rel));
     return true;
 }
 
 /**
- * @description: 将目标页写回磁盘，不考虑当前页面是否正在被使用
+ * @description: 将目标页写回磁盘(如果是脏页)。页面被pin住时可能正在被修改，等待unpin后再写回
  * @return {bool} 成功则返回true，否则返回false(只有page_table_中没有目标页时)
  * @param {PageId} page_id 目标页的page_id，不能为INVALID_PAGE_ID
  */
 bool BufferPoolManager::flush_page(PageId page_id) {
-    
-    // Todo:
-    // 0. lock latch
-    // 1. 查找页表,尝试获取目标页P
-    // 1.1 目标页P没有被page_table_记录 ，返回false
-    // 2. 无论P是否为脏都将其写回磁盘。
-    // 3. 更新P的is_dirty_
-   
-    std::lock_guard<std::mutex> guard(latch_);
-
-    // 1. 查找页表，尝试获取目标页P
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()) {
-        return false;
+    // 1. 查找页表，尝试获取目标页P，目标页P没有被page_table_记录，返回false
+    // 2. 锁定P所在的帧后写回，写回之前修改页面的日志先落盘
+    std::vector<frame_id_t> frames;
+    {
+        Partition &part = partition_of(page_id);
+        std::lock_guard<std::mutex> guard(part.latch_);
+        auto it = part.page_table_.find(page_id);
+        if (it == part.page_table_.end()) {
+            return false;
+        }
+        frames.push_back(it->second);
     }
-    frame_id_t frame_id = it->second;
-    Page *page = &pages_[frame_id];
-    // 2. 将页面写回磁盘
-    //del_from_flush_list(page);
-    disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    // 3. 更新页面的is_dirty状态
-    page->is_dirty_ = false;
+    write_back_all(&frames);
     return true;
 }
 
@@ -215,38 +429,38 @@ bool BufferPoolManager::flush_page(PageId page_id) {
  * @description: 创建一个新的page，即从磁盘中移动一个新建的空page到缓冲池某个位置。
  * @return {Page*} 返回新创建的page，若创建失败则返回nullptr
  * @param {PageId*} page_id 当成功创建一个新的page时存储其page_id
+ * @param {int} pno 指定的页号，为-1时由disk_manager_分配新的页号
  */
 Page* BufferPoolManager::new_page(PageId* page_id,int pno) {
-    std::lock_guard<std::mutex> guard(latch_);
-    // 1.   获得一个可用的frame，若无法获得则返回nullptr
-    // 2.   在fd对应的文件分配一个新的page_id
+    // 1.   在fd对应的文件分配一个新的page_id(页面所在分区由page_id决定，因此需要先分配页号)
+    // 2.   在分区中获得一个可用的frame，若无法获得则返回nullptr
     // 3.   将frame的数据写回磁盘
     // 4.   固定frame，更新pin_count_
     // 5.   返回获得的page
-    // 1. 获得一个可用的frame，若无法获得则返回nullptr
+    // 1. 在fd对应的文件分配一个新的page_id
+    if(pno == -1)
+        page_id->page_no = disk_manager_->allocate_page(page_id->fd);
+    else page_id->page_no = pno;
+
+    Partition &part = partition_of(*page_id);
+    std::lock_guard<std::mutex> guard(part.latch_);
+    // 2. 获得一个可用的frame，若无法获得则返回nullptr
     frame_id_t frame_id;
-    if (!find_victim_page(&frame_id)) {
+    if (!find_victim_page(part, &frame_id)) {
         return nullptr;
     }
     Page *page = &pages_[frame_id];
-    // 2. 在fd对应的文件分配一个新的page_id
-    if(pno == -1)
-        page_id->page_no = disk_manager_->allocate_page(page_id->fd);
-    else page_id->page_no = pno;
     // 3. 将frame的数据写回磁盘（如果frame是脏页）
-    if (page->is_dirty_) {
-        //del_from_flush_list(page);
-        disk_manager_->write_page(page->id_.fd, page->id_.page_no, page->data_, PAGE_SIZE);
-    }
+    evict_page(part, page);
 
     // 4. 固定frame，更新pin_count_
-    page_table_.erase(page->id_);
-    replacer_->pin(frame_id);
-    page->id_ = *page_id;
-    page->is_dirty_ = false;
-    page->pin_count_ = 1;
+    page->clear_dirty();
+    page->ref_ = false;
     memset(page->data_, 0, PAGE_SIZE); // 清空新page的数据
-    page_table_[*page_id] = frame_id;
+    set_page_id(page, frame_id, *page_id);
+    part.page_table_[*page_id] = frame_id;
+    page->pin_count_.store(1, std::memory_order_release);
+    part.replacer_->unpin(frame_id - part.base_);
 
     // 5. 返回获得的page
     return page;
@@ -261,35 +475,41 @@ bool BufferPoolManager::delete_page(PageId page_id) {
     // 1.   在page_table_中查找目标页，若不存在返回true
     // 2.   若目标页的pin_count不为0，则返回false
     // 3.   将目标页数据写回磁盘，从页表中删除目标页，重置其元数据，将其加入free_list_，返回true
-    std::lock_guard<std::mutex> guard(latch_);
+    Partition &part = partition_of(page_id);
+    std::unique_lock<std::mutex> lock(part.latch_);
 
-    // 1. 在page_table_中查找目标页，若不存在返回true
-    auto it = page_table_.find(page_id);
-    if (it == page_table_.end()) {
-        return true;
+    // 1. 在page_table_中查找目标页，若不存在返回true；目标页正在读入或写回时等待完成后重新查找
+    frame_id_t frame_id;
+    Page *page;
+    while (true) {
+        auto it = part.page_table_.find(page_id);
+        if (it == part.page_table_.end()) {
+            return true;
+        }
+        frame_id = it->second;
+        page = &pages_[frame_id];
+        if (!page->io_in_progress_) {
+            break;
+        }
+        wait_for_io(part, lock, page);
     }
 
-    frame_id_t frame_id = it->second;
-    Page* page = &pages_[frame_id];
-
-    // 2. 若目标页的pin_count不为0，则返回false
-    if (page->pin_count_ > 0) {
+    // 2. 若目标页的pin_count不为0，则返回false；否则锁定该帧
+    if (!try_lock_frame(page)) {
         return false;
     }
-    // 3. 将目标页数据写回磁盘
-    if (page->is_dirty_) {
-        //del_from_flush_list(page);
-        disk_manager_->write_page(page_id.fd, page_id.page_no, page->data_, PAGE_SIZE);
-    }
-    // 4. 从页表中删除目标页
-    page_table_.erase(it);
+    // 3. 将目标页数据写回磁盘，并从页表中删除目标页
+    evict_page(part, page);
+    // 4. 目标页已不在replacer可淘汰的范围内
+    part.replacer_->remove(frame_id - part.base_);
     // 5. 重置目标页的元数据
     page->id_.page_no = INVALID_PAGE_ID;
-    page->is_dirty_ = false;
-    page->pin_count_ = 0;
+    page->tag_ = UINT64_MAX;
+    page->clear_dirty();
     page->reset_memory();
+    page->pin_count_.store(0, std::memory_order_release);
     // 6. 将其加入free_list_
-    free_list_.push_back(frame_id);
+    part.free_list_.push_back(frame_id);
     // 7. 返回true
     return true;
 }
@@ -299,55 +519,225 @@ bool BufferPoolManager::delete_page(PageId page_id) {
  * @param {int} fd 文件句柄
  */
 void BufferPoolManager::flush_all_pages(int fd) {
-    std::lock_guard<std::mutex> guard(latch_);
-
-    // 遍历缓冲池中的所有页面
-    for (auto& entry : page_table_) {
-        if(entry.first.fd == fd){
-             frame_id_t frame_id = entry.second;
-            Page* page = &pages_[frame_id];
-
-            // 如果页面是脏页，则将其写回磁盘
-            if (page->is_dirty_) {
-                //del_from_flush_list(page);
-                disk_manager_->write_page(fd, page->id_.page_no, page->data_, PAGE_SIZE);
-                page->is_dirty_ = false; // 更新页面的脏状态
+    // 收集文件的脏页后一次批量写入，整个文件只刷盘一次
+    std::vector<frame_id_t> frames;
+    for (auto &part : partitions_) {
+        std::lock_guard<std::mutex> guard(part->latch_);
+        for (auto &entry : part->page_table_) {
+            if (entry.first.fd == fd && pages_[entry.second].is_dirty_) {
+                frames.push_back(entry.second);
             }
         }
     }
+    write_back_all(&frames);
 }
 
 
  void BufferPoolManager::flush_all_pages(){
-    std::lock_guard<std::mutex> guard(latch_);
-    for(auto &entry : page_table_){
-        Page *page = &pages_[entry.second];
-        disk_manager_->write_page(page->get_page_id().fd, page->id_.page_no, page->data_, PAGE_SIZE);
-        page->is_dirty_ = false; // 更新页面的脏状态
-    }
-    // for(auto& fid :flush_list_){
-    //     Page* page = &pages_[fid];
-    //     //del_from_flush_list(page);
-    //     disk_manager_->write_page(page->get_page_id().fd, page->id_.page_no, page->data_, PAGE_SIZE);
-    //     page->is_dirty_ = false; // 更新页面的脏状态
-    // }
-    // flush_list_.clear();
+    std::vector<frame_id_t> frames;
+    for (auto &part : partitions_) {
+        std::lock_guard<std::mutex> guard(part->latch_);
+        for (auto &entry : part->page_table_) {
+            if (pages_[entry.second].is_dirty_) {
+                frames.push_back(entry.second);
+            }
+        }
+    }
+    write_back_all(&frames);
  }
 
-void BufferPoolManager::delete_all_page(int fd){
-    std::lock_guard<std::mutex>guard(latch_);
+/**
+ * @description: 写回一批帧中的脏页，调用者不持有分区的latch_。没有被pin的帧先锁定并标记为io_in_progress_，
+ *              清除脏标记后在latch_之外写回，写回期间其他线程访问这些页面时等待写回完成，因此写回的页面是完整的；
+ *              写回失败时重新标记为脏页。被pin住的脏页可能正在被修改，与正在读写的帧一起留给调用者重试
+ * @return {size_t} 写回的页面个数
+ * @param {vector<frame_id_t>*} frames 需要写回的帧(全局帧号)，返回时只剩下需要重试的帧
+ */
+size_t BufferPoolManager::write_back_frames(std::vector<frame_id_t> *frames) {
+    std::sort(frames->begin(), frames->end());
+    std::vector<frame_id_t> busy;
+    std::vector<frame_id_t> batch;
+    for (auto it = frames->begin(); it != frames->end();) {
+        Partition &part = partition_of_frame(*it);
+        std::lock_guard<std::mutex> guard(part.latch_);
+        for (; it != frames->end() && *it < part.base_ + static_cast<frame_id_t>(part.size_); ++it) {
+            Page *page = &pages_[*it];
+            // 收集帧之后页面可能已经被写回或淘汰
+            if (page->id_.page_no == INVALID_PAGE_ID) continue;
+            if (!try_lock_frame(page)) {
+                if (page->is_dirty_ || page->io_in_progress_) {
+                    busy.push_back(*it);
+                }
+                continue;
+            }
+            if (!page->is_dirty_) {
+                page->pin_count_.store(0, std::memory_order_release);
+                continue;
+            }
+            page->io_in_progress_ = true;
+            page->pin_count_.store(1, std::memory_order_release);
+            page->clear_dirty();
+            batch.push_back(*it);
+        }
+    }
 
-    for(auto &entry :page_table_){
-        if(entry.first.fd == fd){
-            latch_.unlock();
-            auto ret =  delete_page({fd,entry.first.page_no});
-            if(ret == false){
-                std::cout<<"page ["<<entry.first.page_no<<"] pin_count != 0,delete failed"<<std::endl;
+    std::map<int, std::vector<std::pair<page_id_t, const char *>>> files;  // 按文件分组批量写入
+    lsn_t max_lsn = INVALID_LSN;
+    for (frame_id_t frame_id : batch) {
+        Page *page = &pages_[frame_id];
+        files[page->id_.fd].emplace_back(page->id_.page_no, page->data_);
+        max_lsn = std::max(max_lsn, page->get_page_lsn());
+    }
+    std::exception_ptr error;
+    try {
+        flush_log_for(max_lsn);
+        for (auto &file : files) {
+            disk_manager_->write_pages(file.first, file.second);
+        }
+    } catch (RMDBError &) {
+        error = std::current_exception();
+    }
+    for (auto it = batch.begin(); it != batch.end();) {
+        Partition &part = partition_of_frame(*it);
+        std::lock_guard<std::mutex> guard(part.latch_);
+        for (; it != batch.end() && *it < part.base_ + static_cast<frame_id_t>(part.size_); ++it) {
+            Page *page = &pages_[*it];
+            if (error) {
+                page->is_dirty_ = true;
+                note_rec_lsn(page);
+            }
+            page->io_in_progress_ = false;
+            page->pin_count_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        part.io_cv_.notify_all();
+    }
+    frames->swap(busy);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return batch.size();
+}
+
+/**
+ * @description: 写回一批帧中的所有脏页，被pin住的脏页等待unpin后再写回。调用者不能持有这些页面的pin
+ * @param {vector<frame_id_t>*} frames 需要写回的帧(全局帧号)
+ */
+void BufferPoolManager::write_back_all(std::vector<frame_id_t> *frames) {
+    while (true) {
+        write_back_frames(frames);
+        if (frames->empty()) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @description: 页面从干净变为脏时登记recLSN，已经登记过的页面保持最早的recLSN不变。调用者需持有该页面的pin
+ */
+void BufferPoolManager::note_rec_lsn(Page *page) {
+    if (rec_lsn_provider_ == nullptr || page->oldest_modification.load(std::memory_order_relaxed) != INVALID_LSN) {
+        return;
+    }
+    lsn_t expected = INVALID_LSN;
+    page->oldest_modification.compare_exchange_strong(expected, rec_lsn_provider_());
+}
+
+/**
+ * @description: 写回脏页之前把修改页面的日志刷盘，批量写回时传入批次中最大的页面lsn
+ * @param {lsn_t} page_lsn 页面lsn，即最后一条修改页面的日志记录的起始位置
+ */
+void BufferPoolManager::flush_log_for(lsn_t page_lsn) {
+    if (log_flusher_ == nullptr || page_lsn == INVALID_LSN) {
+        return;
+    }
+    log_flusher_(page_lsn);
+}
+
+/**
+ * @description: 获取脏页表。遍历各分区的页表，只读取帧描述符，不访问页面数据
+ * @return {vector<pair<PageId, lsn_t>>} <脏页的PageId, recLSN>
+ */
+std::vector<std::pair<PageId, lsn_t>> BufferPoolManager::get_dirty_page_table() {
+    // 已经被修改但还没有unpin的页面尚未登记recLSN，修改它的事务仍然活跃，使用当前最早的活跃事务lsn
+    lsn_t now = rec_lsn_provider_ != nullptr ? rec_lsn_provider_() : INVALID_LSN;
+    std::vector<std::pair<PageId, lsn_t>> dirty_page_table;
+    for (auto &part : partitions_) {
+        std::lock_guard<std::mutex> guard(part->latch_);
+        for (auto &entry : part->page_table_) {
+            Page *page = &pages_[entry.second];
+            if (!page->is_dirty_) continue;
+            lsn_t rec_lsn = page->oldest_modification.load(std::memory_order_relaxed);
+            dirty_page_table.emplace_back(entry.first, rec_lsn == INVALID_LSN ? now : rec_lsn);
+        }
+    }
+    return dirty_page_table;
+}
+
+/**
+ * @description: 增量刷脏，写回recLSN小于max_rec_lsn的脏页。每个分区先收集候选帧并按recLSN排序，
+ *              之后每次只在latch_内锁定CHECKPOINT_FLUSH_BATCH个页面，在latch_之外批量写回，不阻塞其他线程的fetch/unpin。
+ *              被pin住的页面可能正在被修改，写回会得到不完整的页面，因此跳过(与淘汰相同)，放到最后一批重试一次，
+ *              仍然被pin住的页面留在脏页表中，由下一次检查点写回
+ * @return {size_t} 写回的页面个数
+ * @param {lsn_t} max_rec_lsn 只写回recLSN小于该值的脏页
+ */
+size_t BufferPoolManager::flush_dirty_pages(lsn_t max_rec_lsn) {
+    size_t flushed = 0;
+    for (auto &part : partitions_) {
+        std::vector<std::pair<lsn_t, frame_id_t>> candidates;
+        {
+            std::lock_guard<std::mutex> guard(part->latch_);
+            for (auto &entry : part->page_table_) {
+                Page *page = &pages_[entry.second];
+                if (!page->is_dirty_) continue;
+                lsn_t rec_lsn = page->oldest_modification.load(std::memory_order_relaxed);
+                if (rec_lsn != INVALID_LSN && rec_lsn >= max_rec_lsn) continue;
+                candidates.emplace_back(rec_lsn, entry.second);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        std::vector<frame_id_t> frames;
+        for (auto &candidate : candidates) {
+            frames.push_back(candidate.second);
+        }
+        size_t num_candidates = frames.size();
+        for (size_t start = 0; start < frames.size();) {
+            size_t end = std::min(frames.size(), start + CHECKPOINT_FLUSH_BATCH);
+            if (start < num_candidates) {
+                end = std::min(end, num_candidates);
+            }
+            std::vector<frame_id_t> batch(frames.begin() + start, frames.begin() + end);
+            flushed += write_back_frames(&batch);
+            if (start < num_candidates) {
+                frames.insert(frames.end(), batch.begin(), batch.end());
             }
-            latch_.lock();
+            start = end;
         }
     }
+    return flushed;
+}
 
+void BufferPoolManager::delete_all_page(int fd){
+    for (auto &part : partitions_) {
+        // 先收集需要删除的页面，delete_page会修改page_table_
+        std::vector<PageId> page_ids;
+        {
+            std::lock_guard<std::mutex> guard(part->latch_);
+            for (auto &entry : part->page_table_) {
+                if (entry.first.fd == fd) {
+                    page_ids.push_back(entry.first);
+                }
+            }
+        }
+        for (auto &page_id : page_ids) {
+            auto ret = delete_page(page_id);
+            if(ret == false){
+                std::cout<<"page ["<<page_id.page_no<<"] pin_count != 0,delete failed"<<std::endl;
+            }
+        }
+    }
 }
 
 //TODO
@@ -355,4 +745,4 @@ void BufferPoolManager::gc(){
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
     return;
-}
\ No newline at end of file
+}
@@ -10,56 +10,116 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <thread>
 #include <cstdint>
 
+#include "buffer_access_strategy.h"
 #include "disk_manager.h"
 #include "errors.h"
 #include "page.h"
 #include "replacer/lru_replacer.h"
 #include "replacer/replacer.h"
+#include "replacer/replacer_factory.h"
 
 class BufferPoolManager {
    private:
+    /**
+     * @description: buffer pool的一个分区，拥有[base_, base_ + size_)范围内的帧以及独立的latch_。
+     * 页面按PageId哈希到分区，不同分区上的fetch/unpin互不阻塞。
+     */
+    struct Partition {
+        size_t idx_ = 0;            // 分区编号
+        frame_id_t base_ = 0;       // 分区第一个帧在pages_中的下标
+        size_t size_ = 0;           // 分区中的帧个数
+        std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 页面号到(全局)帧号的映射
+        std::list<frame_id_t> free_list_;   // 空闲帧编号的链表(全局帧号)
+        std::unique_ptr<Replacer> replacer_;    // 分区的置换策略，使用分区内的局部帧号
+        std::mutex latch_;                  // 用于分区内共享数据结构的并发控制
+        std::condition_variable io_cv_;     // 等待帧的磁盘读入完成
+    };
+
     size_t pool_size_;      // buffer_pool中可容纳页面的个数，即帧的个数
     Page *pages_;           // buffer_pool中的Page对象数组，在构造空间中申请内存空间，在析构函数中释放，大小为BUFFER_POOL_SIZE
-    std::unordered_map<PageId, frame_id_t, PageIdHash> page_table_; // 帧号和页面号的映射哈希表，用于根据页面的PageId定位该页面的帧编号
-    std::list<frame_id_t> free_list_;   // 空闲帧编号的链表
-    //std::list<frame_id_t> flush_list_;  //脏页编号的链表
+    std::unique_ptr<std::atomic<frame_id_t>[]> page_hint_;   // 无锁命中路径使用的页面->帧提示表，直接映射，可能过期，使用前需校验帧的tag_
+    size_t hint_bits_ = 0;      // page_hint_大小为2^hint_bits_
+    char *frames_ = nullptr;    // 所有帧的页面数据，一块mmap得到的连续内存(页对齐，可能由大页支持)，pages_[i].data_指向第i个页面
+    size_t frames_size_ = 0;    // frames_映射的字节数
+    std::vector<std::unique_ptr<Partition>> partitions_;  // 分区数组
     DiskManager *disk_manager_;
-    Replacer *replacer_;    // buffer_pool的置换策略，当前赛题中为LRU置换策略
-    std::mutex latch_;      // 用于共享数据结构的并发控制
+    std::function<lsn_t()> rec_lsn_provider_;   // 页面第一次被弄脏时提供其recLSN，由LogManager设置，未设置时不登记recLSN
+    std::function<void(lsn_t)> log_flusher_;    // 脏页写回前把页面lsn处的日志记录刷盘(WAL)，由LogManager设置，未设置时不刷日志
+
+    // 预读线程池: 后台线程把页面读入缓冲池后立即unpin，扫描真正访问时直接命中
+    std::vector<std::thread> prefetch_threads_;
+    std::deque<std::pair<PageId, std::shared_ptr<BufferAccessStrategy>>> prefetch_queue_;  // 等待预读的页面
+    std::mutex prefetch_latch_;                 // 保护prefetch_queue_
+    std::condition_variable prefetch_cv_;       // 通知预读线程有新的请求
+    bool prefetch_stop_ = false;
 
    public:
-    BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
+    BufferPoolManager(size_t pool_size, DiskManager *disk_manager, const std::string &replacer_type = get_replacer_type())
         : pool_size_(pool_size), disk_manager_(disk_manager) {
         // 为buffer pool分配一块连续的内存空间
         pages_ = new Page[pool_size_];
-        // 可以被Replacer改变
-        if (REPLACER_TYPE.compare("LRU"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else if (REPLACER_TYPE.compare("CLOCK"))
-            replacer_ = new LRUReplacer(pool_size_);
-        else {
-            replacer_ = new LRUReplacer(pool_size_);
+        while ((size_t{1} << hint_bits_) < pool_size_ * 2) {
+            hint_bits_++;
+        }
+        page_hint_ = std::make_unique<std::atomic<frame_id_t>[]>(size_t{1} << hint_bits_);
+        for (size_t i = 0; i < (size_t{1} << hint_bits_); ++i) {
+            page_hint_[i].store(INVALID_FRAME_ID, std::memory_order_relaxed);
         }
-        // 初始化时，所有的page都在free_list_中         
+        allocate_frames();
         for (size_t i = 0; i < pool_size_; ++i) {
-            free_list_.emplace_back(static_cast<frame_id_t>(i));  // static_cast转换数据类型
+            pages_[i].data_ = frames_ + i * PAGE_SIZE;
+        }
+        // 缓冲池较小时(如单元测试)退化为一个分区，保证"缓冲池满"的语义与分区数无关
+        size_t num_partitions = std::max<size_t>(1, std::min(BUFFER_POOL_PARTITIONS, pool_size_ / BUFFER_POOL_PARTITION_MIN_FRAMES));
+        size_t base = 0;
+        for (size_t i = 0; i < num_partitions; ++i) {
+            auto part = std::make_unique<Partition>();
+            part->idx_ = i;
+            part->base_ = static_cast<frame_id_t>(base);
+            part->size_ = pool_size_ / num_partitions + (i < pool_size_ % num_partitions ? 1 : 0);
+            // 可以被Replacer改变
+            part->replacer_ = create_replacer(replacer_type, part->size_);
+            // 初始化时，所有的page都在free_list_中
+            for (size_t j = 0; j < part->size_; ++j) {
+                part->free_list_.emplace_back(static_cast<frame_id_t>(base + j));  // static_cast转换数据类型
+            }
+            base += part->size_;
+            partitions_.push_back(std::move(part));
         }
         //启动lru与flush_page的回收工作
         //std::thread gc_thread(gc);
+        for (size_t i = 0; i < PREFETCH_THREAD_NUM; ++i) {
+            prefetch_threads_.emplace_back(&BufferPoolManager::prefetch_worker, this);
+        }
     }
 
     ~BufferPoolManager() {
+        {
+            std::lock_guard<std::mutex> guard(prefetch_latch_);
+            prefetch_stop_ = true;
+        }
+        prefetch_cv_.notify_all();
+        for (auto &thread : prefetch_threads_) {
+            thread.join();
+        }
         delete[] pages_;
-        delete replacer_;
+        munmap(frames_, frames_size_);
     }
 
     /**
@@ -69,7 +129,11 @@ class BufferPoolManager {
     static void mark_dirty(Page* page) { page->is_dirty_ = true; }
 
    public: 
-    Page* fetch_page(PageId page_id);
+    Page* fetch_page(PageId page_id, BufferAccessStrategy *strategy = nullptr);
+
+    std::shared_ptr<BufferAccessStrategy> get_access_strategy(size_t num_pages);
+
+    void prefetch(PageId page_id, std::shared_ptr<BufferAccessStrategy> strategy = nullptr);
 
     bool unpin_page(PageId page_id, bool is_dirty);
 
@@ -85,13 +149,62 @@ class BufferPoolManager {
 
     void flush_all_pages();
 
+    void set_rec_lsn_provider(std::function<lsn_t()> provider) { rec_lsn_provider_ = std::move(provider); }
+
+    void set_log_flusher(std::function<void(lsn_t)> flusher) { log_flusher_ = std::move(flusher); }
+
+    std::vector<std::pair<PageId, lsn_t>> get_dirty_page_table();
+
+    size_t flush_dirty_pages(lsn_t max_rec_lsn);
+
    private:
-    bool find_victim_page(frame_id_t* frame_id);
+    Partition &partition_of(PageId page_id) { return *partitions_[PageIdHash()(page_id) % partitions_.size()]; }
+
+    Partition &partition_of_frame(frame_id_t frame_id) {
+        size_t i = partitions_.size() - 1;
+        while (partitions_[i]->base_ > frame_id) {
+            --i;
+        }
+        return *partitions_[i];
+    }
+
+    bool find_victim_page(Partition &part, frame_id_t* frame_id);
+
+    bool find_ring_frame(Partition &part, BufferAccessStrategy *strategy, frame_id_t *frame_id);
+
+    void add_to_ring(Partition &part, BufferAccessStrategy *strategy, frame_id_t frame_id, PageId page_id);
+
+    void evict_page(Partition &part, Page* page);
+
+    static uint64_t page_tag(PageId page_id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(page_id.fd)) << 32) | static_cast<uint32_t>(page_id.page_no);
+    }
+
+    size_t hint_slot(uint64_t tag) const { return (tag * 0x9E3779B97F4A7C15ULL) >> (64 - hint_bits_); }
+
+    Page *lookup_hint(PageId page_id);
+
+    Page *try_fast_pin(PageId page_id);
+
+    void set_page_id(Page *page, frame_id_t frame_id, PageId page_id);
+
+    static bool try_lock_frame(Page *page);
+
+    static void lock_frame(Page *page, int pin_count);
+
+    void wait_for_io(Partition &part, std::unique_lock<std::mutex> &lock, Page *page);
+
+    void prefetch_worker();
+
+    void allocate_frames();
+
+    void note_rec_lsn(Page *page);
 
-    void update_page(Page* page, PageId new_page_id, frame_id_t new_frame_id);
+    void flush_log_for(lsn_t page_lsn);
 
-    bool del_from_flush_list(Page* page);
+    size_t write_back_frames(std::vector<frame_id_t> *frames);
 
+    void write_back_all(std::vector<frame_id_t> *frames);
 
 
     void gc();
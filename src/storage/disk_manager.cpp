@@ -11,13 +11,24 @@ See the Mulan PSL v2 for more details. */
 #include "storage/disk_manager.h"
 
 #include <assert.h>    // for assert
+#include <dirent.h>    // for opendir
+#include <limits.h>    // for PATH_MAX
 #include <string.h>    // for memset
+#include <stdlib.h>    // for getenv
 #include <sys/stat.h>  // for stat
 #include <unistd.h>    // for lseek
 
 #include "defs.h"
+#include "storage/page_io.h"
 
-DiskManager::DiskManager() { memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char))); }
+DiskManager::DiskManager() {
+    memset(fd2pageno_, 0, MAX_FD * (sizeof(std::atomic<page_id_t>) / sizeof(char)));
+    if (ENABLE_PAGE_WRITER) {
+        page_writer_ = std::make_unique<PageWriter>();
+    }
+    const char *env = std::getenv("RMDB_DIRECT_IO");
+    direct_io_ = env != nullptr ? strcmp(env, "0") != 0 : ENABLE_DIRECT_IO;
+}
 
 /**
  * @description: 将数据写入文件的指定磁盘页面中
@@ -31,11 +42,18 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
     // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
     // 2.调用write()函数
     // 注意write返回值与num_bytes不等时 throw InternalError("DiskManager::write_page Error");
-    int result = lseek(fd, page_no*PAGE_SIZE, SEEK_SET);
-    if (result != page_no*PAGE_SIZE) {
-        throw InternalError("DiskManager::write_page lseek Error");
+    if (direct_fd_[fd] && (num_bytes % PAGE_SIZE != 0 || !is_io_aligned(offset))) {
+        // O_DIRECT文件只能整页写入对齐的内存
+        write_aligned(fd, page_no, offset, num_bytes);
+        return;
+    }
+    if (page_writer_ != nullptr) {
+        // 同步写需要与后台线程的写入排序，交给page_writer_完成
+        page_writer_->write_sync(PageId{fd, page_no}, offset, num_bytes);
+        return;
     }
-    int bytes_written = write(fd, offset, num_bytes);
+    // 使用pwrite，不修改文件偏移量，多个线程可以并发读写同一个文件
+    ssize_t bytes_written = pwrite(fd, offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE);
     if (bytes_written != num_bytes) {
         throw InternalError("DiskManager::write_page write Error");
     }
@@ -45,6 +63,20 @@ void DiskManager::write_page(int fd, page_id_t page_no, const char *offset, int
     }
 }
 
+/**
+ * @description: 将脏页交给后台线程异步写回(write-back模式)，调用者不等待磁盘刷新，持久性由WAL保证
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} page_no 写入目标页面的page_id
+ * @param {char} *offset 要写入磁盘的数据，大小为PAGE_SIZE
+ */
+void DiskManager::write_page_async(int fd, page_id_t page_no, const char *offset) {
+    if (page_writer_ == nullptr) {
+        write_page(fd, page_no, offset, PAGE_SIZE);
+        return;
+    }
+    page_writer_->enqueue(PageId{fd, page_no}, offset);
+}
+
 /**
  * @description: 读取文件中指定编号的页面中的部分数据到内存中
  * @param {int} fd 磁盘文件的文件句柄
@@ -57,18 +89,110 @@ void DiskManager::read_page(int fd, page_id_t page_no, char *offset, int num_byt
     // 1.lseek()定位到文件头，通过(fd,page_no)可以定位指定页面及其在磁盘文件中的偏移量
     // 2.调用read()函数
     // 注意read返回值与num_bytes不等时，throw InternalError("DiskManager::read_page Error");
-    int result = lseek(fd, page_no*PAGE_SIZE, SEEK_SET);
-    if (result != page_no*PAGE_SIZE) {
-        throw InternalError("DiskManager::read_page lseek Error");
+    // 页面可能还在写回队列中没有落盘，此时队列中的才是最新版本
+    if (page_writer_ != nullptr && num_bytes <= PAGE_SIZE) {
+        char buf[PAGE_SIZE];
+        if (page_writer_->read_pending(PageId{fd, page_no}, buf)) {
+            memcpy(offset, buf, num_bytes);
+            return;
+        }
+    }
+    if (direct_fd_[fd] && (num_bytes % PAGE_SIZE != 0 || !is_io_aligned(offset))) {
+        read_aligned(fd, page_no, offset, num_bytes);
+        return;
     }
-    
-    int bytes_read = read(fd, offset, num_bytes);
+    // 缓冲池的缺页读取在分区latch_之外进行，使用pread保证并发读取的正确性
+    ssize_t bytes_read = pread(fd, offset, num_bytes, static_cast<off_t>(page_no) * PAGE_SIZE);
     //std::cout<<"bytes_read: "<<bytes_read<<" num_bytes: "<<num_bytes<<std::endl;
     if (bytes_read != num_bytes) {
         throw InternalError("DiskManager::read_page read Error");
     }
 }
 
+/**
+ * @description: 一次读取文件中从start_page_no开始的count个连续页面
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {page_id_t} start_page_no 第一个页面的编号
+ * @param {char *const *} bufs 每个页面的目标内存，大小均为PAGE_SIZE
+ * @param {int} count 页面个数
+ */
+void DiskManager::read_pages(int fd, page_id_t start_page_no, char *const *bufs, int count) {
+    if (direct_fd_[fd] && !std::all_of(bufs, bufs + count, [](const char *buf) { return is_io_aligned(buf); })) {
+        for (int i = 0; i < count; ++i) {
+            read_page(fd, start_page_no + i, bufs[i], PAGE_SIZE);
+        }
+        return;
+    }
+    if (!pread_pages(fd, start_page_no, bufs, count)) {
+        throw InternalError("DiskManager::read_pages read Error");
+    }
+    // 写回队列中的页面比磁盘上的新，覆盖读到的旧数据
+    if (page_writer_ != nullptr) {
+        for (int i = 0; i < count; ++i) {
+            page_writer_->read_pending(PageId{fd, start_page_no + i}, bufs[i]);
+        }
+    }
+}
+
+/**
+ * @description: 同步写入同一文件中的多个页面，页号连续的页面合并为一次pwritev，所有页面写完后只刷盘一次
+ * @param {int} fd 磁盘文件的文件句柄
+ * @param {vector<pair<page_id_t, const char *>>} &pages <页号, 页面数据>，页面大小均为PAGE_SIZE
+ */
+void DiskManager::write_pages(int fd, std::vector<std::pair<page_id_t, const char *>> &pages) {
+    if (pages.empty()) {
+        return;
+    }
+    if (direct_fd_[fd] && !std::all_of(pages.begin(), pages.end(), [](const auto &page) { return is_io_aligned(page.second); })) {
+        for (auto &page : pages) {
+            write_page(fd, page.first, page.second, PAGE_SIZE);
+        }
+        return;
+    }
+    if (page_writer_ != nullptr) {
+        page_writer_->write_sync(fd, pages);
+        return;
+    }
+    if (!pwrite_page_runs(fd, pages)) {
+        throw InternalError("DiskManager::write_pages write Error");
+    }
+    if (fsync(fd) == -1) {
+        throw InternalError("DiskManager::write_pages fsync Error");
+    }
+}
+
+/**
+ * @description: O_DIRECT文件的非对齐读取: 整页读入对齐的临时内存，再拷贝需要的部分
+ */
+void DiskManager::read_aligned(int fd, page_id_t page_no, char *offset, int num_bytes) {
+    int num_pages = (num_bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+    AlignedPageBuf buf = alloc_aligned_pages(num_pages);
+    ssize_t bytes_read = pread(fd, buf.get(), static_cast<size_t>(num_pages) * PAGE_SIZE,
+                               static_cast<off_t>(page_no) * PAGE_SIZE);
+    if (bytes_read < num_bytes) {
+        throw InternalError("DiskManager::read_page read Error");
+    }
+    memcpy(offset, buf.get(), num_bytes);
+}
+
+/**
+ * @description: O_DIRECT文件的非对齐写入: 不足整页时先读出页面原有内容(不存在的部分补0)，覆盖后整页写入
+ */
+void DiskManager::write_aligned(int fd, page_id_t page_no, const char *offset, int num_bytes) {
+    int num_pages = (num_bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+    AlignedPageBuf buf = alloc_aligned_pages(num_pages);
+    if (num_bytes % PAGE_SIZE != 0) {
+        char *last = buf.get() + static_cast<size_t>(num_pages - 1) * PAGE_SIZE;
+        page_id_t last_page_no = page_no + num_pages - 1;
+        if (page_writer_ == nullptr || !page_writer_->read_pending(PageId{fd, last_page_no}, last)) {
+            ssize_t bytes_read = pread(fd, last, PAGE_SIZE, static_cast<off_t>(last_page_no) * PAGE_SIZE);
+            memset(last + std::max<ssize_t>(bytes_read, 0), 0, PAGE_SIZE - std::max<ssize_t>(bytes_read, 0));
+        }
+    }
+    memcpy(buf.get(), offset, num_bytes);
+    write_page(fd, page_no, buf.get(), num_pages * PAGE_SIZE);
+}
+
 /**
  * @description: 分配一个新的页号
  * @return {page_id_t} 分配的新页号
@@ -189,8 +313,9 @@ void DiskManager::destroy_file(const std::string &path) {
  * @description: 打开指定路径文件 
  * @return {int} 返回打开的文件的文件句柄
  * @param {string} &path 文件所在路径
+ * @param {bool} data_file 是否为表文件或索引文件，开启direct io时数据文件以O_DIRECT打开
  */
-int DiskManager::open_file(const std::string &path) {
+int DiskManager::open_file(const std::string &path, bool data_file) {
     // Todo:
     // 调用open()函数，使用O_RDWR模式
     // 注意不能重复打开相同文件，并且需要更新文件打开列表
@@ -203,7 +328,16 @@ int DiskManager::open_file(const std::string &path) {
     }
 
     // 调用 open() 函数以读写模式打开文件
-    int fd = open(path.c_str(), O_RDWR);
+    int fd = -1;
+    bool direct = false;
+    if (data_file && direct_io_) {
+        fd = open(path.c_str(), O_RDWR | O_DIRECT);
+        direct = fd != -1;
+    }
+    // 部分文件系统(如tmpfs)不支持O_DIRECT，此时退化为普通读写
+    if (fd == -1) {
+        fd = open(path.c_str(), O_RDWR);
+    }
     if (fd == -1) {
         // 如果文件打开失败，抛出异常
         throw FileNotFoundError("Failed to open file: " + path);
@@ -211,10 +345,20 @@ int DiskManager::open_file(const std::string &path) {
     // 成功打开文件后，更新打开文件列表
     fd2path_[fd]=path;
     path2fd_[path] = fd;
+    direct_fd_[fd] = direct;
     // 返回文件句柄
     return fd;
 }
 
+/**
+ * @description: 把写回队列中的所有页面写回并刷盘，之后所有通过write_page_async提交的页面都已经持久化
+ */
+void DiskManager::flush_async_pages() {
+    if (page_writer_ != nullptr) {
+        page_writer_->flush_all();
+    }
+}
+
 /**
  * @description:用于关闭指定路径文件 
  * @param {int} fd 打开的文件的文件句柄
@@ -229,6 +373,11 @@ void DiskManager::close_file(int fd) {
         throw std::runtime_error("File descriptor is not open: " + std::to_string(fd));
     }
 
+    // 关闭前把写回队列中属于该文件的页面写回，避免fd被复用后写错文件
+    if (page_writer_ != nullptr) {
+        page_writer_->flush_file(fd);
+    }
+
     // 调用 close() 函数关闭文件
     if (close(fd) == -1) {
         throw std::runtime_error("Failed to close file descriptor: " + std::to_string(fd));
@@ -238,6 +387,7 @@ void DiskManager::close_file(int fd) {
     std::string path = it->second;
     path2fd_.erase(path);
     fd2path_.erase(it);
+    direct_fd_[fd] = false;
 }
 
 
@@ -277,70 +427,240 @@ int DiskManager::get_file_fd(const std::string &file_name) {
 }
 
 
+/**
+ * @description: 打开数据库目录下已有的日志段，建立日志段的内存索引，之后读写日志不再需要stat文件。
+ * 必须在当前工作目录为数据库目录、且已经打开日志文件头(SetLogFd)之后调用
+ */
+void DiskManager::open_log_segments() {
+    std::lock_guard<std::mutex> guard(log_latch_);
+    for (auto &seg : log_segments_) {
+        close(seg.second);
+    }
+    log_segments_.clear();
+    unsynced_segments_.clear();
+
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        throw UnixError();
+    }
+    log_dir_ = cwd;
+
+    DIR *dir = opendir(".");
+    if (dir == nullptr) {
+        throw UnixError();
+    }
+    std::string prefix = LOG_FILE_NAME + ".";
+    while (struct dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.find_first_not_of("0123456789", prefix.size()) != std::string::npos) {
+            continue;
+        }
+        int fd = open(name.c_str(), O_RDWR);
+        if (fd < 0) {
+            closedir(dir);
+            throw UnixError();
+        }
+        log_segments_[std::stoi(name.substr(prefix.size()))] = fd;
+    }
+    closedir(dir);
+
+    // 日志的逻辑大小 = 最后一个日志段的起始位置 + 该段的文件大小；没有日志段时只有日志文件头
+    struct stat stat_buf;
+    int size_fd = log_segments_.empty() ? log_fd_ : log_segments_.rbegin()->second;
+    if (fstat(size_fd, &stat_buf) == -1) {
+        throw UnixError();
+    }
+    int base = log_segments_.empty() ? 0 : log_segments_.rbegin()->first * LOG_SEGMENT_SIZE;
+    log_size_ = base + static_cast<int>(stat_buf.st_size);
+}
+
+/**
+ * @description: 获取日志段的文件句柄，调用者需持有log_latch_
+ * @return {int} 日志段不存在且create为false时返回-1
+ * @param {int} seg_no 日志段号
+ * @param {bool} create 日志段不存在时是否创建
+ */
+int DiskManager::log_segment_fd(int seg_no, bool create) {
+    auto it = log_segments_.find(seg_no);
+    if (it != log_segments_.end()) {
+        return it->second;
+    }
+    if (!create) {
+        return -1;
+    }
+    std::string path = log_dir_ + "/" + LOG_FILE_NAME + "." + std::to_string(seg_no);
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        throw UnixError();
+    }
+    // 新建的日志段需要把目录项刷盘，否则崩溃后整个日志段可能丢失
+    sync_log_dir();
+    log_segments_[seg_no] = fd;
+    return fd;
+}
+
+/**
+ * @description: 把日志段所在目录的目录项刷盘，使日志段的创建和删除在崩溃后仍然有效
+ */
+void DiskManager::sync_log_dir() {
+    int dir_fd = open(log_dir_.c_str(), O_RDONLY);
+    if (dir_fd < 0) {
+        throw UnixError();
+    }
+    if (fsync(dir_fd) == -1) {
+        close(dir_fd);
+        throw UnixError();
+    }
+    close(dir_fd);
+}
+
+/**
+ * @description: 关闭并删除一个日志段，调用者需持有log_latch_
+ */
+void DiskManager::remove_log_segment(std::map<int, int>::iterator it) {
+    std::string path = log_dir_ + "/" + LOG_FILE_NAME + "." + std::to_string(it->first);
+    close(it->second);
+    unsynced_segments_.erase(it->first);
+    log_segments_.erase(it);
+    if (unlink(path.c_str()) == -1) {
+        throw UnixError();
+    }
+}
+
 /**
  * @description:  读取日志文件内容
- * @return {int} 返回读取的数据量，若为-1说明读取数据的起始位置超过了文件大小
+ * @return {int} 返回读取的数据量，若为-1说明读取数据的起始位置超过了文件大小，或者所在的日志段已经被回收
  * @param {char} *log_data 读取内容到log_data中
  * @param {int} size 读取的数据量大小
  * @param {int} offset 读取的内容在文件中的位置
  */
 int DiskManager::read_log(char *log_data, int size, int offset) {
-    // read log file from the previous end
-    if (log_fd_ == -1) {
-        log_fd_ = open_file(LOG_FILE_NAME);
-    }
-    int file_size = get_file_size(LOG_FILE_NAME);
+    int file_size = log_size_;
     if (offset > file_size) {
         return -1;
     }
 
     size = std::min(size, file_size - offset);
     if(size == 0) return 0;
-    lseek(log_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_data, size);
-    assert(bytes_read == size);
-    return bytes_read;
+    std::lock_guard<std::mutex> guard(log_latch_);
+    // 读取的范围可能跨越多个日志段
+    for (int done = 0; done < size;) {
+        int pos = offset + done;
+        int len = std::min(size - done, LOG_SEGMENT_SIZE - pos % LOG_SEGMENT_SIZE);
+        int fd = log_segment_fd(pos / LOG_SEGMENT_SIZE, false);
+        if (fd == -1) {
+            return -1;
+        }
+        ssize_t bytes_read = pread(fd, log_data + done, len, pos % LOG_SEGMENT_SIZE);
+        assert(bytes_read == len);
+        done += len;
+    }
+    return size;
 }
 
 
 /**
- * @description: 写日志内容
+ * @description: 写日志内容，写入范围跨越日志段边界时拆分到多个日志段中
  * @param {char} *log_data 要写入的日志内容
  * @param {int} size 要写入的内容大小
+ * @param {int} offset 写入位置，即第一条日志的lsn
  */
-void DiskManager::write_log(char *log_data, int size) {
-    if (log_fd_ == -1) {
-        log_fd_ = get_file_fd(LOG_FILE_NAME);
+void DiskManager::write_log(char *log_data, int size, int offset) {
+    std::lock_guard<std::mutex> guard(log_latch_);
+    for (int done = 0; done < size;) {
+        int pos = offset + done;
+        int seg_no = pos / LOG_SEGMENT_SIZE;
+        int len = std::min(size - done, LOG_SEGMENT_SIZE - pos % LOG_SEGMENT_SIZE);
+        ssize_t bytes_write = pwrite(log_segment_fd(seg_no, true), log_data + done, len, pos % LOG_SEGMENT_SIZE);
+        if (bytes_write != len) {
+            throw UnixError();
+        }
+        unsynced_segments_.insert(seg_no);
+        done += len;
     }
+    if (offset + size > log_size_) {
+        log_size_ = offset + size;
+    }
+}
 
-    // write from the file_end
-    lseek(log_fd_, 0, SEEK_END);
-    ssize_t bytes_write = write(log_fd_, log_data, size);
-    if (bytes_write != size) {
-        throw UnixError();
+/**
+ * @description: 获取日志的逻辑大小，由内存中的日志段索引维护，不访问文件系统
+ */
+int DiskManager::get_log_size() { return log_size_; }
+
+/**
+ * @description: 截断日志，丢弃崩溃时没有写完整的日志尾部，size之后的日志段直接删除
+ * @param {int} size 截断后的日志大小
+ */
+void DiskManager::truncate_log(int size) {
+    std::lock_guard<std::mutex> guard(log_latch_);
+    for (auto it = log_segments_.lower_bound(size / LOG_SEGMENT_SIZE); it != log_segments_.end();) {
+        auto next = std::next(it);
+        if (it->first * LOG_SEGMENT_SIZE >= size) {
+            remove_log_segment(it);
+        } else if (ftruncate(it->second, size % LOG_SEGMENT_SIZE) == -1) {
+            throw UnixError();
+        }
+        it = next;
     }
+    log_size_ = size;
 }
 
+/**
+ * @description: 回收不再需要的日志段。redo_lsn之前的日志在恢复时不会再被读取，完全位于其之前的日志段直接删除。
+ *  调用者必须先把记录新检查点位置的启动文件和日志文件头持久化(write_start_file/write_log_header)，
+ *  否则崩溃后恢复可能从已经删除的日志段开始读取；删除之后把目录项刷盘
+ * @param {int} redo_lsn 恢复时开始扫描日志的位置
+ */
+void DiskManager::recycle_log(int redo_lsn) {
+    std::lock_guard<std::mutex> guard(log_latch_);
+    bool removed = false;
+    while (!log_segments_.empty() && (log_segments_.begin()->first + 1) * LOG_SEGMENT_SIZE <= redo_lsn) {
+        remove_log_segment(log_segments_.begin());
+        removed = true;
+    }
+    if (removed) {
+        sync_log_dir();
+    }
+}
+
+/**
+ * @description: 把已经写入的日志刷到磁盘，只刷新上次刷盘之后写过的日志段
+ */
+void DiskManager::sync_log() {
+    std::lock_guard<std::mutex> guard(log_latch_);
+    for (int seg_no : unsynced_segments_) {
+        if (fdatasync(log_segments_[seg_no]) == -1) {
+            throw UnixError();
+        }
+    }
+    unsynced_segments_.clear();
+}
 
 int DiskManager::read_log_header(char *log_header,int size){
     if (log_fd_ == -1) {
         log_fd_ = get_file_fd(LOG_FILE_NAME);
     }
-    lseek(log_fd_, 0, SEEK_SET);
-    ssize_t bytes_read = read(log_fd_, log_header, size);
+    ssize_t bytes_read = pread(log_fd_, log_header, size, 0);
     assert(bytes_read == size);
     return bytes_read;
 }
 
+/**
+ * @description: 写日志文件头并刷盘。检查点在回收日志段之前调用，日志文件头必须先于日志段的删除落盘
+ */
 void DiskManager::write_log_header(char *log_header,int size){
     if (log_fd_ == -1) {
         log_fd_ = get_file_fd(LOG_FILE_NAME);
     }
-    lseek(log_fd_, 0, SEEK_SET);
-    ssize_t bytes_write = write(log_fd_, log_header, size);
+    ssize_t bytes_write = pwrite(log_fd_, log_header, size, 0);
     if (bytes_write != size) {
         throw UnixError();
     }
+    if (fdatasync(log_fd_) == -1) {
+        throw UnixError();
+    }
 }
 
 
@@ -356,8 +676,7 @@ int DiskManager::read_start_file(char *data,int size,int offset){
 
     size = std::min(size, file_size - offset);
     if(size == 0) return 0;
-    lseek(start_fd_, offset, SEEK_SET);
-    ssize_t bytes_read = read(start_fd_, data, size);
+    ssize_t bytes_read = pread(start_fd_, data, size, offset);
     assert(bytes_read == size);
     return bytes_read;
 }
@@ -368,9 +687,12 @@ void DiskManager::write_start_file(char *data,int size){
          start_fd_ = get_file_fd(START_FILE_NAME);
     }
     // write from the file_start
-    lseek(start_fd_, 0, SEEK_SET);
-    ssize_t bytes_write = write(start_fd_, data, size);
+    ssize_t bytes_write = pwrite(start_fd_, data, size, 0);
     if (bytes_write != size) {
         throw UnixError();
     }
+    // 检查点位置落盘之后才能回收它之前的日志段
+    if (fdatasync(start_fd_) == -1) {
+        throw UnixError();
+    }
 }
\ No newline at end of file
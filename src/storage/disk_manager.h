@@ -17,12 +17,17 @@ See the Mulan PSL v2 for more details. */
 #include <atomic>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <set>
+#include <vector>
 
 #include "common/config.h"
 #include "errors.h"  
+#include "page_writer.h"
 
 /**
  * @description: DiskManager的作用主要是根据上层的需要对磁盘文件进行操作
@@ -35,8 +40,16 @@ class DiskManager {
 
     void write_page(int fd, page_id_t page_no, const char *offset, int num_bytes);
 
+    void write_page_async(int fd, page_id_t page_no, const char *offset);
+
     void read_page(int fd, page_id_t page_no, char *offset, int num_bytes);
 
+    void read_pages(int fd, page_id_t start_page_no, char *const *bufs, int count);
+
+    void write_pages(int fd, std::vector<std::pair<page_id_t, const char *>> &pages);
+
+    void flush_async_pages();
+
     page_id_t allocate_page(int fd);
 
     void deallocate_page(page_id_t page_id);
@@ -55,7 +68,9 @@ class DiskManager {
 
     void destroy_file(const std::string &path);
 
-    int open_file(const std::string &path);
+    int open_file(const std::string &path, bool data_file = false);
+
+    bool is_direct_io() const { return direct_io_; }
 
     void close_file(int fd);
 
@@ -68,7 +83,17 @@ class DiskManager {
     /*日志操作*/
     int read_log(char *log_data, int size, int offset);
 
-    void write_log(char *log_data, int size);
+    void write_log(char *log_data, int size, int offset);
+
+    void truncate_log(int size);
+
+    int get_log_size();
+
+    void open_log_segments();
+
+    void recycle_log(int redo_lsn);
+
+    void sync_log();
 
     int read_log_header(char *log_header,int size);
 
@@ -107,9 +132,30 @@ class DiskManager {
     std::unordered_map<std::string, int> path2fd_;  //<Page文件磁盘路径,Page fd>哈希表
     std::unordered_map<int, std::string> fd2path_;  //<Page fd,Page文件磁盘路径>哈希表
 
-    int log_fd_ = -1;                             // WAL日志文件的文件句柄，默认为-1，代表未打开日志文件
+    int log_fd_ = -1;                             // WAL日志文件(只存放日志文件头)的文件句柄，默认为-1，代表未打开日志文件
+
+    // WAL按LOG_SEGMENT_SIZE分段存放，日志段i(文件db.log.i)存放lsn位于[i*LOG_SEGMENT_SIZE, (i+1)*LOG_SEGMENT_SIZE)的日志
+    std::mutex log_latch_;                        // 保护log_segments_和unsynced_segments_
+    std::string log_dir_;                         // 日志段所在的数据库目录(绝对路径)，读写日志与当前工作目录无关
+    std::map<int, int> log_segments_;             // 日志段号 -> 文件句柄，即日志段边界的内存索引
+    std::set<int> unsynced_segments_;             // 写入后尚未刷盘的日志段
+    std::atomic<int> log_size_{0};                // 日志的逻辑大小，即最后一条日志的结束位置
     std::atomic<page_id_t> fd2pageno_[MAX_FD]{};  // 文件中已经分配的页面个数，初始值为0
 
     int start_fd_ = -1;
 
+    std::unique_ptr<PageWriter> page_writer_;     // write-back模式下的后台刷脏线程，未开启时为nullptr
+
+    bool direct_io_ = false;                      // 表文件和索引文件是否以O_DIRECT打开
+    bool direct_fd_[MAX_FD]{};                    // 文件是否以O_DIRECT打开，读写时需要对齐
+
+    void read_aligned(int fd, page_id_t page_no, char *offset, int num_bytes);
+
+    int log_segment_fd(int seg_no, bool create);
+
+    void remove_log_segment(std::map<int, int>::iterator it);
+
+    void sync_log_dir();
+
+    void write_aligned(int fd, page_id_t page_no, const char *offset, int num_bytes);
 };
\ No newline at end of file
@@ -10,6 +10,9 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
+
 #include "common/config.h"
 
 /**
@@ -27,7 +30,7 @@ struct PageId {
 
     friend bool operator==(const PageId &x, const PageId &y) { return x.fd == y.fd && x.page_no == y.page_no; }
     bool operator<(const PageId& x) const {
-        if(fd < x.fd) return true;
+        if(fd != x.fd) return fd < x.fd;
         return page_no < x.page_no;
     }
 
@@ -53,13 +56,16 @@ struct std::hash<PageId> {
 /**
  * @description: Page类声明, Page是RMDB数据块的单位、是负责数据操作Record模块的操作对象，
  * Page对象在磁盘上有文件存储, 若在Buffer中则有帧偏移, 并非特指Buffer或Disk上的数据
+ * 缓冲池中的Page只是帧描述符，页面数据位于BufferPoolManager的连续帧内存中，由data_指向。
+ * 描述符按缓存行对齐，扫描元数据(如flush_all_pages)时不会访问页面数据，相邻帧的pin_count_也不会伪共享
  */
-class Page {
+class alignas(64) Page {
     friend class BufferPoolManager;
 
    public:
     
-    Page() { reset_memory(); }
+    // data_由BufferPoolManager指向对齐的帧内存，并在分配时清零
+    Page() = default;
 
     ~Page() = default;
 
@@ -68,8 +74,8 @@ class Page {
 
     inline char *get_data() { return data_; }
 
-    bool is_dirty() const { return is_dirty_; }
-    void set_dirty(bool is_dirty){is_dirty_ = is_dirty;}
+    bool is_dirty() const { return is_dirty_.load(std::memory_order_relaxed); }
+    void set_dirty(bool is_dirty){is_dirty_.store(is_dirty, std::memory_order_relaxed);}
 
 
     static constexpr size_t OFFSET_PAGE_START = 0;
@@ -83,21 +89,36 @@ class Page {
    private:
     void reset_memory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }  // 将data_的PAGE_SIZE个字节填充为0
 
+    // 页面写回后清除脏标记和recLSN
+    void clear_dirty() {
+        is_dirty_.store(false, std::memory_order_relaxed);
+        oldest_modification.store(INVALID_LSN, std::memory_order_relaxed);
+    }
+
     /** page的唯一标识符 */
     PageId id_;
 
     /** The actual data that is stored within a page.
-     *  该页面在bufferPool中的偏移地址
+     *  该页面在bufferPool中的偏移地址，指向BufferPoolManager按DIRECT_IO_ALIGNMENT对齐的帧内存
      */
-    char data_[PAGE_SIZE] = {};
+    char *data_ = nullptr;
+
+    /** 脏页判断，上层修改页面后不持有分区latch_直接标记 */
+    std::atomic<bool> is_dirty_{false};
+
+    /** The pin count of this page. 为-1时表示帧被持有分区latch_的线程锁定(正在淘汰或重新分配)，不能被pin */
+    std::atomic<int> pin_count_{0};
+
+    /** 该帧正在从磁盘读入数据，读完之前其他线程不能使用，需要在分区的io_cv_上等待 */
+    std::atomic<bool> io_in_progress_{false};
 
-    /** 脏页判断 */
-    bool is_dirty_ = false;
+    /** 帧当前存放页面的编码(见BufferPoolManager::page_tag)，无锁命中路径用它校验帧是否仍然存放着目标页面 */
+    std::atomic<uint64_t> tag_{UINT64_MAX};
 
-    /** The pin count of this page. */
-    int pin_count_ = 0;
+    /** 访问位，无锁命中时设置，淘汰时据此延迟通知replacer */
+    std::atomic<bool> ref_{false};
 
-    /**redo log**/
-    lsn_t oldest_modification;
+    /** recLSN: 页面从干净变为脏时登记，此lsn之前的日志对应的修改都已反映在页面上；页面干净时为INVALID_LSN */
+    std::atomic<lsn_t> oldest_modification{INVALID_LSN};
     lsn_t newest_modification;
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * @description: 页面的向量化读写，一次系统调用完成文件中连续多个页面的读写。
+ * 使用preadv/pwritev，不依赖也不修改文件偏移量，多个线程可以并发访问同一个文件
+ */
+
+static_assert(PAGE_SIZE % DIRECT_IO_ALIGNMENT == 0, "PAGE_SIZE must be a multiple of DIRECT_IO_ALIGNMENT");
+
+struct AlignedFree {
+    void operator()(char *ptr) const { std::free(ptr); }
+};
+
+// 按DIRECT_IO_ALIGNMENT对齐的页面内存，可以直接用于O_DIRECT读写
+using AlignedPageBuf = std::unique_ptr<char[], AlignedFree>;
+
+/**
+ * @description: 申请count个页面大小、按DIRECT_IO_ALIGNMENT对齐的内存
+ */
+inline AlignedPageBuf alloc_aligned_pages(size_t count) {
+    char *ptr = static_cast<char *>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, count * PAGE_SIZE));
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return AlignedPageBuf(ptr);
+}
+
+inline bool is_io_aligned(const void *ptr) { return reinterpret_cast<uintptr_t>(ptr) % DIRECT_IO_ALIGNMENT == 0; }
+
+/**
+ * @description: 将从start_page_no开始的count个连续页面读入bufs
+ * @return {bool} 读取的字节数与count个页面大小一致时返回true
+ */
+inline bool pread_pages(int fd, page_id_t start_page_no, char *const *bufs, int count) {
+    struct iovec iov[IOV_MAX];
+    int done = 0;
+    while (done < count) {
+        int n = std::min(count - done, IOV_MAX);
+        for (int i = 0; i < n; ++i) {
+            iov[i].iov_base = bufs[done + i];
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        ssize_t bytes_read = preadv(fd, iov, n, static_cast<off_t>(start_page_no + done) * PAGE_SIZE);
+        if (bytes_read != static_cast<ssize_t>(n) * PAGE_SIZE) {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+/**
+ * @description: 将bufs写入从start_page_no开始的count个连续页面，不刷盘
+ * @return {bool} 写入的字节数与count个页面大小一致时返回true
+ */
+inline bool pwrite_pages(int fd, page_id_t start_page_no, const char *const *bufs, int count) {
+    struct iovec iov[IOV_MAX];
+    int done = 0;
+    while (done < count) {
+        int n = std::min(count - done, IOV_MAX);
+        for (int i = 0; i < n; ++i) {
+            iov[i].iov_base = const_cast<char *>(bufs[done + i]);
+            iov[i].iov_len = PAGE_SIZE;
+        }
+        ssize_t bytes_written = pwritev(fd, iov, n, static_cast<off_t>(start_page_no + done) * PAGE_SIZE);
+        if (bytes_written != static_cast<ssize_t>(n) * PAGE_SIZE) {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+/**
+ * @description: 写入同一文件中的一组页面(页号不要求连续)，按页号排序后每段连续的页面合并为一次pwritev，不刷盘
+ * @param {vector<pair<page_id_t, const char *>>} &pages <页号, 页面数据>，函数内会对其排序
+ * @return {bool} 全部写入成功返回true
+ */
+inline bool pwrite_page_runs(int fd, std::vector<std::pair<page_id_t, const char *>> &pages) {
+    std::sort(pages.begin(), pages.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<const char *> bufs;
+    size_t i = 0;
+    while (i < pages.size()) {
+        size_t j = i;
+        bufs.clear();
+        do {
+            bufs.push_back(pages[j].second);
+            ++j;
+        } while (j < pages.size() && pages[j].first == pages[j - 1].first + 1);
+        if (!pwrite_pages(fd, pages[i].first, bufs.data(), static_cast<int>(bufs.size()))) {
+            return false;
+        }
+        i = j;
+    }
+    return true;
+}
@@ -0,0 +1,233 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/page_writer.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#include "errors.h"
+#include "storage/page_io.h"
+
+PageWriter::PageWriter(size_t thread_num) : shards_(std::max<size_t>(thread_num, 1)) {
+    for (auto &shard : shards_) {
+        threads_.emplace_back(&PageWriter::run, this, &shard);
+    }
+}
+
+PageWriter::~PageWriter() {
+    stop_ = true;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> guard(shard.latch_);
+        shard.cv_.notify_all();
+    }
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+    // 线程退出前已经把队列写空，这里兜底一次
+    try {
+        flush_all();
+    } catch (RMDBError &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+/**
+ * @description: 将脏页拷贝放入写回队列，若队列中已有该页面的旧版本则直接覆盖
+ * @param {PageId} page_id 脏页的PageId
+ * @param {char*} data 页面数据，大小为PAGE_SIZE
+ */
+void PageWriter::enqueue(PageId page_id, const char *data) {
+    PageBuf buf(alloc_aligned_pages(1));  // O_DIRECT文件要求写入的内存对齐
+    memcpy(buf.get(), data, PAGE_SIZE);
+
+    Shard &shard = shard_of(page_id.fd);
+    std::unique_lock<std::mutex> lock(shard.latch_);
+    // 队列过长时阻塞调用者，避免脏页拷贝无限增长
+    shard.drained_cv_.wait(lock, [&] { return shard.pending_.size() < PAGE_WRITER_MAX_PENDING || stop_; });
+    shard.pending_[page_id] = std::move(buf);
+    if (shard.pending_.size() >= PAGE_WRITER_BATCH_SIZE) {
+        shard.cv_.notify_one();
+    }
+}
+
+/**
+ * @description: 若目标页面仍在写回队列中，则从队列中读取最新版本
+ * @return {bool} 页面在队列中返回true，否则返回false(需要从磁盘读取)
+ */
+bool PageWriter::read_pending(PageId page_id, char *data) {
+    Shard &shard = shard_of(page_id.fd);
+    std::lock_guard<std::mutex> guard(shard.latch_);
+    auto it = shard.pending_.find(page_id);
+    if (it == shard.pending_.end()) {
+        return false;
+    }
+    memcpy(data, it->second.get(), PAGE_SIZE);
+    return true;
+}
+
+/**
+ * @description: 同步写入一个页面并刷盘。队列中该页面的旧版本会被丢弃，防止其在之后覆盖新数据
+ */
+void PageWriter::write_sync(PageId page_id, const char *data, int num_bytes) {
+    Shard &shard = shard_of(page_id.fd);
+    std::lock_guard<std::mutex> io_guard(shard.io_latch_);
+    {
+        std::lock_guard<std::mutex> guard(shard.latch_);
+        shard.pending_.erase(page_id);
+        shard.drained_cv_.notify_all();
+    }
+    ssize_t bytes_written = pwrite(page_id.fd, data, num_bytes, static_cast<off_t>(page_id.page_no) * PAGE_SIZE);
+    if (bytes_written != num_bytes) {
+        throw InternalError("PageWriter::write_sync write Error");
+    }
+    if (fsync(page_id.fd) == -1) {
+        throw InternalError("PageWriter::write_sync fsync Error");
+    }
+}
+
+/**
+ * @description: 同步写入同一文件中的一组页面，连续的页面合并写入，最后只刷盘一次
+ * @param {vector<pair<page_id_t, const char *>>} &pages <页号, 页面数据>
+ */
+void PageWriter::write_sync(int fd, std::vector<std::pair<page_id_t, const char *>> &pages) {
+    Shard &shard = shard_of(fd);
+    std::lock_guard<std::mutex> io_guard(shard.io_latch_);
+    {
+        std::lock_guard<std::mutex> guard(shard.latch_);
+        for (auto &page : pages) {
+            shard.pending_.erase(PageId{fd, page.first});
+        }
+        shard.drained_cv_.notify_all();
+    }
+    if (!pwrite_page_runs(fd, pages)) {
+        throw InternalError("PageWriter::write_sync write Error");
+    }
+    if (fsync(fd) == -1) {
+        throw InternalError("PageWriter::write_sync fsync Error");
+    }
+}
+
+/**
+ * @description: 将指定文件在队列中的所有页面写回并刷盘，关闭文件前必须调用
+ */
+void PageWriter::flush_file(int fd) { drain(shard_of(fd), fd, SIZE_MAX); }
+
+/**
+ * @description: 丢弃指定文件在队列中的所有页面(文件即将被删除)
+ */
+void PageWriter::discard_file(int fd) {
+    Shard &shard = shard_of(fd);
+    std::lock_guard<std::mutex> io_guard(shard.io_latch_);
+    std::lock_guard<std::mutex> guard(shard.latch_);
+    for (auto it = shard.pending_.begin(); it != shard.pending_.end();) {
+        if (it->first.fd == fd) {
+            it = shard.pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    shard.drained_cv_.notify_all();
+}
+
+void PageWriter::flush_all() {
+    for (auto &shard : shards_) {
+        drain(shard, -1, SIZE_MAX);
+    }
+}
+
+size_t PageWriter::pending_count() {
+    size_t cnt = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> guard(shard.latch_);
+        cnt += shard.pending_.size();
+    }
+    return cnt;
+}
+
+/**
+ * @description: 后台线程主循环，队列攒够一个批次或等待超时后写回
+ */
+void PageWriter::run(Shard *shard) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(shard->latch_);
+            shard->cv_.wait_for(lock, PAGE_WRITER_INTERVAL, [&] {
+                return stop_ || shard->pending_.size() >= PAGE_WRITER_BATCH_SIZE;
+            });
+            if (shard->pending_.empty()) {
+                if (stop_) return;
+                continue;
+            }
+        }
+        try {
+            drain(*shard, -1, PAGE_WRITER_BATCH_SIZE);
+        } catch (RMDBError &e) {
+            // 后台线程无法向上抛出异常，失败的页面保留在队列中，下一轮重试
+            std::cerr << e.what() << std::endl;
+            if (stop_) return;
+            std::this_thread::sleep_for(PAGE_WRITER_INTERVAL);
+        }
+    }
+}
+
+/**
+ * @description: 从队列中取出最多limit个页面，按文件分组、按页号排序写入，每个文件只做一次fdatasync。
+ * 写入期间不持有latch_，读者仍可以从队列中读到页面；写完后只删除未被更新过的页面。
+ * @param {int} fd 只写回该文件的页面，-1表示所有文件
+ * @param {size_t} limit 本批次最多写回的页面个数
+ */
+void PageWriter::drain(Shard &shard, int fd, size_t limit) {
+    std::lock_guard<std::mutex> io_guard(shard.io_latch_);
+
+    std::map<int, std::vector<std::pair<page_id_t, PageBuf>>> batch;
+    {
+        std::lock_guard<std::mutex> guard(shard.latch_);
+        size_t cnt = 0;
+        for (auto &entry : shard.pending_) {
+            if (cnt >= limit) break;
+            if (fd != -1 && entry.first.fd != fd) continue;
+            batch[entry.first.fd].emplace_back(entry.first.page_no, entry.second);
+            cnt++;
+        }
+    }
+    if (batch.empty()) return;
+
+    std::vector<std::pair<page_id_t, const char *>> pages;
+    for (auto &file : batch) {
+        // 页号连续的页面合并为一次pwritev
+        pages.clear();
+        for (auto &page : file.second) {
+            pages.emplace_back(page.first, page.second.get());
+        }
+        if (!pwrite_page_runs(file.first, pages)) {
+            throw InternalError("PageWriter::drain write Error");
+        }
+        if (fdatasync(file.first) == -1) {
+            throw InternalError("PageWriter::drain fdatasync Error");
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(shard.latch_);
+    for (auto &file : batch) {
+        for (auto &page : file.second) {
+            auto it = shard.pending_.find(PageId{file.first, page.first});
+            // 写入期间页面可能又被淘汰了一次，此时保留新版本
+            if (it != shard.pending_.end() && it->second == page.second) {
+                shard.pending_.erase(it);
+            }
+        }
+    }
+    shard.drained_cv_.notify_all();
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 Renmin University of China
+RMDB is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+        http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "page.h"
+
+/**
+ * @description: 后台刷脏线程(write-back模式)。
+ * 缓冲池淘汰脏页时只把页面拷贝放入队列，由后台线程按文件批量pwrite，每个批次每个文件只调用一次fdatasync。
+ * 页面的持久性由WAL保证，淘汰路径不再等待磁盘刷新。
+ * 队列按fd分片，一个fd只会被一个线程处理，保证同一页面的多次写入按顺序落盘。
+ */
+class PageWriter {
+   public:
+    explicit PageWriter(size_t thread_num = PAGE_WRITER_THREAD_NUM);
+
+    ~PageWriter();
+
+    void enqueue(PageId page_id, const char *data);
+
+    bool read_pending(PageId page_id, char *data);
+
+    void write_sync(PageId page_id, const char *data, int num_bytes);
+
+    void write_sync(int fd, std::vector<std::pair<page_id_t, const char *>> &pages);
+
+    void flush_file(int fd);
+
+    void discard_file(int fd);
+
+    void flush_all();
+
+    size_t pending_count();
+
+   private:
+    using PageBuf = std::shared_ptr<char[]>;
+
+    struct Shard {
+        std::mutex latch_;                   // 保护pending_
+        std::mutex io_latch_;                // 同一分片内的磁盘写入互斥，保证写入顺序
+        std::condition_variable cv_;         // 通知后台线程有新的脏页
+        std::condition_variable drained_cv_; // 通知等待者队列已经缩短
+        std::unordered_map<PageId, PageBuf, PageIdHash> pending_;  // 等待写回的页面，同一页面只保留最新版本
+    };
+
+    Shard &shard_of(int fd) { return shards_[static_cast<size_t>(fd) % shards_.size()]; }
+
+    void run(Shard *shard);
+
+    void drain(Shard &shard, int fd, size_t limit);
+
+    std::vector<Shard> shards_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stop_{false};
+};
@@ -61,7 +61,7 @@ void SmManager::create_db(const std::string& db_name) {
     disk_manager_->create_file(LOG_FILE_NAME);
     int log_fd = disk_manager_->open_file(LOG_FILE_NAME);
     disk_manager_->SetLogFd(log_fd);
-    HeaderRecord *hrec = new HeaderRecord(36,-1,0);
+    HeaderRecord *hrec = new HeaderRecord(HEADER_RECORD_SIZE,-1,0);
     char hdr_buf[hrec->log_tot_len_];
     hrec->serialize(hdr_buf);
     disk_manager_->write_log_header(hdr_buf,hrec->log_tot_len_);
@@ -126,6 +126,7 @@ void SmManager::open_db(const std::string& db_name) {
     //打开日志文件
     int log_fd = disk_manager_->open_file(LOG_FILE_NAME);
     disk_manager_->SetLogFd(log_fd);
+    disk_manager_->open_log_segments();
 
     //打开启动文件
     int start_fd = disk_manager_->open_file(START_FILE_NAME);
@@ -140,6 +141,7 @@ void SmManager::open_db(const std::string& db_name) {
         for(auto &idx : tb_meta.indexes){
             std::string index_name = ix_manager_->get_index_name(tab_name, idx.cols);
             ihs_[index_name] = ix_manager_->open_index(tab_name, idx.cols);
+            ihs_[index_name]->set_log_manager(log_manager_);
         }
     }
     // 回到根目录
@@ -157,6 +159,25 @@ void SmManager::flush_meta() {
     ofs << db_;
 }
 
+/**
+ * @description: 设置日志管理器，之后打开的索引和已经打开的索引都通过它写INDEX日志
+ */
+void SmManager::set_log_manager(LogManager* log_manager) {
+    log_manager_ = log_manager;
+    for (auto &ih : ihs_) {
+        ih.second->set_log_manager(log_manager);
+    }
+}
+
+/**
+ * @description: 把所有打开的索引的文件头写回磁盘，检查点和恢复结束时调用
+ */
+void SmManager::flush_index_headers() {
+    for (auto &ih : ihs_) {
+        ih.second->write_file_hdr();
+    }
+}
+
 /**
  * @description: 关闭数据库并把数据落盘
  */
@@ -249,12 +270,31 @@ void SmManager::desc_table(const std::string& tab_name, Context* context) {
  * @description: 创建表
  * @param {string&} tab_name 表的名称
  * @param {vector<ColDef>&} col_defs 表的字段
+ * @param {vector<KeyDef>&} key_defs 表上声明的PRIMARY KEY/UNIQUE约束，每个约束由一个唯一索引支撑
  * @param {Context*} context 
  */
-void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context) {
+void SmManager::create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs,
+                             const std::vector<KeyDef>& key_defs, Context* context) {
     if (!is_dir(db_.name_)) {
         throw DatabaseNotFoundError(db_.name_);
     }
+    // 在创建任何文件之前检查约束定义，避免留下建了一半的表
+    bool has_primary = false;
+    for (size_t i = 0; i < key_defs.size(); ++i) {
+        auto &key_def = key_defs[i];
+        if (key_def.type == KEY_PRIMARY) {
+            if (has_primary) throw PrimaryKeyExistsError(tab_name);
+            has_primary = true;
+        }
+        for (auto &col_name : key_def.col_names) {
+            auto pos = std::find_if(col_defs.begin(), col_defs.end(),
+                                    [&](const ColDef &col_def) { return col_def.name == col_name; });
+            if (pos == col_defs.end()) throw ColumnNotFoundError(col_name);
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (key_defs[j].col_names == key_def.col_names) throw IndexExistsError(tab_name, key_def.col_names);
+        }
+    }
     if (chdir(db_.name_.c_str()) < 0) {  // 进入数据库目录
         throw UnixError();
     }
@@ -268,20 +308,25 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
     int curr_offset = 0;
     TabMeta tab;
     tab.name = tab_name;
-    for (auto &col_def : col_defs) {
+    tab.id = db_.next_tab_id_++;
+    std::vector<RmVarCol> var_cols;     // VARCHAR字段在页面中按实际长度存储
+    for (auto col_def : col_defs) {
         ColMeta col = {.tab_name = tab_name,
                        .name = col_def.name,
                        .type = col_def.type,
                        .len = col_def.len,
                        .offset = curr_offset,
                        .index = false};
+        if (col_def.type == TYPE_VARCHAR) {
+            var_cols.push_back(RmVarCol{curr_offset, col_def.len});
+        }
         curr_offset += col_def.len;
         tab.cols.push_back(col);
     }
     // Create & open record file
     int record_size = curr_offset;  // record_size就是col meta所占的大小（表的元数据也是以记录的形式进行存储的）
     //std::string tab_file_name = db_.name_ + "/" + tab_name;
-    rm_manager_->create_file(tab_name, record_size);
+    rm_manager_->create_file(tab_name, record_size, var_cols);
     db_.tabs_[tab_name] = tab;
     // fhs_[tab_name] = rm_manager_->open_file(tab_name);
     fhs_.emplace(tab_name, rm_manager_->open_file(tab_name));
@@ -292,6 +337,11 @@ void SmManager::create_table(const std::string& tab_name, const std::vector<ColD
     if (chdir("..") < 0) {
         throw UnixError();
     }
+
+    // 为每个约束建立唯一索引，插入和更新通过探测该索引检查唯一性
+    for (auto &key_def : key_defs) {
+        create_index(tab_name, key_def.col_names, context, key_def.type);
+    }
 }
 
 /**
@@ -313,11 +363,17 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
         throw TableNotFoundError(tab_name);
     }
     
-    // 删除表的所有索引
-    auto& tab_meta = db_.get_table(tab_name);
-    for(auto idx_meta : tab_meta.indexes){
+    // 删除表的所有索引，drop_index会自己进入数据库目录；遍历副本，drop_index会修改tab_meta.indexes
+    auto indexes = db_.get_table(tab_name).indexes;
+    if (chdir("..") < 0) {
+        throw UnixError();
+    }
+    for(auto &idx_meta : indexes){
         drop_index(tab_name,idx_meta.cols,context);
     }
+    if (chdir(db_.name_.c_str()) < 0) {
+        throw UnixError();
+    }
 
     // 删除表的数据文件
     disk_manager_->close_file(disk_manager_->get_file_fd(tab_name));
@@ -341,8 +397,10 @@ void SmManager::drop_table(const std::string& tab_name, Context* context) {
  * @param {string&} tab_name 表的名称
  * @param {vector<string>&} col_names 索引包含的字段名称
  * @param {Context*} context
+ * @param {KeyType} key_type 索引支撑的约束类型，CREATE INDEX语句为KEY_NONE
  */
-void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context) {
+void SmManager::create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                             KeyType key_type) {
     if (!is_dir(db_.name_)) {
         throw DatabaseNotFoundError(db_.name_);
     }
@@ -358,11 +416,17 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
     //check if index has exsit
     auto& tab_meta = db_.get_table(tab_name);
     if(tab_meta.is_index(col_names)){
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
         throw IndexExistsError(tab_name, col_names);
     }
     //check if col exist in table
     for(auto col_name : col_names){
         if(!tab_meta.is_col(col_name)){
+            if (chdir("..") < 0) {
+                throw UnixError();
+            }
             throw ColumnNotFoundError(col_name);
         }
     }
@@ -380,27 +444,29 @@ void SmManager::create_index(const std::string& tab_name, const std::vector<std:
     ix_manager_->create_index(tab_name,cols);
 
     //flush meta
-    IndexMeta idx_meta{tab_name,col_total_size,col_num,cols};
+    IndexMeta idx_meta{tab_name,col_total_size,col_num,cols,key_type};
     std::string index_name = ix_manager_->get_index_name(tab_name, cols);
     
     tab_meta.indexes.push_back(idx_meta);
     ihs_[index_name] = ix_manager_->open_index(tab_name, cols);
+    ihs_[index_name]->set_log_manager(log_manager_);
+    ihs_[index_name]->log_create(context != nullptr ? context->txn_ : nullptr);
     
     flush_meta();
 
-    //insert data in tables
+    //insert data in tables，键直接从扫描pin住的页面中拼接，不拷贝记录
     auto& file_hdr = fhs_[tab_name];
+    std::vector<char> key(idx_meta.col_tot_len);
     auto scan = std::make_unique<RmScan>(file_hdr.get());
     while(!scan->is_end()){
         auto rid = scan->rid();
-        auto rec = file_hdr->get_record(rid,nullptr);
-        char* key = new char[idx_meta.col_tot_len];
+        const char *data = scan->record().data;
         int offset = 0;
         for(int i = 0; i < idx_meta.col_num; ++i) {
-            memcpy(key + offset, rec->data + idx_meta.cols[i].offset, idx_meta.cols[i].len);
+            memcpy(key.data() + offset, data + idx_meta.cols[i].offset, idx_meta.cols[i].len);
             offset += idx_meta.cols[i].len;
         }
-        ihs_[index_name]->insert_entry(key, rid, context->txn_);
+        ihs_[index_name]->insert_entry(key.data(), rid, context != nullptr ? context->txn_ : nullptr);
         scan->next();
     }
 
@@ -24,6 +24,11 @@ struct ColDef {
     int len;           // Length of column
 };
 
+struct KeyDef {
+    KeyType type;                       // PRIMARY KEY or UNIQUE
+    std::vector<std::string> col_names; // Columns covered by the key
+};
+
 /* 系统管理器，负责元数据管理和DDL语句的执行 */
 class SmManager {
    public:
@@ -35,6 +40,7 @@ class SmManager {
     BufferPoolManager* buffer_pool_manager_;
     RmManager* rm_manager_;
     IxManager* ix_manager_;
+    LogManager* log_manager_ = nullptr;     // 索引的插入/删除通过它写INDEX日志
 
    public:
     SmManager(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager, RmManager* rm_manager,IxManager* ix_manager)
@@ -51,6 +57,8 @@ class SmManager {
 
     IxManager* get_ix_manager() { return ix_manager_; }  
 
+    void set_log_manager(LogManager* log_manager);
+
     std::string get_db_name(){return db_.name_;}
 
     bool is_dir(const std::string& db_name);
@@ -65,17 +73,21 @@ class SmManager {
 
     void flush_meta();
 
+    void flush_index_headers();
+
     void show_tables(Context* context);
 
     void show_indexs(const std::string& tab_name,Context* context);
 
     void desc_table(const std::string& tab_name, Context* context);
 
-    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs, Context* context);
+    void create_table(const std::string& tab_name, const std::vector<ColDef>& col_defs,
+                      const std::vector<KeyDef>& key_defs, Context* context);
 
     void drop_table(const std::string& tab_name, Context* context);
 
-    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
+    void create_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context,
+                      KeyType key_type = KEY_NONE);
 
     void drop_index(const std::string& tab_name, const std::vector<std::string>& col_names, Context* context);
     
@@ -45,9 +45,10 @@ struct IndexMeta {
     int col_tot_len;                // 索引字段长度总和
     int col_num;                    // 索引字段数量
     std::vector<ColMeta> cols;      // 索引包含的字段
+    KeyType key_type = KEY_NONE;    // 索引支撑的约束(PRIMARY KEY/UNIQUE)，CREATE INDEX建立的索引为KEY_NONE
     
     friend std::ostream &operator<<(std::ostream &os, const IndexMeta &index) {
-        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num;
+        os << index.tab_name << " " << index.col_tot_len << " " << index.col_num << " " << index.key_type;
         for(auto& col: index.cols) {
             os << "\n" << col;
         }
@@ -55,7 +56,7 @@ struct IndexMeta {
     }
 
     friend std::istream &operator>>(std::istream &is, IndexMeta &index) {
-        is >> index.tab_name >> index.col_tot_len >> index.col_num;
+        is >> index.tab_name >> index.col_tot_len >> index.col_num >> index.key_type;
         for(int i = 0; i < index.col_num; ++i) {
             ColMeta col;
             is >> col;
@@ -70,6 +71,7 @@ struct IndexMeta {
 /* 表元数据 */
 struct TabMeta {
     std::string name;                   // 表名称
+    int id = -1;                        // 表编号，创建表时分配且不会复用，日志中用它代替表名
     std::vector<ColMeta> cols;          // 表包含的字段
     std::vector<IndexMeta> indexes;     // 表上建立的索引
 
@@ -77,7 +79,9 @@ struct TabMeta {
 
     TabMeta(const TabMeta &other) {
         name = other.name;
+        id = other.id;
         for(auto col : other.cols) cols.push_back(col);
+        indexes = other.indexes;
     }
 
     /* 判断当前表中是否存在名为col_name的字段 */
@@ -143,7 +147,7 @@ struct TabMeta {
     }
 
     friend std::ostream &operator<<(std::ostream &os, const TabMeta &tab) {
-        os << tab.name << '\n' << tab.cols.size() << '\n';
+        os << tab.name << ' ' << tab.id << '\n' << tab.cols.size() << '\n';
         for (auto &col : tab.cols) {
             os << col << '\n';  // col是ColMeta类型，然后调用重载的ColMeta的操作符<<
         }
@@ -156,7 +160,7 @@ struct TabMeta {
 
     friend std::istream &operator>>(std::istream &is, TabMeta &tab) {
         size_t n;
-        is >> tab.name >> n;
+        is >> tab.name >> tab.id >> n;
         for (size_t i = 0; i < n; i++) {
             ColMeta col;
             is >> col;
@@ -180,6 +184,7 @@ class DbMeta {
    private:
     std::string name_;                      // 数据库名称
     std::map<std::string, TabMeta> tabs_;   // 数据库中包含的表
+    int next_tab_id_ = 0;                   // 下一个新建表的编号
 
    public:
     // DbMeta(std::string name) : name_(name) {}
@@ -203,9 +208,20 @@ class DbMeta {
         return pos->second;
     }
 
+    /* 获取所有表的元数据，按表名排序 */
+    const std::map<std::string, TabMeta> &get_tables() const { return tabs_; }
+
+    /* 根据表编号获取表的元数据，表不存在(已经被删除)时返回nullptr */
+    const TabMeta *get_table(int tab_id) const {
+        for (auto &entry : tabs_) {
+            if (entry.second.id == tab_id) return &entry.second;
+        }
+        return nullptr;
+    }
+
     // 重载操作符 <<
     friend std::ostream &operator<<(std::ostream &os, const DbMeta &db_meta) {
-        os << db_meta.name_ << '\n' << db_meta.tabs_.size() << '\n';
+        os << db_meta.name_ << ' ' << db_meta.next_tab_id_ << '\n' << db_meta.tabs_.size() << '\n';
         for (auto &entry : db_meta.tabs_) {
             os << entry.second << '\n';
         }
@@ -214,7 +230,7 @@ class DbMeta {
 
     friend std::istream &operator>>(std::istream &is, DbMeta &db_meta) {
         size_t n;
-        is >> db_meta.name_ >> n;
+        is >> db_meta.name_ >> db_meta.next_tab_id_ >> n;
         for (size_t i = 0; i < n; i++) {
             TabMeta tab;
             is >> tab;
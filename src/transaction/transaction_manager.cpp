@@ -64,8 +64,6 @@ void TransactionManager::commit(Transaction* txn, LogManager* log_manager) {
     // 3. 释放事务相关资源，eg.锁集
     // 4. 把事务日志刷入磁盘中
     // 5. 更新事务状态
-    RmManager* rm_mgr =  sm_manager_->get_rm_manager();
-    
     //释放所有锁
     auto lock_set = txn->get_lock_set();
     for (auto& lock_data_id : *lock_set) {
@@ -77,11 +75,20 @@ void TransactionManager::commit(Transaction* txn, LogManager* log_manager) {
 
     // 将事务日志刷入磁盘
     CommitLogRecord commit_log(txn->get_transaction_id());
-    log_manager->add_log_to_buffer(&commit_log);
-    log_manager->flush_log_to_disk();
+    lsn_t commit_lsn = log_manager->add_log_to_buffer(&commit_log);
+    if (async_commit_.load()) {
+        // 异步提交: 提交日志进入缓冲区即返回，由log writer按期限刷盘
+        log_manager->async_commit(commit_lsn + commit_log.log_tot_len_);
+    } else {
+        // 组提交: 与其他并发提交的事务共享一次日志刷盘
+        log_manager->group_commit(commit_lsn + commit_log.log_tot_len_);
+    }
 
     txn->set_state(TransactionState::COMMITTED);
-    att.erase(txn);
+    {
+        std::unique_lock<std::mutex> lock(latch_);
+        att.erase(txn);
+    }
     // {
     //     std::unique_lock<std::mutex> lock(latch_);
     //     txn_map.erase(txn->get_transaction_id());
@@ -100,78 +107,81 @@ void TransactionManager::abort(Transaction * txn, LogManager *log_manager) {
     // 3. 清空事务相关资源，eg.锁集
     // 4. 把事务日志刷入磁盘中
     // 5. 更新事务状态
-    RmManager* rm_mgr = sm_manager_->get_rm_manager();
-    
     //auto db_name = sm_manager_->db_.get_db_name();
     auto write_set = txn->get_write_set();
-
-    if (chdir(sm_manager_->db_.get_db_name().c_str()) < 0) {  // 进入数据库目录
-            throw UnixError();
-    }
+    // 回滚使用表和索引已经打开的句柄，与执行器看到的文件头(空闲页链表、B+树根节点)保持一致
+    Context context(lock_manager_, log_manager, txn, nullptr);
 
     // 1. 回滚所有写操作
+    // 补偿操作同样写日志并记为页面lsn，恢复时和其他修改一起按日志顺序重做，已经写了abort日志的事务不再需要undo。
+    // 否则回滚释放的空间被其他事务复用后，重做会把回滚前的记录重新写回来
     while (!write_set->empty()) {
         auto w_set = write_set->back();
         auto tb_name = w_set->GetTableName();
-        auto rm_file_hdr = rm_mgr->open_file(tb_name);
+        auto rm_file_hdr = sm_manager_->fhs_.at(tb_name).get();
+        auto &tab = sm_manager_->db_.get_table(tb_name);
+        Rid rid = w_set->GetRid();
         if (w_set->GetWriteType() == WType::INSERT_TUPLE) {
             // 删除插入的记录
-            rm_file_hdr->delete_record(w_set->GetRid(), nullptr);
-            for(auto index : sm_manager_->db_.get_table(tb_name).indexes){
-                auto idx_hdr = sm_manager_->get_ix_manager()->open_index(tb_name,index.cols);
-                char *key = new char[index.col_tot_len];  // 为索引键分配内存
+            DeleteLogRecord delete_log(txn->get_transaction_id(), w_set->GetRecord(), rid, tab.id);
+            txn->set_prev_lsn(log_manager->add_log_to_buffer(&delete_log));
+            rm_file_hdr->delete_record(rid, &context);
+            for(auto &index : tab.indexes){
+                auto idx_hdr = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tb_name, index.cols)).get();
+                std::vector<char> key(index.col_tot_len);  // 为索引键分配内存
                 int offset = 0;
                 // 构建索引键值
-                for (size_t j = 0; j < index.col_num; ++j) {
-                    memcpy(key + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
+                for (int j = 0; j < index.col_num; ++j) {
+                    memcpy(key.data() + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
                     offset += index.cols[j].len;
                 }
-                idx_hdr->delete_entry(key,txn);
+                idx_hdr->delete_entry(key.data(),txn);
             }
             
         } else if (w_set->GetWriteType() == WType::DELETE_TUPLE) {
             // 恢复删除的记录
-            rm_file_hdr->insert_record(w_set->GetRid(), w_set->GetRecord().data);
-            for(auto index : sm_manager_->db_.get_table(tb_name).indexes){
-                auto idx_hdr = sm_manager_->get_ix_manager()->open_index(tb_name,index.cols);
-                char *key = new char[index.col_tot_len];  // 为索引键分配内存
+            InsertLogRecord insert_log(txn->get_transaction_id(), w_set->GetRecord(), rid, tab.id);
+            txn->set_prev_lsn(log_manager->add_log_to_buffer(&insert_log));
+            rm_file_hdr->insert_record(rid, w_set->GetRecord().data, &context);
+            for(auto &index : tab.indexes){
+                auto idx_hdr = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tb_name, index.cols)).get();
+                std::vector<char> key(index.col_tot_len);  // 为索引键分配内存
                 int offset = 0;
                 // 构建索引键值
-                for (size_t j = 0; j < index.col_num; ++j) {
-                    memcpy(key + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
+                for (int j = 0; j < index.col_num; ++j) {
+                    memcpy(key.data() + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
                     offset += index.cols[j].len;
                 }
-                idx_hdr->insert_entry(key,w_set->GetRid(),txn);
+                idx_hdr->insert_entry(key.data(),rid,txn);
             }
         } else if (w_set->GetWriteType() == WType::UPDATE_TUPLE) {
-            // 恢复更新前的记录
-            rm_file_hdr->update_record(w_set->GetRid(), w_set->GetRecord().data, nullptr);
-            for(auto index : sm_manager_->db_.get_table(tb_name).indexes){
-                auto idx_hdr = sm_manager_->get_ix_manager()->open_index(tb_name,index.cols);
-                char *key = new char[index.col_tot_len];  // 为索引键分配内存
+            // 恢复更新前的记录。表上的X锁保证回滚时页面空间与更新前相同，原记录一定能写回原位置
+            UpdateLogRecord update_log(txn->get_transaction_id(), w_set->GetNewRecord(), w_set->GetRecord(), rid, tab.id);
+            txn->set_prev_lsn(log_manager->add_log_to_buffer(&update_log));
+            rm_file_hdr->update_record(rid, w_set->GetRecord().data, &context);
+            for(auto &index : tab.indexes){
+                auto idx_hdr = sm_manager_->ihs_.at(sm_manager_->get_ix_manager()->get_index_name(tb_name, index.cols)).get();
+                std::vector<char> key(index.col_tot_len);  // 为索引键分配内存
                 int offset = 0;
                 // 构建索引键值
-                for (size_t j = 0; j < index.col_num; ++j) {
-                    memcpy(key + offset, w_set->GetNewRecord().data + index.cols[j].offset, index.cols[j].len);
+                for (int j = 0; j < index.col_num; ++j) {
+                    memcpy(key.data() + offset, w_set->GetNewRecord().data + index.cols[j].offset, index.cols[j].len);
                     offset += index.cols[j].len;
                 }
-                idx_hdr->delete_entry(key,txn);
+                idx_hdr->delete_entry(key.data(),txn);
 
                 offset = 0;
-                for (size_t j = 0; j < index.col_num; ++j) {
-                    memcpy(key + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
+                for (int j = 0; j < index.col_num; ++j) {
+                    memcpy(key.data() + offset, w_set->GetRecord().data + index.cols[j].offset, index.cols[j].len);
                     offset += index.cols[j].len;
                 }
-                idx_hdr->insert_entry(key,w_set->GetRid(),txn);
+                idx_hdr->insert_entry(key.data(),rid,txn);
             }
         } else {
             throw InternalError("bad wtype");
         }
         write_set->pop_back();
     }
-    if (chdir("..") < 0) {
-        throw UnixError();
-    }
 
     // 2. 释放所有锁
     auto lock_set = txn->get_lock_set();
@@ -187,7 +197,10 @@ void TransactionManager::abort(Transaction * txn, LogManager *log_manager) {
     log_manager->flush_log_to_disk();
     // 5. 更新事务状态
     txn->set_state(TransactionState::ABORTED);
-    att.erase(txn);
+    {
+        std::unique_lock<std::mutex> lock(latch_);
+        att.erase(txn);
+    }
     // 从全局事务表中移除该事务
     // {
     //     std::unique_lock<std::mutex> lock(latch_);
@@ -71,17 +71,23 @@ public:
         return is_checkpoiting_.load();
     }
 
+    // SET enable_async_commit: 提交时不等待日志落盘
+    void set_async_commit(bool b) { async_commit_.store(b); }
+
+    bool get_async_commit() { return async_commit_.load(); }
+
     static std::unordered_map<txn_id_t, Transaction *> txn_map;     // 全局事务表，存放事务ID与事务对象的映射关系
     static std::unordered_set<Transaction*> att; //全局活跃事务表
 private:
     ConcurrencyMode concurrency_mode_;      // 事务使用的并发控制算法，目前只需要考虑2PL
     std::atomic<txn_id_t> next_txn_id_{0};  // 用于分发事务ID
     std::atomic<timestamp_t> next_timestamp_{0};    // 用于分发事务时间戳
-    std::mutex latch_;  // 用于txn_map的并发
+    std::mutex latch_;  // 用于txn_map和att的并发
     SmManager *sm_manager_;
     LockManager *lock_manager_;
 
     std::condition_variable cv_;
     //标志位，为true时表示正在create static_checkpoint
     std::atomic<bool>is_checkpoiting_{false};
+    std::atomic<bool>async_commit_{false};  // 为true时提交不等待日志刷盘，由log writer在ASYNC_COMMIT_MAX_DELAY内刷盘
 };
\ No newline at end of file
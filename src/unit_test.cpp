@@ -13,16 +13,20 @@ See the Mulan PSL v2 for more details. */
 #define private public
 
 #include "record/rm.h"
+#include "recovery/log_manager.h"
+#include "recovery/log_recovery.h"
 #include "storage/buffer_pool_manager.h"
 
 #undef private
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <random>
@@ -32,9 +36,17 @@ See the Mulan PSL v2 for more details. */
 #include <unordered_map>
 #include <vector>
 
+#include "execution/executor_delete.h"
+#include "execution/executor_insert.h"
+#include "execution/executor_update.h"
 #include "gtest/gtest.h"
+#include "replacer/clock_replacer.h"
+#include "replacer/lru_k_replacer.h"
 #include "replacer/lru_replacer.h"
+#include "replacer/two_queue_replacer.h"
 #include "storage/disk_manager.h"
+#include "storage/page_io.h"
+#include "transaction/transaction_manager.h"
 
 const std::string TEST_DB_NAME = "BufferPoolManagerTest_db";  // 以数据库名作为根目录
 const std::string TEST_FILE_NAME = "basic";                   // 测试文件的名字
@@ -132,6 +144,10 @@ void check_equal(const RmFileHandle *file_handle,
         assert(mock.count(scan.rid()) > 0);
         auto rec = file_handle->get_record(scan.rid(), nullptr);
         assert(memcmp(rec->data, mock.at(scan.rid()).c_str(), file_handle->file_hdr_.record_size) == 0);
+        // 零拷贝视图与get_record读到的内容一致
+        RmRecordView view = scan.record();
+        assert(view.size == file_handle->file_hdr_.record_size);
+        assert(memcmp(view.data, rec->data, view.size) == 0);
         num_records++;
     }
     assert(num_records == mock.size());
@@ -231,6 +247,71 @@ TEST(LRUReplacerTest, SampleTest) {
     EXPECT_EQ(4, value);
 }
 
+TEST(ClockReplacerTest, SampleTest) {
+    ClockReplacer clock_replacer(7);
+
+    // Scenario: unpin six elements, i.e. add them to the replacer.
+    for (int i = 1; i <= 6; i++) {
+        clock_replacer.unpin(i);
+    }
+    clock_replacer.unpin(1);
+    EXPECT_EQ(6, clock_replacer.Size());
+
+    // Scenario: all reference bits are set, the first sweep clears them and 1 is victimized.
+    int value;
+    clock_replacer.victim(&value);
+    EXPECT_EQ(1, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(2, value);
+
+    // Scenario: pin 3 and 4, then unpin 4 which gets a second chance.
+    clock_replacer.pin(3);
+    clock_replacer.pin(4);
+    EXPECT_EQ(2, clock_replacer.Size());
+    clock_replacer.unpin(4);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(5, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(6, value);
+    clock_replacer.victim(&value);
+    EXPECT_EQ(4, value);
+    EXPECT_FALSE(clock_replacer.victim(&value));
+}
+
+// 顺序扫描只访问一次的页面应当先于被反复访问的热点页面被淘汰
+TEST(ScanResistantReplacerTest, SampleTest) {
+    std::vector<std::unique_ptr<Replacer>> replacers;
+    replacers.push_back(std::make_unique<LRUKReplacer>(8));
+    replacers.push_back(std::make_unique<TwoQueueReplacer>(8));
+    for (auto &replacer : replacers) {
+        // frame 0 and 1 are hot pages, referenced again after a while
+        replacer->pin(0);
+        replacer->pin(1);
+        for (uint64_t i = 0; i < REPLACER_CORRELATED_PERIOD + 1; i++) {
+            replacer->pin(7);
+            replacer->unpin(7);
+        }
+        replacer->pin(0);
+        replacer->pin(1);
+        replacer->unpin(0);
+        replacer->unpin(1);
+        replacer->remove(7);
+        // frame 2..5 are touched once by a scan
+        for (int f = 2; f < 6; f++) {
+            replacer->pin(f);
+            replacer->unpin(f);
+        }
+        EXPECT_EQ(6, replacer->Size());
+        int value;
+        for (int i = 0; i < 2; i++) {
+            ASSERT_TRUE(replacer->victim(&value));
+            EXPECT_GE(value, 2);
+            EXPECT_LT(value, 6);
+        }
+        EXPECT_EQ(4, replacer->Size());
+    }
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME，记录其文件描述符fd */
@@ -328,6 +409,550 @@ TEST_F(BufferPoolManagerTest, SampleTest) {
     bpm->flush_all_pages(fd);
 }
 
+// 使用访问策略的顺序扫描只复用环上的帧，不会淘汰缓冲池中的其他页面
+TEST_F(BufferPoolManagerTest, AccessStrategyTest) {
+    const size_t buffer_pool_size = 10;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+
+    // Scenario: write 20 pages to disk, the first 4 of them stay in the pool as hot pages.
+    PageId page_id_temp = {fd, INVALID_PAGE_ID};
+    for (int i = 0; i < 20; i++) {
+        Page *page = bpm->new_page(&page_id_temp);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->get_data() + Page::OFFSET_PAGE_HDR, PAGE_SIZE - Page::OFFSET_PAGE_HDR, "page %d", i);
+        EXPECT_EQ(true, bpm->unpin_page(page_id_temp, true));
+    }
+    bpm->flush_all_pages(fd);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, i}));
+        EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+    }
+
+    // Scenario: scan the other 16 pages through a ring of 2 frames.
+    BufferAccessStrategy strategy(1, 2);
+    for (int i = 4; i < 20; i++) {
+        Page *page = bpm->fetch_page(PageId{fd, i}, &strategy);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(0, strcmp(page->get_data() + Page::OFFSET_PAGE_HDR, ("page " + std::to_string(i)).c_str()));
+        EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+    }
+    // the hot pages are still cached
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(1, bpm->partitions_[0]->page_table_.count(PageId{fd, i}));
+    }
+}
+
+// 无锁命中只设置访问位，淘汰时通过touch补记为一次访问且不丢失访问历史，因此不使用访问策略的扫描也不会淘汰热点页面
+TEST_F(BufferPoolManagerTest, ScanResistanceTest) {
+    const size_t buffer_pool_size = 40;
+    const int num_pages = 200;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    {
+        auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+        PageId page_id_temp = {fd, INVALID_PAGE_ID};
+        for (int i = 0; i < num_pages; i++) {
+            ASSERT_NE(nullptr, bpm->new_page(&page_id_temp));
+            EXPECT_EQ(true, bpm->unpin_page(page_id_temp, true));
+        }
+        bpm->flush_all_pages(fd);
+    }
+    for (const std::string replacer_type : {"LRU-K", "2Q"}) {
+        auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager, replacer_type);
+        auto access = [&](int page_no) {
+            ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, page_no}));
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, page_no}, false));
+        };
+
+        // Scenario: pages 0 and 1 are loaded, and referenced again through the lock-free path after other loads.
+        access(0);
+        access(1);
+        for (int i = 2; i < static_cast<int>(buffer_pool_size); i++) {
+            access(i);
+        }
+        access(0);
+        access(1);
+
+        // Scenario: a scan without an access strategy reads every other page once.
+        for (int i = static_cast<int>(buffer_pool_size); i < num_pages; i++) {
+            access(i);
+        }
+        EXPECT_EQ(1, bpm->partitions_[0]->page_table_.count(PageId{fd, 0})) << replacer_type;
+        EXPECT_EQ(1, bpm->partitions_[0]->page_table_.count(PageId{fd, 1})) << replacer_type;
+    }
+}
+
+// 脏页表记录页面第一次被弄脏时的recLSN，增量刷脏只写回recLSN早于检查点的页面
+TEST_F(BufferPoolManagerTest, DirtyPageTableTest) {
+    const size_t buffer_pool_size = 10;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    lsn_t cur_lsn = 100;
+    bpm->set_rec_lsn_provider([&cur_lsn] { return cur_lsn; });
+
+    // Scenario: pages 0-3 are dirtied at lsn 100, pages 4-5 at lsn 200, page 0 again at lsn 300.
+    PageId page_id_temp = {fd, INVALID_PAGE_ID};
+    for (int i = 0; i < 6; i++) {
+        cur_lsn = i < 4 ? 100 : 200;
+        ASSERT_NE(nullptr, bpm->new_page(&page_id_temp));
+        EXPECT_EQ(true, bpm->unpin_page(page_id_temp, true));
+    }
+    cur_lsn = 300;
+    ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, 0}));
+    EXPECT_EQ(true, bpm->unpin_page(PageId{fd, 0}, true));
+
+    auto dirty_page_table = bpm->get_dirty_page_table();
+    ASSERT_EQ(6, dirty_page_table.size());
+    for (auto &entry : dirty_page_table) {
+        EXPECT_EQ(entry.first.page_no < 4 ? 100 : 200, entry.second);
+    }
+
+    // Scenario: a pinned page may be modified concurrently, so it is skipped and stays in the dirty page table.
+    ASSERT_NE(nullptr, bpm->fetch_page(PageId{fd, 1}));
+    EXPECT_EQ(3, bpm->flush_dirty_pages(150));
+    dirty_page_table = bpm->get_dirty_page_table();
+    ASSERT_EQ(3, dirty_page_table.size());
+    EXPECT_EQ(true, bpm->unpin_page(PageId{fd, 1}, false));
+
+    // Scenario: flushing pages older than lsn 150 leaves pages 4-5 in the dirty page table.
+    EXPECT_EQ(1, bpm->flush_dirty_pages(150));
+    dirty_page_table = bpm->get_dirty_page_table();
+    ASSERT_EQ(2, dirty_page_table.size());
+    for (auto &entry : dirty_page_table) {
+        EXPECT_LE(4, entry.first.page_no);
+    }
+    bpm->flush_all_pages();
+    EXPECT_EQ(0, bpm->get_dirty_page_table().size());
+}
+
+// 脏页写回磁盘之前(淘汰、flush_page、flush_all_pages、增量刷脏)，修改页面的日志必须先落盘
+TEST_F(BufferPoolManagerTest, WalBeforeDataTest) {
+    const size_t buffer_pool_size = 4;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    std::vector<lsn_t> flushed;
+    bpm->set_rec_lsn_provider([] { return 0; });
+    bpm->set_log_flusher([&flushed](lsn_t lsn) { flushed.push_back(lsn); });
+
+    // Scenario: every page is dirtied with page lsn 100 * (page_no + 1).
+    PageId page_id_temp = {fd, INVALID_PAGE_ID};
+    for (int i = 0; i < 4; i++) {
+        Page *page = bpm->new_page(&page_id_temp);
+        ASSERT_NE(nullptr, page);
+        page->set_page_lsn(100 * (i + 1));
+        EXPECT_EQ(true, bpm->unpin_page(page_id_temp, true));
+    }
+    EXPECT_TRUE(flushed.empty());
+
+    // Scenario: flush_page flushes the log up to the page lsn.
+    EXPECT_EQ(true, bpm->flush_page(PageId{fd, 1}));
+    ASSERT_EQ(1, flushed.size());
+    EXPECT_EQ(200, flushed.back());
+
+    // Scenario: a batch flush flushes the log up to the largest page lsn in the batch.
+    EXPECT_EQ(3, bpm->flush_dirty_pages(1000));
+    ASSERT_EQ(2, flushed.size());
+    EXPECT_EQ(400, flushed.back());
+
+    // Scenario: evicting a dirty page flushes the log first, clean pages are evicted without it.
+    Page *page = bpm->fetch_page(PageId{fd, 0});
+    ASSERT_NE(nullptr, page);
+    page->set_page_lsn(500);
+    EXPECT_EQ(true, bpm->unpin_page(PageId{fd, 0}, true));
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NE(nullptr, bpm->new_page(&page_id_temp));
+        EXPECT_EQ(true, bpm->unpin_page(page_id_temp, false));
+    }
+    ASSERT_EQ(3, flushed.size());
+    EXPECT_EQ(500, flushed.back());
+}
+
+// 被pin住的脏页可能正在被修改，flush_all_pages等待unpin之后再写回，写回的是完整的页面且修改不会丢失脏标记
+TEST_F(BufferPoolManagerTest, FlushPinnedPageTest) {
+    const size_t buffer_pool_size = 10;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    int fd = BufferPoolManagerTest::fd_;
+    auto disk_data = [&](int page_no) {
+        std::vector<char> buf(PAGE_SIZE);
+        disk_manager->read_page(fd, page_no, buf.data(), PAGE_SIZE);
+        return std::string(buf.data() + Page::OFFSET_PAGE_HDR);
+    };
+
+    // Scenario: page 0 is dirty and pinned by a writer that finishes its change later.
+    PageId page_id = {fd, INVALID_PAGE_ID};
+    Page *page = bpm->new_page(&page_id);
+    ASSERT_NE(nullptr, page);
+    strcpy(page->get_data() + Page::OFFSET_PAGE_HDR, "v1");
+    EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    ASSERT_EQ(page, bpm->fetch_page(page_id));
+    strcpy(page->get_data() + Page::OFFSET_PAGE_HDR, "v2");
+    std::thread writer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        strcpy(page->get_data() + Page::OFFSET_PAGE_HDR, "v3");
+        EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+    });
+    bpm->flush_all_pages(fd);
+    writer.join();
+    EXPECT_FALSE(page->is_dirty());
+    EXPECT_EQ("v3", disk_data(page_id.page_no));
+
+    // Scenario: a pinned clean page is skipped instead of waited for.
+    ASSERT_EQ(page, bpm->fetch_page(page_id));
+    EXPECT_EQ(true, bpm->flush_page(page_id));
+    EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+}
+
+// 淘汰的脏页进入写回队列，由后台线程批量写回；落盘之前读取页面得到的是队列中的最新版本，同步写入会丢弃队列中的旧版本
+TEST_F(BufferPoolManagerTest, PageWriterTest) {
+    const int num_pages = 8;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    PageWriter *writer = disk_manager->page_writer_.get();
+    ASSERT_NE(nullptr, writer);
+    auto page_data = [](int page_no, int version) {
+        std::vector<char> buf(PAGE_SIZE, 0);
+        snprintf(buf.data(), PAGE_SIZE, "page %d v%d", page_no, version);
+        return buf;
+    };
+    // 绕过写回队列直接读取磁盘上的内容
+    auto disk_data = [&](int page_no) {
+        std::vector<char> buf(PAGE_SIZE, 0);
+        EXPECT_EQ(PAGE_SIZE, pread(fd, buf.data(), PAGE_SIZE, static_cast<off_t>(page_no) * PAGE_SIZE));
+        return std::string(buf.data());
+    };
+    for (int i = 0; i < num_pages; i++) {
+        disk_manager->write_page(fd, i, page_data(i, 0).data(), PAGE_SIZE);
+    }
+
+    // Scenario: while the writer is busy, every page is evicted twice; the queue keeps only the latest copy and reads are served from it.
+    {
+        std::lock_guard<std::mutex> io_guard(writer->shard_of(fd).io_latch_);
+        for (int version = 1; version <= 2; version++) {
+            for (int i = 0; i < num_pages; i++) {
+                disk_manager->write_page_async(fd, i, page_data(i, version).data());
+            }
+        }
+        EXPECT_EQ(num_pages, writer->pending_count());
+        char buf[PAGE_SIZE];
+        for (int i = 0; i < num_pages; i++) {
+            disk_manager->read_page(fd, i, buf, PAGE_SIZE);
+            EXPECT_STREQ(page_data(i, 2).data(), buf);
+            EXPECT_EQ(page_data(i, 0).data(), disk_data(i));
+        }
+        std::vector<std::vector<char>> bufs(num_pages, std::vector<char>(PAGE_SIZE));
+        std::vector<char *> ptrs;
+        for (auto &b : bufs) {
+            ptrs.push_back(b.data());
+        }
+        disk_manager->read_pages(fd, 0, ptrs.data(), num_pages);
+        for (int i = 0; i < num_pages; i++) {
+            EXPECT_STREQ(page_data(i, 2).data(), ptrs[i]);
+        }
+    }
+
+    // Scenario: the background thread writes the queued batch back without being asked.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (writer->pending_count() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(PAGE_WRITER_INTERVAL);
+    }
+    EXPECT_EQ(0, writer->pending_count());
+    for (int i = 0; i < num_pages; i++) {
+        EXPECT_EQ(page_data(i, 2).data(), disk_data(i));
+    }
+
+    // Scenario: a synchronous write replaces a queued older copy, which is never written afterwards.
+    disk_manager->write_page_async(fd, 0, page_data(0, 3).data());
+    disk_manager->write_page(fd, 0, page_data(0, 4).data(), PAGE_SIZE);
+    disk_manager->flush_async_pages();
+    EXPECT_EQ(0, writer->pending_count());
+    EXPECT_EQ(page_data(0, 4).data(), disk_data(0));
+}
+
+// 缓冲池按PageId分区，页面只登记在所属分区的页表和帧中；缺页只持有所属分区的latch_，
+// 一个分区被占用时其他分区的缺页照常完成，并发缺页同一页面只占用一个帧
+TEST_F(BufferPoolManagerTest, PartitionTest) {
+    const size_t buffer_pool_size = 4 * BUFFER_POOL_PARTITION_MIN_FRAMES;
+    const int num_pages = 256;
+    const int num_threads = 8;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    for (int i = 0; i < num_pages; i++) {
+        char buf[PAGE_SIZE] = {};
+        snprintf(buf + Page::OFFSET_PAGE_HDR, PAGE_SIZE - Page::OFFSET_PAGE_HDR, "page %d", i);
+        disk_manager->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    disk_manager->set_fd2pageno(fd, num_pages);
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    ASSERT_EQ(4, bpm->partitions_.size());
+
+    // Scenario: threads miss on overlapping pages concurrently, and each page is read into one frame of its own partition.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < num_pages; i++) {
+                PageId page_id{fd, (i + t * 17) % num_pages};
+                Page *page = bpm->fetch_page(page_id);
+                ASSERT_NE(nullptr, page);
+                EXPECT_EQ(0, strcmp(page->get_data() + Page::OFFSET_PAGE_HDR,
+                                    ("page " + std::to_string(page_id.page_no)).c_str()));
+                EXPECT_EQ(true, bpm->unpin_page(page_id, false));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    size_t cached = 0;
+    std::set<frame_id_t> frames;
+    for (auto &part : bpm->partitions_) {
+        for (auto &entry : part->page_table_) {
+            EXPECT_EQ(part.get(), &bpm->partition_of(entry.first));
+            EXPECT_LE(part->base_, entry.second);
+            EXPECT_LT(entry.second, part->base_ + static_cast<frame_id_t>(part->size_));
+            frames.insert(entry.second);
+        }
+        cached += part->page_table_.size();
+    }
+    EXPECT_EQ(num_pages, cached);
+    EXPECT_EQ(num_pages, frames.size());
+
+    // Scenario: a miss completes while another partition's latch is held.
+    bpm->delete_all_page(fd);
+    PageId busy{fd, 0};
+    PageId other{fd, 1};
+    while (&bpm->partition_of(other) == &bpm->partition_of(busy)) {
+        other.page_no++;
+    }
+    std::unique_lock<std::mutex> busy_lock(bpm->partition_of(busy).latch_);
+    auto miss = std::async(std::launch::async, [&] {
+        Page *page = bpm->fetch_page(other);
+        return page != nullptr && bpm->unpin_page(other, false);
+    });
+    auto status = miss.wait_for(std::chrono::seconds(5));
+    busy_lock.unlock();
+    EXPECT_EQ(std::future_status::ready, status);
+    EXPECT_TRUE(miss.get());
+}
+
+// 预读线程把页面读入缓冲池后立即unpin，之后的访问通过无锁路径直接命中；已经在缓冲池中的页面不再进入预读队列
+TEST_F(BufferPoolManagerTest, PrefetchTest) {
+    const size_t buffer_pool_size = 16;
+    const int num_pages = 8;
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    for (int i = 0; i < num_pages; i++) {
+        char buf[PAGE_SIZE] = {};
+        snprintf(buf + Page::OFFSET_PAGE_HDR, PAGE_SIZE - Page::OFFSET_PAGE_HDR, "page %d", i);
+        disk_manager->write_page(fd, i, buf, PAGE_SIZE);
+    }
+    auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+    // 页面已经登记在页表中且读入完成时返回其所在的帧
+    auto cached_page = [&](int page_no) -> Page * {
+        auto &part = bpm->partition_of(PageId{fd, page_no});
+        std::lock_guard<std::mutex> guard(part.latch_);
+        auto it = part.page_table_.find(PageId{fd, page_no});
+        if (it == part.page_table_.end() || bpm->pages_[it->second].io_in_progress_) {
+            return nullptr;
+        }
+        return &bpm->pages_[it->second];
+    };
+
+    // Scenario: prefetched pages are read in the background and left unpinned.
+    for (int i = 0; i < num_pages; i++) {
+        bpm->prefetch(PageId{fd, i});
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (int i = 0; i < num_pages; i++) {
+        while (cached_page(i) == nullptr && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        Page *page = cached_page(i);
+        ASSERT_NE(nullptr, page) << "page " << i;
+        EXPECT_EQ(0, page->pin_count_.load());
+    }
+
+    // Scenario: fetching the prefetched pages hits through the lock-free path and sees the data read from disk.
+    for (int i = 0; i < num_pages; i++) {
+        Page *page = bpm->try_fast_pin(PageId{fd, i});
+        ASSERT_NE(nullptr, page) << "page " << i;
+        EXPECT_EQ(0, strcmp(page->get_data() + Page::OFFSET_PAGE_HDR, ("page " + std::to_string(i)).c_str()));
+        EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+    }
+
+    // Scenario: a page already in the pool is not queued again.
+    bpm->prefetch(PageId{fd, 0});
+    std::lock_guard<std::mutex> guard(bpm->prefetch_latch_);
+    EXPECT_TRUE(bpm->prefetch_queue_.empty());
+}
+
+// write_pages把页号连续的页面合并为一次pwritev写入，read_pages一次读取连续的页面，超过IOV_MAX的页面分多次完成
+TEST_F(BufferPoolManagerTest, VectoredIoTest) {
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    auto fill = [](std::vector<char> &buf, int page_no, int version) {
+        std::fill(buf.begin(), buf.end(), 0);
+        snprintf(buf.data(), PAGE_SIZE, "page %d v%d", page_no, version);
+    };
+
+    // Scenario: unsorted pages with gaps are written in one call; the gaps read back as zeros.
+    std::vector<int> page_nos = {5, 0, 1, 2, 9, 6};
+    std::vector<std::vector<char>> data(page_nos.size(), std::vector<char>(PAGE_SIZE));
+    std::vector<std::pair<page_id_t, const char *>> pages;
+    for (size_t i = 0; i < page_nos.size(); i++) {
+        fill(data[i], page_nos[i], 1);
+        pages.emplace_back(page_nos[i], data[i].data());
+    }
+    // 写回队列中的旧版本不能在之后覆盖write_pages写入的页面
+    std::vector<char> old_buf(PAGE_SIZE);
+    fill(old_buf, 5, 0);
+    disk_manager->write_page_async(fd, 5, old_buf.data());
+    disk_manager->write_pages(fd, pages);
+    disk_manager->flush_async_pages();
+
+    const int num_pages = 10;
+    std::vector<std::vector<char>> bufs(num_pages, std::vector<char>(PAGE_SIZE, 'x'));
+    std::vector<char *> ptrs;
+    for (auto &buf : bufs) {
+        ptrs.push_back(buf.data());
+    }
+    disk_manager->read_pages(fd, 0, ptrs.data(), num_pages);
+    std::vector<char> expected(PAGE_SIZE);
+    for (int i = 0; i < num_pages; i++) {
+        if (std::find(page_nos.begin(), page_nos.end(), i) != page_nos.end()) {
+            fill(expected, i, 1);
+        } else {
+            std::fill(expected.begin(), expected.end(), 0);
+        }
+        EXPECT_EQ(expected, bufs[i]) << "page " << i;
+    }
+
+    // Scenario: a run longer than IOV_MAX pages round-trips through several vectored calls.
+    const int num_big = IOV_MAX + 100;
+    std::vector<std::vector<char>> big(num_big, std::vector<char>(PAGE_SIZE));
+    pages.clear();
+    ptrs.clear();
+    for (int i = 0; i < num_big; i++) {
+        fill(big[i], i, 2);
+        pages.emplace_back(i, big[i].data());
+    }
+    disk_manager->write_pages(fd, pages);
+    std::vector<std::vector<char>> big_read(num_big, std::vector<char>(PAGE_SIZE));
+    for (auto &buf : big_read) {
+        ptrs.push_back(buf.data());
+    }
+    disk_manager->read_pages(fd, 0, ptrs.data(), num_big);
+    for (int i = 0; i < num_big; i++) {
+        EXPECT_EQ(big[i], big_read[i]) << "page " << i;
+    }
+
+    // Scenario: reading past the end of the file fails instead of returning partial pages.
+    EXPECT_THROW(disk_manager->read_pages(fd, num_big - 1, ptrs.data(), 2), InternalError);
+}
+
+// 开启direct io时数据文件以O_DIRECT打开，缓冲池的帧和写回队列的页面都按DIRECT_IO_ALIGNMENT对齐；
+// 文件头等非对齐、不足整页的读写通过对齐的临时内存完成，不破坏页面的其余部分
+TEST_F(BufferPoolManagerTest, DirectIoTest) {
+    const size_t buffer_pool_size = 10;
+    const std::string filename = "direct";
+    auto disk_manager = std::make_unique<DiskManager>();
+    disk_manager->direct_io_ = true;
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    disk_manager->create_file(filename);
+    int fd = disk_manager->open_file(filename, true);
+    ASSERT_TRUE(disk_manager->direct_fd_[fd]) << "the file system does not support O_DIRECT";
+    EXPECT_NE(0, fcntl(fd, F_GETFL) & O_DIRECT);
+
+    // Scenario: pages go through aligned buffer pool frames and reach the O_DIRECT file.
+    {
+        auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager.get());
+        for (size_t i = 0; i < buffer_pool_size; i++) {
+            EXPECT_TRUE(is_io_aligned(bpm->pages_[i].get_data()));
+        }
+        PageId page_id = {fd, INVALID_PAGE_ID};
+        for (int i = 0; i < 2 * static_cast<int>(buffer_pool_size); i++) {
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            snprintf(page->get_data() + Page::OFFSET_PAGE_HDR, PAGE_SIZE - Page::OFFSET_PAGE_HDR, "page %d", i);
+            EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        }
+        bpm->flush_all_pages(fd);
+        disk_manager->flush_async_pages();
+        for (int i = 0; i < 2 * static_cast<int>(buffer_pool_size); i++) {
+            Page *page = bpm->fetch_page(PageId{fd, i});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ(0, strcmp(page->get_data() + Page::OFFSET_PAGE_HDR, ("page " + std::to_string(i)).c_str()));
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+        }
+    }
+
+    // Scenario: an unaligned write shorter than a page only replaces its own bytes.
+    std::vector<char> page(PAGE_SIZE, 'a');
+    disk_manager->write_page(fd, 0, page.data(), PAGE_SIZE);
+    std::vector<char> hdr(PAGE_SIZE + 1, 'b');
+    const int hdr_size = 100;
+    disk_manager->write_page(fd, 0, hdr.data() + 1, hdr_size);
+    std::vector<char> read_buf(PAGE_SIZE + 1);
+    disk_manager->read_page(fd, 0, read_buf.data() + 1, PAGE_SIZE);
+    std::fill(page.begin(), page.begin() + hdr_size, 'b');
+    EXPECT_EQ(0, memcmp(page.data(), read_buf.data() + 1, PAGE_SIZE));
+
+    // Scenario: an unaligned read shorter than a page returns just those bytes.
+    std::fill(read_buf.begin(), read_buf.end(), 0);
+    disk_manager->read_page(fd, 0, read_buf.data() + 1, hdr_size);
+    EXPECT_EQ(0, memcmp(hdr.data() + 1, read_buf.data() + 1, hdr_size));
+    EXPECT_EQ(0, read_buf[hdr_size + 1]);
+
+    disk_manager->close_file(fd);
+    disk_manager->destroy_file(filename);
+}
+
+// 帧的页面数据来自一块连续的mmap内存，第i个帧的数据位于frames_ + i * PAGE_SIZE；
+// 帧描述符只保存元数据，每个描述符占一个缓存行，扫描描述符时不会访问页面数据
+TEST_F(BufferPoolManagerTest, FrameArenaTest) {
+    auto disk_manager = BufferPoolManagerTest::disk_manager_.get();
+    int fd = BufferPoolManagerTest::fd_;
+    EXPECT_EQ(64, alignof(Page));
+    EXPECT_EQ(64, sizeof(Page));
+
+    // Scenario: a small pool and a pool larger than a huge page both get one contiguous, zeroed, page aligned arena.
+    const size_t sys_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t buffer_pool_size : {size_t{10}, 2 * HUGE_PAGE_SIZE / PAGE_SIZE + 3}) {
+        auto bpm = std::make_unique<BufferPoolManager>(buffer_pool_size, disk_manager);
+        ASSERT_NE(nullptr, bpm->frames_);
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(bpm->frames_) % sys_page_size);
+        EXPECT_LE(buffer_pool_size * PAGE_SIZE, bpm->frames_size_);
+        for (size_t i = 0; i < buffer_pool_size; i++) {
+            ASSERT_EQ(bpm->frames_ + i * PAGE_SIZE, bpm->pages_[i].get_data()) << "frame " << i;
+        }
+        EXPECT_TRUE(std::all_of(bpm->frames_, bpm->frames_ + buffer_pool_size * PAGE_SIZE, [](char c) { return c == 0; }));
+
+        // Scenario: every frame of the arena can hold a page that survives eviction.
+        PageId page_id = {fd, INVALID_PAGE_ID};
+        disk_manager->set_fd2pageno(fd, 0);
+        const int num_pages = static_cast<int>(buffer_pool_size) + 1;
+        for (int i = 0; i < num_pages; i++) {
+            Page *page = bpm->new_page(&page_id);
+            ASSERT_NE(nullptr, page);
+            memset(page->get_data(), 'a' + i % 26, PAGE_SIZE);
+            EXPECT_EQ(true, bpm->unpin_page(page_id, true));
+        }
+        for (int i = 0; i < num_pages; i++) {
+            Page *page = bpm->fetch_page(PageId{fd, i});
+            ASSERT_NE(nullptr, page);
+            EXPECT_EQ('a' + i % 26, page->get_data()[PAGE_SIZE - 1]) << "page " << i;
+            EXPECT_EQ(true, bpm->unpin_page(PageId{fd, i}, false));
+        }
+        bpm->flush_all_pages(fd);
+    }
+}
+
 /** 注意：每个测试点只测试了单个文件！
  * 对于每个测试点，先创建和进入目录TEST_DB_NAME
  * 然后在此目录下创建和打开文件TEST_FILE_NAME_CCUR，记录其文件描述符fd */
@@ -592,7 +1217,7 @@ TEST(RecordManagerTest, SimpleTest) {
         std::unique_ptr<RmFileHandle> file_handle = rm_manager->open_file(filename);
         // 检查filename文件在内存中的file header的参数
         assert(file_handle->file_hdr_.record_size == record_size);
-        assert(file_handle->file_hdr_.first_free_page_no == RM_NO_PAGE);
+        assert(file_handle->fsm_->claim() == RM_NO_PAGE);
         assert(file_handle->file_hdr_.num_pages == 1);
 
         int max_bytes = file_handle->file_hdr_.record_size * file_handle->file_hdr_.num_records_per_page +
@@ -661,3 +1286,986 @@ TEST(RecordManagerTest, SimpleTest) {
     rm_manager->close_file(file_handle.get());
     rm_manager->destroy_file(filename);
 }
+
+TEST(RecordManagerTest, SlottedPageTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::unordered_map<Rid, std::string, rid_hash_t, rid_equal_t> mock;
+
+    std::string filename = "slotted.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    // 记录格式：int + VARCHAR(100) + VARCHAR(40) + int
+    std::vector<RmVarCol> var_cols = {{4, 100}, {104, 40}};
+    int record_size = 148;
+    rm_manager->create_file(filename, record_size, var_cols);
+    auto file_handle = rm_manager->open_file(filename);
+    assert(file_handle->file_hdr_.is_slotted());
+    // 变长记录按实际长度存储，每页能放下的记录数多于定长格式
+    assert(file_handle->file_hdr_.num_records_per_page > PAGE_SIZE / record_size);
+
+    // 变长字段的实际长度随机，剩余部分补0
+    auto rand_rec = [&](char *buf) {
+        memset(buf, 0, record_size);
+        rand_buf(4, buf);
+        rand_buf(4, buf + 144);
+        for (auto &col : var_cols) {
+            int len = rand() % (col.len + 1);
+            for (int i = 0; i < len; i++) {
+                buf[col.offset + i] = 'a' + rand() % 26;
+            }
+        }
+    };
+
+    char write_buf[PAGE_SIZE];
+    for (int round = 0; round < 2000; round++) {
+        double insert_prob = 1. - mock.size() / 300.;
+        double dice = rand() * 1. / RAND_MAX;
+        if (mock.empty() || dice < insert_prob) {
+            rand_rec(write_buf);
+            Rid rid = file_handle->insert_record(write_buf, nullptr);
+            assert(mock.count(rid) == 0);
+            mock[rid] = std::string(write_buf, record_size);
+        } else {
+            auto it = mock.begin();
+            std::advance(it, rand() % mock.size());
+            auto rid = it->first;
+            int op = rand() % 3;
+            if (op == 0) {
+                // 更新：原页面放不下时删除后重新插入
+                rand_rec(write_buf);
+                if (file_handle->can_update_in_place(rid, write_buf)) {
+                    file_handle->update_record(rid, write_buf, nullptr);
+                } else {
+                    file_handle->delete_record(rid, nullptr);
+                    mock.erase(rid);
+                    rid = file_handle->insert_record(write_buf, nullptr);
+                }
+                mock[rid] = std::string(write_buf, record_size);
+            } else if (op == 1) {
+                file_handle->delete_record(rid, nullptr);
+                mock.erase(rid);
+            } else {
+                // 删除后在原位置插回(回滚删除)
+                std::string rec = mock[rid];
+                file_handle->delete_record(rid, nullptr);
+                file_handle->insert_record(rid, rec.data());
+            }
+        }
+        if (round % 100 == 0) {
+            rm_manager->close_file(file_handle.get());
+            file_handle = rm_manager->open_file(filename);
+        }
+        check_equal(file_handle.get(), mock);
+    }
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+// 文件头中的格式版本与当前版本不一致时拒绝打开，不会按错误的布局解释旧文件
+TEST(RecordManagerTest, FileVersionTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "file_version.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, 16);
+    auto file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->file_hdr_.version, RM_FILE_VERSION);
+    rm_manager->close_file(file_handle.get());
+
+    // Scenario: a header written by an older format is rejected and the file is closed again.
+    int fd = disk_manager->open_file(filename);
+    RmFileHdr file_hdr;
+    disk_manager->read_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr, sizeof(file_hdr));
+    file_hdr.version = RM_FILE_VERSION - 1;
+    disk_manager->write_page(fd, RM_FILE_HDR_PAGE, (char *)&file_hdr, sizeof(file_hdr));
+    disk_manager->close_file(fd);
+    EXPECT_THROW(rm_manager->open_file(filename), InternalError);
+
+    // destroy_file拒绝删除仍然打开的文件
+    EXPECT_NO_THROW(rm_manager->destroy_file(filename));
+}
+
+// RmScan进入一个页面时为之后的RM_SCAN_PREFETCH_PAGES个页面发出预读，扫描到这些页面之前它们已经被读入缓冲池
+TEST(RecordManagerTest, ScanPrefetchTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "scan_prefetch.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    rm_manager->create_file(filename, RM_MAX_RECORD_SIZE);
+    auto file_handle = rm_manager->open_file(filename);
+    int fd = file_handle->GetFd();
+    int num_records = 0;
+    char buf[RM_MAX_RECORD_SIZE] = {};
+    while (file_handle->file_hdr_.num_pages < RM_FIRST_RECORD_PAGE + 2 * RM_SCAN_PREFETCH_PAGES + 2) {
+        file_handle->insert_record(buf, nullptr);
+        num_records++;
+    }
+    buffer_pool_manager->flush_all_pages(fd);
+    buffer_pool_manager->delete_all_page(fd);
+    auto cached = [&](int page_no) {
+        auto &part = buffer_pool_manager->partition_of(PageId{fd, page_no});
+        std::lock_guard<std::mutex> guard(part.latch_);
+        auto it = part.page_table_.find(PageId{fd, page_no});
+        return it != part.page_table_.end() && !buffer_pool_manager->pages_[it->second].io_in_progress_;
+    };
+
+    // Scenario: opening a scan on the first record page prefetches the pages right after it, and nothing beyond them.
+    {
+        RmScan scan(file_handle.get());
+        ASSERT_FALSE(scan.is_end());
+        EXPECT_EQ(RM_FIRST_RECORD_PAGE, scan.rid().page_no);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        for (int p = RM_FIRST_RECORD_PAGE + 1; p <= RM_FIRST_RECORD_PAGE + RM_SCAN_PREFETCH_PAGES; p++) {
+            while (!cached(p) && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            EXPECT_TRUE(cached(p)) << "page " << p;
+        }
+        EXPECT_FALSE(cached(RM_FIRST_RECORD_PAGE + RM_SCAN_PREFETCH_PAGES + 1));
+
+        // Scenario: the rest of the scan still returns every record once.
+        int cnt = 0;
+        for (; !scan.is_end(); scan.next()) {
+            cnt++;
+        }
+        EXPECT_EQ(num_records, cnt);
+    }
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, RecoveryPageLsnTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "recovery_lsn.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 16;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    char old_buf[16], new_buf[16];
+    memset(old_buf, 'a', sizeof(old_buf));
+    memset(new_buf, 'b', sizeof(new_buf));
+    Rid rid{1, 0};
+
+    // 页面不存在时创建页面并重做，页面lsn记为日志lsn
+    file_handle->insert_record_for_recovery(rid, old_buf, 100);
+    auto page_handle = file_handle->fetch_page_handle(rid.page_no);
+    EXPECT_EQ(page_handle.page->get_page_lsn(), 100);
+    buffer_pool_manager->unpin_page(page_handle.page->get_page_id(), false);
+
+    // 早于页面lsn的日志已经反映在页面上，跳过
+    file_handle->update_record_for_recovery(rid, new_buf, 50);
+    file_handle->delete_record_for_recovery(rid, 100);
+    EXPECT_EQ(memcmp(file_handle->get_record(rid, nullptr)->data, old_buf, record_size), 0);
+
+    file_handle->update_record_for_recovery(rid, new_buf, 150);
+    EXPECT_EQ(memcmp(file_handle->get_record(rid, nullptr)->data, new_buf, record_size), 0);
+
+    // undo不比较页面lsn
+    file_handle->update_record_for_recovery(rid, old_buf);
+    EXPECT_EQ(memcmp(file_handle->get_record(rid, nullptr)->data, old_buf, record_size), 0);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+// 插入日志在选定rid之后、修改页面之前写入，页面一直被pin住直到记下页面lsn。
+// 此期间的检查点跳过该页面，之后写回页面时先把插入日志刷盘，崩溃后磁盘上不会出现没有日志的记录
+TEST(RecordManagerTest, InsertWalTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(8, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+    std::vector<lsn_t> flushed;
+    buffer_pool_manager->set_log_flusher([&flushed](lsn_t lsn) { flushed.push_back(lsn); });
+
+    std::string filename = "insert_wal.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    const int record_size = 16;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+    int fd = file_handle->GetFd();
+    char buf[record_size];
+    memset(buf, 'a', record_size);
+    auto records_on_disk = [&](int page_no) {
+        std::vector<char> data(PAGE_SIZE);
+        disk_manager->read_page(fd, page_no, data.data(), PAGE_SIZE);
+        return reinterpret_cast<RmPageHdr *>(data.data() + Page::OFFSET_PAGE_HDR)->num_records;
+    };
+
+    // Scenario: the first record reaches disk, the second one only dirties the page.
+    Rid first = file_handle->insert_record(buf, nullptr);
+    buffer_pool_manager->flush_all_pages(fd);
+    file_handle->insert_record(buf, nullptr);
+
+    // Scenario: a checkpoint runs while the insert log is being written; the page is pinned and unchanged.
+    Rid rid = file_handle->insert_record(buf, nullptr, [&](const Rid &log_rid) {
+        EXPECT_EQ(first.page_no, log_rid.page_no);
+        EXPECT_FALSE(Bitmap::is_set(file_handle->fetch_page_handle(log_rid.page_no).bitmap, log_rid.slot_no));
+        buffer_pool_manager->unpin_page(PageId{fd, log_rid.page_no}, false);
+        buffer_pool_manager->flush_dirty_pages(INT32_MAX);
+        return 200;
+    });
+    EXPECT_EQ(1, records_on_disk(rid.page_no));
+
+    // Scenario: the page carries the insert lsn, so writing it back flushes the insert log first.
+    buffer_pool_manager->flush_all_pages(fd);
+    EXPECT_EQ(3, records_on_disk(rid.page_no));
+    ASSERT_FALSE(flushed.empty());
+    EXPECT_EQ(200, flushed.back());
+
+    // Scenario: writing the insert log fails and the page is left untouched and unpinned.
+    EXPECT_THROW(file_handle->insert_record(buf, nullptr, [](const Rid &) -> lsn_t { throw InternalError("log"); }),
+                 InternalError);
+    EXPECT_EQ(3, file_handle->fetch_page_handle(rid.page_no).page_hdr->num_records);
+    buffer_pool_manager->unpin_page(PageId{fd, rid.page_no}, false);
+    EXPECT_TRUE(buffer_pool_manager->delete_page(PageId{fd, rid.page_no}));
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(RecordManagerTest, ConcurrentInsertTest) {
+    auto disk_manager = std::make_unique<DiskManager>();
+    auto buffer_pool_manager = std::make_unique<BufferPoolManager>(BUFFER_POOL_SIZE, disk_manager.get());
+    auto rm_manager = std::make_unique<RmManager>(disk_manager.get(), buffer_pool_manager.get());
+
+    std::string filename = "concurrent_insert.txt";
+    if (disk_manager->is_file(filename)) {
+        disk_manager->destroy_file(filename);
+    }
+    int record_size = 64;
+    rm_manager->create_file(filename, record_size);
+    auto file_handle = rm_manager->open_file(filename);
+
+    // 多个线程同时向同一张表插入，各自认领不同的页面，插入的记录互不覆盖
+    const int num_threads = 4;
+    const int num_records = 2000;
+    std::vector<std::vector<Rid>> rids(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            char buf[64];
+            for (int i = 0; i < num_records; i++) {
+                memset(buf, 0, sizeof(buf));
+                snprintf(buf, sizeof(buf), "%d-%d", t, i);
+                rids[t].push_back(file_handle->insert_record(buf, nullptr));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::set<std::pair<int, int>> seen;
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < num_records; i++) {
+            Rid rid = rids[t][i];
+            ASSERT_TRUE(seen.emplace(rid.page_no, rid.slot_no).second);
+            EXPECT_EQ(std::string(file_handle->get_record(rid, nullptr)->data), std::to_string(t) + "-" + std::to_string(i));
+        }
+    }
+    int per_page = file_handle->file_hdr_.num_records_per_page;
+    EXPECT_LE(file_handle->file_hdr_.num_pages - 1, (num_threads * num_records + per_page - 1) / per_page + num_threads);
+
+    // 删除记录后页面重新变为可插入，重新打开文件后空闲空间表按需检查页面
+    Rid victim = rids[0][0];
+    file_handle->delete_record(victim, nullptr);
+    EXPECT_EQ(file_handle->fsm_->get_level(victim.page_no), 1);
+    rm_manager->close_file(file_handle.get());
+    file_handle = rm_manager->open_file(filename);
+    EXPECT_EQ(file_handle->fsm_->get_level(victim.page_no), RmFreeSpaceMap::RM_FSM_UNKNOWN);
+    int num_pages = file_handle->file_hdr_.num_pages;
+    char buf[64] = "again";
+    Rid rid = file_handle->insert_record(buf, nullptr);
+    EXPECT_LT(rid.page_no, num_pages);
+
+    rm_manager->close_file(file_handle.get());
+    rm_manager->destroy_file(filename);
+}
+
+TEST(BitmapTest, WordScanTest) {
+    srand(11);
+    char bm[64];
+    for (int max_n : {1, 7, 8, 63, 64, 65, 200, 512}) {
+        for (int round = 0; round < 20; round++) {
+            // 随机填充，包括max_n之后的位，按字扫描时不能把它们算进去
+            for (auto &c : bm) c = static_cast<char>(rand());
+            int expect_cnt = 0;
+            for (int i = 0; i < max_n; i++) expect_cnt += Bitmap::is_set(bm, i);
+            EXPECT_EQ(Bitmap::count(bm, max_n), expect_cnt);
+
+            std::vector<int> set_bits;
+            Bitmap::for_each_set(bm, max_n, [&](int pos) { set_bits.push_back(pos); });
+            ASSERT_EQ((int)set_bits.size(), expect_cnt);
+            for (int pos : set_bits) EXPECT_TRUE(Bitmap::is_set(bm, pos));
+
+            for (int curr = -1; curr < max_n; curr++) {
+                for (bool bit : {false, true}) {
+                    int expect = curr + 1;
+                    while (expect < max_n && Bitmap::is_set(bm, expect) != bit) expect++;
+                    EXPECT_EQ(Bitmap::next_bit(bit, bm, max_n, curr), expect);
+                }
+            }
+        }
+    }
+}
+
+TEST(LogRecordTest, UpdateDeltaTest) {
+    const int record_size = 64;
+    char old_buf[record_size], new_buf[record_size];
+    memset(old_buf, 'a', record_size);
+    memcpy(new_buf, old_buf, record_size);
+    // 两处相邻的修改合并为一个区间，远处的修改单独一个区间
+    new_buf[2] = 'x';
+    new_buf[5] = 'y';
+    memset(new_buf + 40, 'z', 4);
+    RmRecord old_rec(record_size, old_buf), new_rec(record_size, new_buf);
+    Rid rid{3, 7};
+    UpdateLogRecord log(1, old_rec, new_rec, rid, 5);
+    ASSERT_EQ(log.ranges_.size(), 2);
+    EXPECT_LT(log.log_tot_len_, LOG_HEADER_SIZE + 2 * record_size);
+
+    char dest[log.log_tot_len_];
+    log.serialize(dest);
+    UpdateLogRecord read;
+    read.deserialize(dest);
+    EXPECT_EQ(read.table_id_, 5);
+    EXPECT_EQ(read.rid_, rid);
+
+    char rec[record_size];
+    memcpy(rec, old_buf, record_size);
+    read.apply_new(rec);
+    EXPECT_EQ(memcmp(rec, new_buf, record_size), 0);
+    read.apply_old(rec);
+    EXPECT_EQ(memcmp(rec, old_buf, record_size), 0);
+}
+
+/** 建立包含存储、索引、日志、事务和恢复的完整系统，在数据库TEST_DB_NAME_SYS上执行语句。
+ * crash()不写回缓冲池直接丢弃所有管理器，然后重新打开数据库并执行恢复，模拟崩溃后重启 */
+const std::string TEST_DB_NAME_SYS = "SystemTest_db";
+
+class SystemTest : public ::testing::Test {
+   public:
+    std::unique_ptr<DiskManager> disk_manager_;
+    std::unique_ptr<BufferPoolManager> bpm_;
+    std::unique_ptr<RmManager> rm_manager_;
+    std::unique_ptr<IxManager> ix_manager_;
+    std::unique_ptr<SmManager> sm_manager_;
+    std::unique_ptr<LockManager> lock_manager_;
+    std::unique_ptr<TransactionManager> txn_manager_;
+    std::unique_ptr<LogManager> log_manager_;
+    std::unique_ptr<RecoveryManager> recovery_;
+
+   public:
+    void SetUp() override {
+        ::testing::Test::SetUp();
+        start();
+        if (sm_manager_->is_dir(TEST_DB_NAME_SYS)) {
+            sm_manager_->drop_db(TEST_DB_NAME_SYS);
+        }
+        sm_manager_->create_db(TEST_DB_NAME_SYS);
+        open();
+    }
+
+    void TearDown() override {
+        stop();
+        start();
+        sm_manager_->drop_db(TEST_DB_NAME_SYS);
+        stop();
+    }
+
+    void start(size_t pool_size = BUFFER_POOL_SIZE) {
+        disk_manager_ = std::make_unique<DiskManager>();
+        bpm_ = std::make_unique<BufferPoolManager>(pool_size, disk_manager_.get());
+        rm_manager_ = std::make_unique<RmManager>(disk_manager_.get(), bpm_.get());
+        ix_manager_ = std::make_unique<IxManager>(disk_manager_.get(), bpm_.get());
+        sm_manager_ = std::make_unique<SmManager>(disk_manager_.get(), bpm_.get(), rm_manager_.get(), ix_manager_.get());
+        lock_manager_ = std::make_unique<LockManager>();
+        txn_manager_ = std::make_unique<TransactionManager>(lock_manager_.get(), sm_manager_.get());
+        log_manager_ = std::make_unique<LogManager>(disk_manager_.get(), bpm_.get());
+        sm_manager_->set_log_manager(log_manager_.get());
+        recovery_ = std::make_unique<RecoveryManager>(disk_manager_.get(), bpm_.get(), sm_manager_.get());
+    }
+
+    // 与rmdb启动时的顺序一致: 打开数据库，恢复日志尾部，analyze/redo/undo，最后修复索引
+    void open() {
+        sm_manager_->open_db(TEST_DB_NAME_SYS);
+        log_manager_->recovery_log_info();
+        if (chdir(TEST_DB_NAME_SYS.c_str()) < 0) {
+            throw UnixError();
+        }
+        recovery_->analyze();
+        recovery_->redo();
+        recovery_->undo();
+        if (chdir("..") < 0) {
+            throw UnixError();
+        }
+        recovery_->recover_indexes();
+        bpm_->flush_all_pages();
+        sm_manager_->flush_index_headers();
+    }
+
+    // 与create_static_checkpoint一致: 写检查点记录，写回所有脏页和索引文件头，再记下检查点位置并回收日志段
+    lsn_t checkpoint() {
+        CheckPointRecord ckpt;
+        lsn_t c_lsn = log_manager_->add_log_to_buffer(&ckpt);
+        log_manager_->flush_log_to_disk();
+        bpm_->flush_all_pages();
+        sm_manager_->flush_index_headers();
+        char data[sizeof(lsn_t)];
+        memcpy(data, &c_lsn, sizeof(c_lsn));
+        disk_manager_->write_start_file(data, sizeof(lsn_t));
+        log_manager_->write_log_header(c_lsn);
+        disk_manager_->recycle_log(c_lsn);
+        return c_lsn;
+    }
+
+    // 按创建的逆序销毁，缓冲池中的脏页不写回
+    void stop() {
+        recovery_.reset();
+        log_manager_.reset();
+        txn_manager_.reset();
+        lock_manager_.reset();
+        sm_manager_.reset();
+        ix_manager_.reset();
+        rm_manager_.reset();
+        bpm_.reset();
+        disk_manager_.reset();
+    }
+
+    void crash(size_t pool_size = BUFFER_POOL_SIZE) {
+        stop();
+        start(pool_size);
+        open();
+    }
+
+    Transaction *begin() { return txn_manager_->begin(nullptr, log_manager_.get()); }
+
+    void commit(Transaction *txn) { txn_manager_->commit(txn, log_manager_.get()); }
+
+    void insert(Transaction *txn, const std::string &tab_name, std::vector<Value> values) {
+        Context context(lock_manager_.get(), log_manager_.get(), txn, recovery_.get());
+        InsertExecutor executor(sm_manager_.get(), tab_name, values, &context);
+        executor.Next();
+    }
+
+    void remove(Transaction *txn, const std::string &tab_name, const std::vector<Rid> &rids) {
+        Context context(lock_manager_.get(), log_manager_.get(), txn, recovery_.get());
+        DeleteExecutor executor(sm_manager_.get(), tab_name, {}, rids, &context);
+        executor.Next();
+    }
+
+    void update(Transaction *txn, const std::string &tab_name, const std::vector<Rid> &rids,
+                const std::string &col_name, Value value) {
+        Context context(lock_manager_.get(), log_manager_.get(), txn, recovery_.get());
+        std::vector<SetClause> set_clauses = {SetClause{TabCol{tab_name, col_name}, value}};
+        UpdateExecutor executor(sm_manager_.get(), tab_name, set_clauses, {}, rids, &context);
+        executor.Next();
+    }
+
+    // 通过索引查找键为key的记录，记录不存在时返回的rid页号为INVALID_PAGE_ID
+    Rid lookup(const std::string &tab_name, const std::vector<std::string> &col_names, const char *key) {
+        auto ih = sm_manager_->ihs_.at(ix_manager_->get_index_name(tab_name, col_names)).get();
+        std::vector<Rid> rids;
+        if (!ih->get_value(key, &rids, nullptr)) {
+            return Rid{INVALID_PAGE_ID, -1};
+        }
+        return rids[0];
+    }
+
+    static Value int_value(int v) {
+        Value value;
+        value.set_int(v);
+        return value;
+    }
+};
+
+// 插入和更新都不能产生重复的PRIMARY KEY/UNIQUE键，语句内部的键冲突同样要拒绝，记录之间交换键值是允许的
+TEST_F(SystemTest, DuplicateKeyTest) {
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}, {"k", TYPE_INT, 4}},
+                              {{KEY_PRIMARY, {"id"}}, {KEY_UNIQUE, {"k"}}}, nullptr);
+    Transaction *txn = begin();
+    insert(txn, "t", {int_value(1), int_value(10)});
+    insert(txn, "t", {int_value(2), int_value(20)});
+    insert(txn, "t", {int_value(3), int_value(30)});
+    int key = 1;
+    Rid r1 = lookup("t", {"id"}, (const char *)&key);
+    key = 2;
+    Rid r2 = lookup("t", {"id"}, (const char *)&key);
+    key = 3;
+    Rid r3 = lookup("t", {"id"}, (const char *)&key);
+
+    // Scenario: inserting an existing PRIMARY KEY or UNIQUE key is rejected.
+    EXPECT_THROW(insert(txn, "t", {int_value(1), int_value(40)}), DuplicateKeyError);
+    EXPECT_THROW(insert(txn, "t", {int_value(4), int_value(20)}), DuplicateKeyError);
+    insert(txn, "t", {int_value(4), int_value(40)});
+
+    // Scenario: updating a key to one owned by a row outside the statement is rejected.
+    EXPECT_THROW(update(txn, "t", {r1}, "k", int_value(20)), DuplicateKeyError);
+    EXPECT_THROW(update(txn, "t", {r1}, "id", int_value(2)), DuplicateKeyError);
+
+    // Scenario: two rows of one statement end up with the same key, whichever of them keeps its old key.
+    EXPECT_THROW(update(txn, "t", {r1, r2}, "k", int_value(50)), DuplicateKeyError);
+    EXPECT_THROW(update(txn, "t", {r2, r1}, "k", int_value(10)), DuplicateKeyError);
+    EXPECT_THROW(update(txn, "t", {r1, r2}, "k", int_value(10)), DuplicateKeyError);
+
+    // Scenario: setting a key to its current value is not a conflict.
+    update(txn, "t", {r1}, "k", int_value(10));
+
+    // Scenario: swapping keys between rows through a free key succeeds and keeps the index consistent.
+    update(txn, "t", {r1}, "k", int_value(99));
+    update(txn, "t", {r2}, "k", int_value(10));
+    update(txn, "t", {r1}, "k", int_value(20));
+    key = 10;
+    EXPECT_EQ(r2, lookup("t", {"k"}, (const char *)&key));
+    key = 20;
+    EXPECT_EQ(r1, lookup("t", {"k"}, (const char *)&key));
+    key = 99;
+    EXPECT_EQ(INVALID_PAGE_ID, lookup("t", {"k"}, (const char *)&key).page_no);
+    EXPECT_THROW(update(txn, "t", {r3}, "k", int_value(10)), DuplicateKeyError);
+    commit(txn);
+}
+
+// 崩溃时未提交事务的插入、更新和删除都已经写回磁盘，恢复时按日志回滚，已提交的修改保留
+TEST_F(SystemTest, RecoveryUndoTest) {
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}, {"v", TYPE_INT, 4}}, {}, nullptr);
+    Transaction *txn = begin();
+    for (int i = 0; i < 100; i++) {
+        insert(txn, "t", {int_value(i), int_value(i)});
+    }
+    commit(txn);
+
+    auto fh = sm_manager_->fhs_.at("t").get();
+    std::vector<Rid> rids;
+    for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+        rids.push_back(scan.rid());
+    }
+    ASSERT_EQ(100, rids.size());
+
+    // Scenario: an uncommitted transaction updates, deletes and inserts rows, and all its pages reach disk.
+    txn = begin();
+    update(txn, "t", {rids[0], rids[1]}, "v", int_value(-1));
+    remove(txn, "t", std::vector<Rid>(rids.begin() + 2, rids.begin() + 10));
+    for (int i = 100; i < 150; i++) {
+        insert(txn, "t", {int_value(i), int_value(i)});
+    }
+    bpm_->flush_all_pages();
+
+    // Scenario: after the crash only the committed rows remain, with their committed values.
+    crash();
+    fh = sm_manager_->fhs_.at("t").get();
+    std::set<int> ids;
+    for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+        auto rec = fh->get_record(scan.rid(), nullptr);
+        int id = *reinterpret_cast<int *>(rec->data);
+        EXPECT_EQ(id, *reinterpret_cast<int *>(rec->data + 4));
+        ids.insert(id);
+    }
+    ASSERT_EQ(100, ids.size());
+    EXPECT_EQ(0, *ids.begin());
+    EXPECT_EQ(99, *ids.rbegin());
+    EXPECT_EQ(60, recovery_->get_stats().undo_records);
+}
+
+// 日志跨越多个日志段，检查点之后回收完全位于检查点之前的日志段，恢复时从检查点开始跨日志段读取日志
+TEST_F(SystemTest, LogSegmentTest) {
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}, {"pad", TYPE_STRING, 400}}, {}, nullptr);
+    auto segment_exists = [](int seg_no) {
+        return access((TEST_DB_NAME_SYS + "/" + LOG_FILE_NAME + "." + std::to_string(seg_no)).c_str(), F_OK) == 0;
+    };
+    Value pad;
+    pad.set_str("pad");
+    int num_rows = 0;
+    auto fill_log_to = [&](lsn_t lsn) {
+        Transaction *txn = begin();
+        while (log_manager_->get_global_lsn() < lsn) {
+            insert(txn, "t", {int_value(num_rows++), pad});
+        }
+        commit(txn);
+    };
+
+    // Scenario: the log rolls over from segment 0 into segment 1.
+    fill_log_to(LOG_SEGMENT_SIZE + LOG_SEGMENT_SIZE / 4);
+    EXPECT_TRUE(segment_exists(0));
+    EXPECT_TRUE(segment_exists(1));
+
+    // Scenario: a checkpoint in segment 1 recycles segment 0 once the start file and log header are durable.
+    checkpoint();
+    EXPECT_FALSE(segment_exists(0));
+    EXPECT_TRUE(segment_exists(1));
+    char buf[LOG_HEADER_SIZE];
+    EXPECT_EQ(-1, disk_manager_->read_log(buf, LOG_HEADER_SIZE, HEADER_RECORD_SIZE));
+
+    // Scenario: committed rows logged after the checkpoint span segments 1 and 2 and are redone after a crash.
+    int checkpoint_rows = num_rows;
+    fill_log_to(2 * LOG_SEGMENT_SIZE + LOG_SEGMENT_SIZE / 4);
+    EXPECT_TRUE(segment_exists(2));
+    crash();
+    auto fh = sm_manager_->fhs_.at("t").get();
+    std::vector<bool> seen(num_rows, false);
+    for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+        int id = *reinterpret_cast<int *>(fh->get_record(scan.rid(), nullptr)->data);
+        ASSERT_LT(id, num_rows);
+        EXPECT_FALSE(seen[id]);
+        seen[id] = true;
+    }
+    EXPECT_EQ(num_rows, std::count(seen.begin(), seen.end(), true));
+    EXPECT_GT(recovery_->get_stats().redo_records, 0);
+    EXPECT_LE(recovery_->get_stats().redo_records, static_cast<size_t>(num_rows - checkpoint_rows));
+}
+
+// 日志写回出错时，需要等待环中空间的写入者和刷盘都返回错误，而不是等待一段永远不会发布的日志
+TEST_F(SystemTest, LogWriteErrorTest) {
+    char data[1024];
+    memset(data, 'x', sizeof(data));
+    RmRecord rec(sizeof(data), data);
+    Rid rid{1, 0};
+    InsertLogRecord log(1, rec, rid, 0);
+    log_manager_->add_log_to_buffer(&log);
+    log_manager_->flush_log_to_disk();
+
+    // Scenario: the log segment can no longer be written, so appenders throw once the ring is full.
+    std::map<int, int> segments = disk_manager_->log_segments_;
+    for (auto &seg : disk_manager_->log_segments_) {
+        seg.second = -1;
+    }
+    int failures = 0;
+    for (int i = 0; i < 4 * LogManager::LOG_RING_SIZE / static_cast<int>(log.log_tot_len_) && failures < 3; i++) {
+        try {
+            log_manager_->add_log_to_buffer(&log);
+        } catch (UnixError &) {
+            failures++;
+        }
+    }
+    EXPECT_EQ(3, failures);
+    EXPECT_THROW(log_manager_->flush_log_to_disk(), UnixError);
+
+    // Scenario: once the log can be written again, everything reserved so far is flushed.
+    disk_manager_->log_segments_ = segments;
+    lsn_t lsn = log_manager_->add_log_to_buffer(&log);
+    log_manager_->flush_log_to_disk();
+    EXPECT_GE(log_manager_->flushed_to_disk_lsn.load(), lsn + static_cast<lsn_t>(log.log_tot_len_));
+}
+
+// 组提交: 并发提交的事务共享日志刷盘，commit返回时事务的日志已经落盘，崩溃后所有已提交的事务都能恢复
+TEST_F(SystemTest, GroupCommitTest) {
+    const int num_threads = 8;
+    const int txns_per_thread = 50;
+    for (int t = 0; t < num_threads; t++) {
+        sm_manager_->create_table("t" + std::to_string(t), {{"id", TYPE_INT, 4}}, {}, nullptr);
+    }
+
+    // Scenario: threads commit small transactions concurrently, and each commit returns only after its log is on disk.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < txns_per_thread; i++) {
+                Transaction *txn = begin();
+                insert(txn, "t" + std::to_string(t), {int_value(i)});
+                lsn_t lsn = log_manager_->get_global_lsn();
+                commit(txn);
+                EXPECT_GT(log_manager_->flushed_to_disk_lsn.load(), lsn);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Scenario: none of the data pages reach disk, and every committed row is redone after the crash.
+    crash();
+    for (int t = 0; t < num_threads; t++) {
+        auto fh = sm_manager_->fhs_.at("t" + std::to_string(t)).get();
+        std::set<int> ids;
+        for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+            ids.insert(*reinterpret_cast<int *>(fh->get_record(scan.rid(), nullptr)->data));
+        }
+        EXPECT_EQ(txns_per_thread, ids.size()) << "table t" << t;
+    }
+    EXPECT_EQ(0, recovery_->get_stats().undo_txns);
+}
+
+// 追加日志不再改写日志文件头，文件头中的日志结束位置只在检查点时更新；
+// 启动时从文件头记录的位置向后扫描找到真正的日志结束位置，并截掉崩溃时没有写完整的记录
+TEST_F(SystemTest, LogHeaderTest) {
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}}, {}, nullptr);
+    auto read_header = [&] {
+        std::vector<char> buf(HEADER_RECORD_SIZE);
+        disk_manager_->read_log_header(buf.data(), HEADER_RECORD_SIZE);
+        return buf;
+    };
+    auto add_rows = [&](int from, int to) {
+        for (int i = from; i < to; i++) {
+            Transaction *txn = begin();
+            insert(txn, "t", {int_value(i)});
+            commit(txn);
+        }
+    };
+
+    // Scenario: committing transactions appends and flushes log records but leaves the header untouched.
+    std::vector<char> header = read_header();
+    lsn_t start_lsn = log_manager_->get_global_lsn();
+    add_rows(0, 100);
+    lsn_t end_lsn = log_manager_->get_global_lsn();
+    EXPECT_LT(start_lsn, end_lsn);
+    EXPECT_EQ(end_lsn, log_manager_->flushed_to_disk_lsn.load());
+    EXPECT_EQ(header, read_header());
+
+    // Scenario: after a restart the log end is found by scanning past the position stored in the header.
+    crash();
+    EXPECT_EQ(end_lsn, log_manager_->get_global_lsn());
+
+    // Scenario: a checkpoint stores the flushed log end in the header.
+    lsn_t c_lsn = checkpoint();
+    HeaderRecord h_rec;
+    h_rec.deserialize(read_header().data());
+    EXPECT_EQ(log_manager_->flushed_to_disk_lsn.load(), h_rec.global_lsn_);
+    EXPECT_EQ(c_lsn, h_rec.checkpoint_lsn_);
+
+    // Scenario: a torn record after the last complete one is truncated at startup, and the rows before it survive.
+    add_rows(100, 200);
+    end_lsn = log_manager_->get_global_lsn();
+    char garbage[LOG_HEADER_SIZE + 10];
+    memset(garbage, 0x7f, sizeof(garbage));
+    disk_manager_->write_log(garbage, sizeof(garbage), end_lsn);
+    crash();
+    EXPECT_EQ(end_lsn, log_manager_->get_global_lsn());
+    EXPECT_EQ(end_lsn, disk_manager_->get_log_size());
+    int cnt = 0;
+    for (RmScan scan(sm_manager_->fhs_.at("t").get()); !scan.is_end(); scan.next()) {
+        cnt++;
+    }
+    EXPECT_EQ(200, cnt);
+}
+
+// 异步提交不等待日志落盘直接返回，log writer在ASYNC_COMMIT_MAX_DELAY内把提交日志刷盘；期限过后崩溃不会丢失该事务
+TEST_F(SystemTest, AsyncCommitTest) {
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}}, {}, nullptr);
+    txn_manager_->set_async_commit(true);
+
+    // Scenario: with the log flush blocked, an asynchronous commit still returns and its log is not yet durable.
+    Transaction *txn = begin();
+    insert(txn, "t", {int_value(0)});
+    {
+        std::lock_guard<std::mutex> flush_guard(log_manager_->flush_latch_);
+        commit(txn);
+        EXPECT_EQ(TransactionState::COMMITTED, txn->get_state());
+        EXPECT_LT(log_manager_->flushed_to_disk_lsn.load(), log_manager_->get_global_lsn());
+    }
+
+    // Scenario: the log writer flushes an asynchronous commit within the durability bound.
+    const auto slack = std::chrono::milliseconds(200);
+    for (int i = 1; i <= 5; i++) {
+        txn = begin();
+        insert(txn, "t", {int_value(i)});
+        commit(txn);
+        lsn_t end_lsn = log_manager_->get_global_lsn();
+        auto start = std::chrono::steady_clock::now();
+        while (log_manager_->flushed_to_disk_lsn.load() < end_lsn &&
+               std::chrono::steady_clock::now() - start < ASYNC_COMMIT_MAX_DELAY + slack) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        EXPECT_GE(log_manager_->flushed_to_disk_lsn.load(), end_lsn) << "commit " << i;
+    }
+
+    // Scenario: a crash after the bound keeps every asynchronously committed row.
+    crash();
+    int cnt = 0;
+    for (RmScan scan(sm_manager_->fhs_.at("t").get()); !scan.is_end(); scan.next()) {
+        cnt++;
+    }
+    EXPECT_EQ(6, cnt);
+}
+
+// 恢复过程记录扫描、redo、undo的计数和各阶段耗时，启动时输出一行报告，SHOW RECOVERY STATS以表格输出同样的内容
+TEST_F(SystemTest, RecoveryStatsTest) {
+    const int committed_rows = 50;
+    const int uncommitted_rows = 10;
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}}, {}, nullptr);
+    Transaction *txn = begin();
+    for (int i = 0; i < committed_rows; i++) {
+        insert(txn, "t", {int_value(i)});
+    }
+    commit(txn);
+    txn = begin();
+    for (int i = 0; i < uncommitted_rows; i++) {
+        insert(txn, "t", {int_value(committed_rows + i)});
+    }
+    log_manager_->flush_log_to_disk();
+
+    // Scenario: recovery redoes every insert, then undoes the uncommitted transaction.
+    crash();
+    const RecoveryStats &stats = recovery_->get_stats();
+    // 两个事务的BEGIN、所有插入以及一个COMMIT
+    EXPECT_EQ(committed_rows + uncommitted_rows + 3, stats.records_scanned);
+    EXPECT_EQ(committed_rows + uncommitted_rows, stats.redo_records);
+    EXPECT_EQ(uncommitted_rows, stats.undo_records);
+    EXPECT_EQ(1, stats.undo_txns);
+    EXPECT_LT(0, stats.pages_touched);
+    EXPECT_LT(0, stats.bytes_read);
+    EXPECT_LE(0, stats.analyze_ms);
+    EXPECT_LE(0, stats.redo_ms);
+    EXPECT_LE(0, stats.undo_ms);
+
+    // Scenario: the startup report and SHOW RECOVERY STATS print the same counters.
+    std::string report = recovery_->report();
+    EXPECT_NE(std::string::npos, report.find("undo_txns=1"));
+    EXPECT_NE(std::string::npos, report.find("undo_records=" + std::to_string(uncommitted_rows)));
+    std::vector<char> data_send(BUFFER_LENGTH, 0);
+    int offset = 0;
+    Context context(lock_manager_.get(), log_manager_.get(), nullptr, recovery_.get(), data_send.data(), &offset);
+    recovery_->show_stats(&context);
+    std::string table(data_send.data(), offset);
+    for (auto &row : stats.to_rows()) {
+        EXPECT_NE(std::string::npos, table.find(row.first)) << row.first;
+    }
+    EXPECT_NE(std::string::npos, table.find("Stat"));
+}
+
+// 索引的插入/删除写INDEX日志，崩溃后只做redo就能得到崩溃前的B+树，包括只有一部分页面落盘的分裂和合并
+TEST_F(SystemTest, IndexRedoTest) {
+    const size_t pool_size = 32;    // 缓冲池很小，分裂和合并过程中的索引页面会被淘汰写回
+    const int num_rows = 3000;
+    const int num_deleted = 1000;
+    crash(pool_size);
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}, {"v", TYPE_INT, 4}}, {{KEY_PRIMARY, {"id"}}}, nullptr);
+    Transaction *txn = begin();
+    for (int i = 0; i < num_rows; i++) {
+        insert(txn, "t", {int_value(i * 7 % num_rows), int_value(0)});
+    }
+    commit(txn);
+    std::vector<Rid> rids;
+    for (int id = 0; id < num_deleted; id++) {
+        rids.push_back(lookup("t", {"id"}, (const char *)&id));
+    }
+    txn = begin();
+    remove(txn, "t", rids);
+    commit(txn);
+
+    // Scenario: the leaf holding a key is stamped with the LSN of the INDEX record that changed it last.
+    auto ih = sm_manager_->ihs_.at(ix_manager_->get_index_name("t", std::vector<std::string>{"id"})).get();
+    int key = num_rows - 1;
+    auto [leaf, root_latched] = ih->find_leaf_page((const char *)&key, Operation::FIND, nullptr);
+    Page *page = bpm_->fetch_page(leaf->get_page_id());
+    EXPECT_GT(page->get_page_lsn(), 0);
+    EXPECT_LT(page->get_page_lsn(), log_manager_->get_global_lsn());
+    bpm_->unpin_page(leaf->get_page_id(), false);
+    bpm_->unpin_page(leaf->get_page_id(), false);
+    page_id_t root_page = ih->get_file_hdr()->root_page_;
+    EXPECT_NE(IX_INIT_ROOT_PAGE, root_page);
+
+    // Scenario: after a crash, redo alone rebuilds the tree and its header; no index is dropped and recreated.
+    stop();
+    start(pool_size);
+    sm_manager_->open_db(TEST_DB_NAME_SYS);
+    log_manager_->recovery_log_info();
+    ASSERT_EQ(0, chdir(TEST_DB_NAME_SYS.c_str()));
+    recovery_->analyze();
+    recovery_->redo();
+    recovery_->undo();
+    ASSERT_EQ(0, chdir(".."));
+    ih = sm_manager_->ihs_.at(ix_manager_->get_index_name("t", std::vector<std::string>{"id"})).get();
+    EXPECT_EQ(root_page, ih->get_file_hdr()->root_page_);
+    auto fh = sm_manager_->fhs_.at("t").get();
+    for (int id = 0; id < num_rows; id++) {
+        Rid rid = lookup("t", {"id"}, (const char *)&id);
+        if (id < num_deleted) {
+            EXPECT_EQ(INVALID_PAGE_ID, rid.page_no) << "id " << id;
+            continue;
+        }
+        ASSERT_NE(INVALID_PAGE_ID, rid.page_no) << "id " << id;
+        EXPECT_EQ(id, *reinterpret_cast<int *>(fh->get_record(rid, nullptr)->data));
+    }
+
+    // Scenario: pages allocated after the restart do not overwrite pages of the redone tree.
+    txn = begin();
+    for (int id = num_rows; id < 2 * num_rows; id++) {
+        insert(txn, "t", {int_value(id), int_value(0)});
+    }
+    commit(txn);
+    for (int id = num_deleted; id < 2 * num_rows; id++) {
+        ASSERT_NE(INVALID_PAGE_ID, lookup("t", {"id"}, (const char *)&id).page_no) << "id " << id;
+    }
+}
+
+// 索引页面的修改记INDEX日志，恢复时重做B+树的分裂而不重建索引；未提交事务留下的索引项在undo之后逐条修复
+TEST_F(SystemTest, RecoveryIndexTest) {
+    const size_t pool_size = 32;    // 缓冲池很小，分裂过程中的索引页面会被淘汰写回
+    const int num_rows = 3000;
+    crash(pool_size);
+    sm_manager_->create_table("t", {{"id", TYPE_INT, 4}, {"v", TYPE_INT, 4}}, {{KEY_PRIMARY, {"id"}}}, nullptr);
+    auto check_index = [&](int v) {
+        auto fh = sm_manager_->fhs_.at("t").get();
+        for (int id = 0; id < num_rows; id++) {
+            Rid rid = lookup("t", {"id"}, (const char *)&id);
+            ASSERT_NE(INVALID_PAGE_ID, rid.page_no) << "id " << id;
+            auto rec = fh->get_record(rid, nullptr);
+            EXPECT_EQ(id, *reinterpret_cast<int *>(rec->data));
+            EXPECT_EQ(v, *reinterpret_cast<int *>(rec->data + 4));
+        }
+        int id = num_rows;
+        EXPECT_EQ(INVALID_PAGE_ID, lookup("t", {"id"}, (const char *)&id).page_no);
+    };
+
+    // Scenario: committed inserts split leaves and the root, and only part of the index reaches disk before the crash.
+    Transaction *txn = begin();
+    for (int i = 0; i < num_rows; i++) {
+        insert(txn, "t", {int_value(i * 7 % num_rows), int_value(0)});
+    }
+    commit(txn);
+    auto ih = sm_manager_->ihs_.at(ix_manager_->get_index_name("t", std::vector<std::string>{"id"})).get();
+    EXPECT_NE(IX_INIT_ROOT_PAGE, ih->get_file_hdr()->root_page_);
+    crash(pool_size);
+    EXPECT_EQ(0, recovery_->get_stats().indexes_rebuilt);
+    check_index(0);
+
+    // Scenario: after a checkpoint, updates of a non-key column leave the index on disk as it is.
+    checkpoint();
+    auto fh = sm_manager_->fhs_.at("t").get();
+    std::vector<Rid> rids;
+    for (RmScan scan(fh); !scan.is_end(); scan.next()) {
+        rids.push_back(scan.rid());
+    }
+    txn = begin();
+    update(txn, "t", rids, "v", int_value(1));
+    commit(txn);
+    crash(pool_size);
+    EXPECT_EQ(0, recovery_->get_stats().indexes_rebuilt);
+    EXPECT_EQ(0, recovery_->get_stats().index_records);
+    check_index(1);
+
+    // Scenario: an uncommitted transaction changes keys and inserts rows, and its index pages reach disk before the crash.
+    const int num_changed = 100;
+    txn = begin();
+    for (int id = 0; id < num_changed; id++) {
+        Rid rid = lookup("t", {"id"}, (const char *)&id);
+        update(txn, "t", {rid}, "id", int_value(id + 2 * num_rows));
+        insert(txn, "t", {int_value(id + 3 * num_rows), int_value(2)});
+    }
+    bpm_->flush_all_pages();
+    crash(pool_size);
+    EXPECT_EQ(0, recovery_->get_stats().indexes_rebuilt);
+    EXPECT_EQ(2 * num_changed, recovery_->get_stats().index_records);
+    check_index(1);
+    for (int id = 2 * num_rows; id < 3 * num_rows + num_changed; id++) {
+        EXPECT_EQ(INVALID_PAGE_ID, lookup("t", {"id"}, (const char *)&id).page_no) << "id " << id;
+    }
+}